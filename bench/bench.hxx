@@ -0,0 +1,91 @@
+// Minimal benchmark harness for starship-bench.
+// Each benchmark is a function that fills in samples for one entity
+// count; the runner aggregates them and writes JSON.
+#ifndef STARSHIP_BENCH_HXX
+#define STARSHIP_BENCH_HXX
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace starship {
+
+struct Recording;
+class ThreadPool;
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+// Raw timings for one benchmark at one entity count
+struct Samples {
+    std::vector<double> nanos;  // One entry per timed operation
+    std::size_t entities = 0;   // Entities touched by one operation
+};
+
+struct Result {
+    std::string name;
+    std::size_t count;       // Requested entity count
+    unsigned threads;
+    std::size_t entities;    // Entities actually processed per operation
+    std::size_t samples;
+    double medianNs;
+    double minNs;
+    double maxNs;
+};
+
+// Parameters of one benchmark run
+struct RunConfig {
+    std::size_t count;                 // Entity count
+    int repeats;                       // Timings to take
+    std::shared_ptr<ThreadPool> pool;  // Handed to every Game; null = single thread
+};
+
+// Fills `out` with config.repeats timings
+using BenchFn = std::function<void(const RunConfig& config, Samples& out)>;
+
+struct Benchmark {
+    std::string name;
+    std::string description;
+    BenchFn run;
+};
+
+// Time a single call of fn
+template <typename Fn>
+double timeOnce(Fn&& fn) {
+    auto start = Clock::now();
+    fn();
+    auto stop = Clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+inline Result summarize(const std::string& name, std::size_t count, unsigned threads, Samples& samples) {
+    std::vector<double>& v = samples.nanos;
+    std::sort(v.begin(), v.end());
+    Result r;
+    r.name = name;
+    r.count = count;
+    r.threads = threads;
+    r.entities = samples.entities;
+    r.samples = v.size();
+    r.medianNs = v.empty() ? 0.0 : v[v.size() / 2];
+    r.minNs = v.empty() ? 0.0 : v.front();
+    r.maxNs = v.empty() ? 0.0 : v.back();
+    return r;
+}
+
+// Registered benchmarks, defined in benchmarks.cxx
+std::vector<Benchmark> allBenchmarks();
+
+// Replays a recorded session headless; the count is the number of ticks.
+// Throws std::runtime_error if a replay diverges from the recorded checksum.
+Benchmark makeReplayBenchmark(const Recording& recording);
+
+} // namespace bench
+} // namespace starship
+
+#endif // STARSHIP_BENCH_HXX
@@ -0,0 +1,187 @@
+// starship-bench: headless microbenchmarks with JSON output.
+//
+// Usage: starship-bench [--counts=1000,10000,...] [--repeats=N]
+//                       [--filter=name] [--label=text] [--out=file.json] [--list]
+//                       [--threads=1,2,4,...] [--replay=session.rec]
+//
+// With several --threads values every benchmark runs once per thread
+// count, which gives the scaling curve of the parallel tick phases.
+#include "bench.hxx"
+#include "starship/replay.hxx"
+#include "starship/simd_kernels.hxx"
+#include "starship/thread_pool.hxx"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using starship::bench::Benchmark;
+using starship::bench::Result;
+using starship::bench::RunConfig;
+using starship::bench::Samples;
+
+struct Options {
+    std::vector<std::size_t> counts{1000, 10000, 100000, 1000000};
+    std::vector<std::size_t> threads{1};
+    int repeats = 0;  // 0 = pick per count
+    std::string filter;
+    std::string label;
+    std::string outPath;
+    std::string replayPath;  // Time this recording instead of the suite
+    bool list = false;
+};
+
+bool startsWith(const char* arg, const char* prefix) {
+    return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+}
+
+std::vector<std::size_t> parseList(const std::string& text) {
+    std::vector<std::size_t> counts;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) counts.push_back(std::strtoull(item.c_str(), nullptr, 10));
+    }
+    return counts;
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (startsWith(arg, "--counts=")) {
+            options.counts = parseList(arg + 9);
+        } else if (startsWith(arg, "--threads=")) {
+            options.threads = parseList(arg + 10);
+        } else if (startsWith(arg, "--repeats=")) {
+            options.repeats = std::atoi(arg + 10);
+        } else if (startsWith(arg, "--filter=")) {
+            options.filter = arg + 9;
+        } else if (startsWith(arg, "--label=")) {
+            options.label = arg + 8;
+        } else if (startsWith(arg, "--out=")) {
+            options.outPath = arg + 6;
+        } else if (startsWith(arg, "--replay=")) {
+            options.replayPath = arg + 9;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            options.list = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Fewer samples for huge counts so a full run stays in minutes
+int repeatsFor(std::size_t count, const Options& options) {
+    if (options.repeats > 0) return options.repeats;
+    std::size_t budget = 2000000 / (count ? count : 1);
+    if (budget < 3) return 3;
+    if (budget > 50) return 50;
+    return static_cast<int>(budget);
+}
+
+std::string escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+    const char* backend = starship::simd::getBackendName(starship::simd::activeKernels().backend);
+    out << "{\n";
+    out << "  \"suite\": \"starship-bench\",\n";
+    out << "  \"format\": 1,\n";
+    out << "  \"label\": \"" << escape(options.label) << "\",\n";
+    out << "  \"simd_backend\": \"" << backend << "\",\n";
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        double perSecond = r.medianNs > 0.0 ? 1.0e9 / r.medianNs : 0.0;
+        double perEntity = r.entities ? r.medianNs / static_cast<double>(r.entities) : 0.0;
+        char line[512];
+        std::snprintf(line, sizeof(line),
+                      "%s\n    {\"name\": \"%s\", \"count\": %zu, \"threads\": %u, \"entities\": %zu, \"samples\": %zu, "
+                      "\"median_ns\": %.1f, \"min_ns\": %.1f, \"max_ns\": %.1f, "
+                      "\"ops_per_sec\": %.3f, \"ns_per_entity\": %.3f}",
+                      i ? "," : "", escape(r.name).c_str(), r.count, r.threads, r.entities, r.samples,
+                      r.medianNs, r.minNs, r.maxNs, perSecond, perEntity);
+        out << line;
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) return 2;
+
+    std::vector<Benchmark> benchmarks = starship::bench::allBenchmarks();
+    if (!options.replayPath.empty()) {
+        starship::Recording recording;
+        if (!recording.loadFromFile(options.replayPath)) {
+            std::cerr << "Cannot read recording " << options.replayPath << std::endl;
+            return 1;
+        }
+        benchmarks = {starship::bench::makeReplayBenchmark(recording)};
+        options.counts = {recording.getTickCount()};
+    }
+    if (options.list) {
+        for (const Benchmark& b : benchmarks) {
+            std::cout << b.name << "  - " << b.description << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<Result> results;
+    for (std::size_t threadCount : options.threads) {
+        // One pool per thread count, shared by every game in the run
+        std::shared_ptr<starship::ThreadPool> pool;
+        if (threadCount != 1) {
+            pool = std::make_shared<starship::ThreadPool>(static_cast<unsigned>(threadCount));
+        }
+        unsigned threads = pool ? pool->getThreadCount() : 1;
+
+        for (const Benchmark& b : benchmarks) {
+            if (!options.filter.empty() && b.name.find(options.filter) == std::string::npos) continue;
+            for (std::size_t count : options.counts) {
+                RunConfig config{count, repeatsFor(count, options), pool};
+                Samples samples;
+                try {
+                    b.run(config, samples);
+                } catch (const std::runtime_error& e) {
+                    std::cerr << b.name << " @ " << count << " failed: " << e.what() << std::endl;
+                    return 1;
+                }
+                results.push_back(starship::bench::summarize(b.name, count, threads, samples));
+                // Progress goes to stderr so stdout stays valid JSON
+                std::cerr << b.name << " @ " << count << " x" << threads << ": "
+                          << results.back().medianNs / 1000.0 << " us" << std::endl;
+            }
+        }
+    }
+
+    if (options.outPath.empty()) {
+        writeJson(std::cout, options, results);
+    } else {
+        std::ofstream file(options.outPath);
+        if (!file) {
+            std::cerr << "Cannot write " << options.outPath << std::endl;
+            return 1;
+        }
+        writeJson(file, options, results);
+    }
+    return 0;
+}
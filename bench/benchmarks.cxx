@@ -0,0 +1,330 @@
+// Benchmarks for the headless engine: tick, collisions, compaction,
+// spawning and splitting at a given entity count.
+#include "bench.hxx"
+#include "starship/game.hxx"
+#include "starship/game_batch.hxx"
+#include "starship/replay.hxx"
+#include "starship/rewind_buffer.hxx"
+#include "starship/snapshot.hxx"
+#include "starship/timer_wheel.hxx"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+namespace starship {
+namespace bench {
+
+namespace {
+
+// World area per asteroid, close to a busy late-level screen
+constexpr float kAreaPerAsteroid = 2500.0f;
+
+// Spacing of the lattice used when every asteroid must be hit
+constexpr float kLatticeSpacing = 50.0f;
+
+constexpr float kTick = Game::DEFAULT_TIMESTEP;
+
+// Seed for games the benchmarks do not otherwise seed, so runs are comparable
+constexpr std::uint32_t kFixedSeed = 7;
+
+float worldSide(std::size_t asteroids) {
+    return std::sqrt(kAreaPerAsteroid * static_cast<float>(asteroids));
+}
+
+// Game with `count` slowly drifting asteroids spread at constant density.
+// The player is shielded so it never interrupts a run by dying.
+std::unique_ptr<Game> makeWorld(const RunConfig& config, std::uint32_t seed) {
+    const std::size_t count = config.count;
+    float side = worldSide(count);
+    auto game = std::make_unique<Game>(side, side, seed);
+    game->setThreadPool(config.pool);
+    game->applyPowerUp(PowerUp::Type::SHIELD);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+    std::uniform_real_distribution<float> drift(-5.0f, 5.0f);
+    std::uniform_int_distribution<int> sizeDist(0, 2);
+    for (std::size_t i = 0; i < count; ++i) {
+        game->spawnAsteroid(Vector2D(coord(rng), coord(rng)),
+                            Vector2D(drift(rng), drift(rng)),
+                            static_cast<Asteroid::Size>(sizeDist(rng)));
+    }
+    return game;
+}
+
+// Scatter projectiles that mostly miss, so the asteroid field stays intact
+void addProjectiles(Game& game, std::size_t count, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, game.getWidth());
+    for (std::size_t i = 0; i < count; ++i) {
+        game.spawnProjectile(Vector2D(coord(rng), coord(rng)), Vector2D(0.0f, -300.0f));
+    }
+}
+
+// Large asteroids on a lattice with a projectile sitting on every one
+std::unique_ptr<Game> makeShootingGallery(std::size_t count, const RunConfig& config) {
+    std::size_t perRow = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    float side = kLatticeSpacing * static_cast<float>(perRow + 1);
+    auto game = std::make_unique<Game>(side, side, kFixedSeed);
+    game->setThreadPool(config.pool);
+    game->applyPowerUp(PowerUp::Type::SHIELD);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Vector2D pos(kLatticeSpacing * static_cast<float>(i % perRow + 1),
+                     kLatticeSpacing * static_cast<float>(i / perRow + 1));
+        game->spawnAsteroid(pos, Vector2D(0.0f, 10.0f), Asteroid::Size::LARGE);
+        game->spawnProjectile(pos, Vector2D(0.0f, -300.0f));
+    }
+    return game;
+}
+
+std::size_t liveEntities(const Game& game) {
+    return game.getAsteroids().liveCount() + game.getProjectiles().liveCount() + game.getPowerUps().liveCount();
+}
+
+void benchUpdate(const RunConfig& config, Samples& out) {
+    const std::size_t count = config.count;
+    auto game = makeWorld(config, 1);
+    addProjectiles(*game, count / 10, 2);
+    for (std::size_t i = 0; i < count / 100; ++i) {
+        game->spawnPowerUp(Vector2D(game->getWidth() * 0.5f, game->getHeight() * 0.25f));
+    }
+    game->update(kTick);  // Warm-up: sizes the grid and scratch buffers
+
+    out.entities = liveEntities(*game);
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { game->update(kTick); }));
+    }
+}
+
+void benchCheckCollisions(const RunConfig& config, Samples& out) {
+    const std::size_t count = config.count;
+    auto game = makeWorld(config, 3);
+    addProjectiles(*game, count / 10, 4);
+    game->checkCollisions();
+
+    out.entities = liveEntities(*game);
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { game->checkCollisions(); }));
+    }
+}
+
+void benchRemoveInactive(const RunConfig& config, Samples& out) {
+    const std::size_t count = config.count;
+    for (int r = 0; r < config.repeats; ++r) {
+        // Half the field is destroyed (and split) before the timed compaction
+        auto game = makeShootingGallery(count / 2, config);
+        std::size_t extra = count - count / 2;
+        float side = game->getWidth();
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> coord(0.0f, side);
+        for (std::size_t i = 0; i < extra; ++i) {
+            game->spawnAsteroid(Vector2D(coord(rng), -side), Vector2D(0.0f, 0.0f), Asteroid::Size::SMALL);
+        }
+        game->checkCollisions();
+
+        out.entities = liveEntities(*game);
+        out.nanos.push_back(timeOnce([&] { game->removeInactiveEntities(); }));
+    }
+}
+
+void benchSpawn(const RunConfig& config, Samples& out) {
+    const std::size_t count = config.count;
+    out.entities = count;
+    for (int r = 0; r < config.repeats; ++r) {
+        Game game(800.0f, 600.0f, kFixedSeed);
+        out.nanos.push_back(timeOnce([&] {
+            for (std::size_t i = 0; i < count; ++i) {
+                game.spawnAsteroid(Vector2D(400.0f, -20.0f), Vector2D(0.0f, 20.0f), Asteroid::Size::LARGE);
+            }
+        }));
+    }
+}
+
+void benchSplit(const RunConfig& config, Samples& out) {
+    out.entities = config.count;
+    for (int r = 0; r < config.repeats; ++r) {
+        auto game = makeShootingGallery(config.count, config);
+        out.nanos.push_back(timeOnce([&] { game->checkCollisions(); }));
+    }
+}
+
+// World-space outline buffer for the whole field, as a renderer asks for
+// it once per tick
+void benchOutlines(const RunConfig& config, Samples& out) {
+    auto game = makeWorld(config, 6);
+    const AsteroidColumns& columns = game->getAsteroids().data();
+    AsteroidOutlines outlines;
+    outlines.build(columns);  // Warm-up: generates shapes, sizes the buffer
+
+    out.entities = config.count;
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { outlines.build(columns); }));
+    }
+}
+
+// A bot's worth of spatial queries after one tick: the first refits the
+// asteroid BVH, the rest are tree walks. ns_per_entity is per query.
+void benchSpatialQueries(const RunConfig& config, Samples& out) {
+    constexpr int QUERIES = 256;
+    auto game = makeWorld(config, 12);
+    const float side = game->getWidth();
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> coord(0.0f, side);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::vector<Vector2D> points(QUERIES);
+    std::vector<Vector2D> directions(QUERIES);
+    for (int q = 0; q < QUERIES; ++q) {
+        points[q] = Vector2D(coord(rng), coord(rng));
+        float a = angle(rng);
+        directions[q] = Vector2D(std::cos(a), std::sin(a));
+    }
+    std::vector<AsteroidHandle> found;
+    RaycastHit<AsteroidHandle> hit;
+    auto run = [&] {
+        for (int q = 0; q < QUERIES; q += 2) {
+            game->nearestK(points[q], 4, found);
+            game->raycast(points[q + 1], directions[q + 1], 400.0f, hit);
+        }
+    };
+    game->update(kTick);
+    run();  // Warm-up: first build, sizes the buffers
+
+    out.entities = QUERIES;
+    for (int r = 0; r < config.repeats; ++r) {
+        game->update(kTick);
+        out.nanos.push_back(timeOnce(run));
+    }
+}
+
+// One tick of `count` independent small games; ns_per_entity is the cost
+// of a single game tick
+void benchBatchStep(const RunConfig& config, Samples& out) {
+    GameBatch batch(config.count, 800.0f, 600.0f, kFixedSeed);
+    batch.setThreadPool(config.pool);
+    batch.setAutoReset(true);
+
+    // Fire and sweep left-right so the games see shooting and splits
+    std::vector<InputMask> inputs(config.count);
+    for (std::size_t i = 0; i < config.count; ++i) {
+        inputs[i] = INPUT_FIRE | ((i & 1) ? INPUT_LEFT : INPUT_RIGHT);
+    }
+    batch.run(inputs.data(), 120);  // Warm-up: two seconds of play
+
+    out.entities = config.count;
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { batch.step(inputs.data()); }));
+    }
+}
+
+// One tick of a timer wheel holding `count` lifetimes spread over ten
+// seconds, re-arming whatever fires. Cost follows the expirations per
+// tick, not the number pending.
+void benchTimerWheel(const RunConfig& config, Samples& out) {
+    constexpr std::uint64_t kSpread = 600;
+    TimerWheel wheel(0);
+    wheel.reserve(config.count);
+    std::vector<TimerWheel::Timer> fired;
+    fired.reserve(config.count);
+    std::mt19937 rng(kFixedSeed);
+    std::uniform_int_distribution<std::uint64_t> deadline(1, kSpread);
+    for (std::size_t i = 0; i < config.count; ++i) {
+        wheel.schedule(deadline(rng), 0, static_cast<std::uint32_t>(i));
+    }
+
+    out.entities = config.count;
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] {
+            fired.clear();
+            wheel.advance(wheel.getCurrentTick() + 1, fired);
+            for (const TimerWheel::Timer& timer : fired) {
+                wheel.schedule(timer.deadline + kSpread, timer.kind, timer.id);
+            }
+        }));
+    }
+}
+
+// One update of the same world with sectors on, so only the asteroids
+// around the player are live. Cost follows the active region, not count.
+void benchSectorWorld(const RunConfig& config, Samples& out) {
+    constexpr float kSectorSize = 800.0f;
+    auto game = makeWorld(config, 12);
+    game->setSectors(kSectorSize, 1);
+    game->update(kTick);
+
+    out.entities = liveEntities(*game);
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { game->update(kTick); }));
+    }
+}
+
+// Restoring a whole world from an in-memory snapshot into a warm game
+void benchSnapshotRestore(const RunConfig& config, Samples& out) {
+    auto game = makeWorld(config, 8);
+    addProjectiles(*game, config.count / 10, 9);
+    Snapshot snapshot = Snapshot::capture(*game);
+    snapshot.restore(*game);  // Warm-up: columns already have capacity
+
+    out.entities = liveEntities(*game);
+    for (int r = 0; r < config.repeats; ++r) {
+        out.nanos.push_back(timeOnce([&] { snapshot.restore(*game); }));
+    }
+}
+
+// Per-tick cost of keeping a rewind buffer, to compare against update
+void benchRewindRecord(const RunConfig& config, Samples& out) {
+    auto game = makeWorld(config, 10);
+    addProjectiles(*game, config.count / 10, 11);
+    RewindBuffer buffer(RewindBuffer::DEFAULT_KEYFRAME_INTERVAL * 2);
+    // Warm-up: fill the ring so every frame has its memory
+    for (std::size_t i = 0; i < buffer.getCapacity(); ++i) {
+        game->update(kTick);
+        buffer.record(*game);
+    }
+
+    out.entities = liveEntities(*game);
+    for (int r = 0; r < config.repeats; ++r) {
+        game->update(kTick);
+        out.nanos.push_back(timeOnce([&] { buffer.record(*game); }));
+    }
+}
+
+} // namespace
+
+std::vector<Benchmark> allBenchmarks() {
+    return {
+        {"update", "One Game::update tick over asteroids, projectiles and power-ups", benchUpdate},
+        {"checkCollisions", "Collision pass with one projectile per ten asteroids", benchCheckCollisions},
+        {"removeInactiveEntities", "Compaction after half the asteroids were destroyed", benchRemoveInactive},
+        {"spawnAsteroid", "Spawning count asteroids into a fresh game", benchSpawn},
+        {"split", "Collision pass where every projectile hits and splits a large asteroid", benchSplit},
+        {"asteroidOutlines", "World-space outline buffer for count asteroids", benchOutlines},
+        {"spatialQueries", "128 nearestK and 128 raycast queries against count asteroids after a tick", benchSpatialQueries},
+        {"snapshotRestore", "Snapshot::restore of a world with count asteroids", benchSnapshotRestore},
+        {"rewindRecord", "RewindBuffer::record after one update tick", benchRewindRecord},
+        {"batchStep", "GameBatch::step over count independent 800x600 games", benchBatchStep},
+        {"timerWheel", "One tick of a timer wheel with count lifetimes pending over ten seconds", benchTimerWheel},
+        {"sectorWorld", "One Game::update tick of count asteroids with only the player's sectors live", benchSectorWorld},
+    };
+}
+
+Benchmark makeReplayBenchmark(const Recording& recording) {
+    auto shared = std::make_shared<Recording>(recording);
+    auto run = [shared](const RunConfig& config, Samples& out) {
+        out.entities = shared->getTickCount();
+        for (int r = 0; r < config.repeats; ++r) {
+            Game game = shared->createGame();
+            game.setThreadPool(config.pool);
+            bool matched = true;
+            out.nanos.push_back(timeOnce([&] { matched = replay(*shared, game); }));
+            if (!matched) {
+                throw std::runtime_error("replay diverged from the recorded checksum");
+            }
+        }
+    };
+    return {"replay", "Headless replay of a recorded session, per whole session", run};
+}
+
+} // namespace bench
+} // namespace starship
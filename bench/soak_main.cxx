@@ -0,0 +1,153 @@
+// starship-soak: end-to-end soak scenarios with JSON output.
+//
+// Usage: starship-soak [--scenario=name,...] [--ticks=N] [--seed=N]
+//                      [--label=text] [--out=file.json] [--list]
+//
+// Every scenario runs once, headless, for its default length unless
+// --ticks is given. Links the allocation hooks, so the report carries
+// real heap numbers.
+#include "starship/soak.hxx"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using starship::SoakReport;
+using starship::SoakScenario;
+
+struct Options {
+    std::vector<std::string> scenarios;  // Empty = all
+    std::uint64_t ticks = 0;             // 0 = each scenario's default
+    std::uint32_t seed = 1;
+    std::string label;
+    std::string outPath;
+    bool list = false;
+};
+
+bool startsWith(const char* arg, const char* prefix) {
+    return std::strncmp(arg, prefix, std::strlen(prefix)) == 0;
+}
+
+std::vector<std::string> parseNames(const std::string& text) {
+    std::vector<std::string> names;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) names.push_back(item);
+    }
+    return names;
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (startsWith(arg, "--scenario=")) {
+            options.scenarios = parseNames(arg + 11);
+        } else if (startsWith(arg, "--ticks=")) {
+            options.ticks = std::strtoull(arg + 8, nullptr, 10);
+        } else if (startsWith(arg, "--seed=")) {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(arg + 7, nullptr, 10));
+        } else if (startsWith(arg, "--label=")) {
+            options.label = arg + 8;
+        } else if (startsWith(arg, "--out=")) {
+            options.outPath = arg + 6;
+        } else if (std::strcmp(arg, "--list") == 0) {
+            options.list = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<SoakReport>& reports) {
+    out << "{\n";
+    out << "  \"suite\": \"starship-soak\",\n";
+    out << "  \"format\": 1,\n";
+    out << "  \"label\": \"" << escape(options.label) << "\",\n";
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        const SoakReport& r = reports[i];
+        char line[1024];
+        std::snprintf(line, sizeof(line),
+                      "%s\n    {\"name\": \"%s\", \"seed\": %u, \"ticks\": %llu, \"seconds\": %.3f, "
+                      "\"ticks_per_sec\": %.1f, \"peak_asteroids\": %zu, \"peak_projectiles\": %zu, "
+                      "\"peak_powerups\": %zu, \"peak_live_bytes\": %llu, \"allocating_ticks\": %llu, "
+                      "\"tick_p50_ns\": %llu, \"tick_p99_ns\": %llu, \"tick_p999_ns\": %llu, \"tick_max_ns\": %llu, "
+                      "\"score\": %d, \"max_level\": %d, \"deaths\": %d, \"checksum\": \"%016llx\"}",
+                      i ? "," : "", escape(r.name).c_str(), r.seed, static_cast<unsigned long long>(r.ticks),
+                      r.seconds, r.ticksPerSecond, r.peakAsteroids, r.peakProjectiles, r.peakPowerUps,
+                      static_cast<unsigned long long>(r.peakLiveBytes),
+                      static_cast<unsigned long long>(r.allocatingTicks),
+                      static_cast<unsigned long long>(r.tickP50), static_cast<unsigned long long>(r.tickP99),
+                      static_cast<unsigned long long>(r.tickP999), static_cast<unsigned long long>(r.tickMax),
+                      r.score, r.maxLevel, r.deaths, static_cast<unsigned long long>(r.checksum));
+        out << line;
+    }
+    out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArgs(argc, argv, options)) return 2;
+
+    if (options.list) {
+        for (const SoakScenario& s : starship::getSoakScenarios()) {
+            std::cout << s.name << "  - " << s.description << " (" << s.defaultTicks << " ticks)" << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<const SoakScenario*> selected;
+    if (options.scenarios.empty()) {
+        for (const SoakScenario& s : starship::getSoakScenarios()) selected.push_back(&s);
+    } else {
+        for (const std::string& name : options.scenarios) {
+            const SoakScenario* s = starship::findSoakScenario(name);
+            if (!s) {
+                std::cerr << "Unknown scenario: " << name << std::endl;
+                return 2;
+            }
+            selected.push_back(s);
+        }
+    }
+
+    std::vector<SoakReport> reports;
+    for (const SoakScenario* s : selected) {
+        reports.push_back(starship::runSoak(*s, options.seed, options.ticks));
+        // Progress goes to stderr so stdout stays valid JSON
+        const SoakReport& r = reports.back();
+        std::cerr << r.name << ": " << r.ticks << " ticks, " << static_cast<long long>(r.ticksPerSecond)
+                  << " ticks/s, p99 " << r.tickP99 / 1000.0 << " us" << std::endl;
+    }
+
+    if (options.outPath.empty()) {
+        writeJson(std::cout, options, reports);
+    } else {
+        std::ofstream file(options.outPath);
+        if (!file) {
+            std::cerr << "Cannot write " << options.outPath << std::endl;
+            return 1;
+        }
+        writeJson(file, options, reports);
+    }
+    return 0;
+}
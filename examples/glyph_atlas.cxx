@@ -0,0 +1,167 @@
+#include "glyph_atlas.hxx"
+#include <algorithm>
+
+namespace {
+
+// Atlas rows wrap at this width
+constexpr int ATLAS_WIDTH = 512;
+
+// Padding between glyphs so linear filtering never bleeds neighbours in
+constexpr int GLYPH_PADDING = 1;
+
+} // namespace
+
+GlyphAtlas::~GlyphAtlas() {
+    release();
+}
+
+void GlyphAtlas::release() {
+    if (texture) SDL_DestroyTexture(texture);
+    texture = nullptr;
+}
+
+bool GlyphAtlas::build(SDL_Renderer* renderer, TTF_Font* font) {
+    const SDL_Color white = {255, 255, 255, 255};
+    lineHeight = TTF_FontHeight(font);
+
+    // Render every glyph and work out where it goes
+    std::vector<SDL_Surface*> surfaces(glyphs.size(), nullptr);
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+    for (std::size_t i = 0; i < glyphs.size(); ++i) {
+        Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + static_cast<int>(i));
+        SDL_Surface* surface = TTF_RenderGlyph_Blended(font, ch, white);
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, ch, nullptr, nullptr, nullptr, nullptr, &advance) != 0) {
+            advance = surface ? surface->w : 0;
+        }
+        surfaces[i] = surface;
+
+        int w = surface ? surface->w : 0;
+        int h = surface ? surface->h : 0;
+        if (penX + w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + GLYPH_PADDING;
+            rowHeight = 0;
+        }
+        glyphs[i].source = SDL_Rect{penX, penY, w, h};
+        glyphs[i].advance = advance;
+        penX += w + GLYPH_PADDING;
+        rowHeight = std::max(rowHeight, h);
+    }
+    int atlasHeight = penY + rowHeight;
+
+    // Copy them into one RGBA surface, alpha included
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, ATLAS_WIDTH, std::max(atlasHeight, 1),
+                                                               32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface) {
+        for (std::size_t i = 0; i < glyphs.size(); ++i) {
+            if (!surfaces[i]) continue;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dest = glyphs[i].source;
+            SDL_BlitSurface(surfaces[i], nullptr, atlasSurface, &dest);
+        }
+    }
+    for (SDL_Surface* surface : surfaces) {
+        if (surface) SDL_FreeSurface(surface);
+    }
+    if (!atlasSurface) return false;
+
+    release();
+    texture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!texture) return false;
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::get(char c) const {
+    if (c < FIRST_GLYPH || c > LAST_GLYPH) c = '?';
+    return glyphs[static_cast<std::size_t>(c - FIRST_GLYPH)];
+}
+
+void TextLabel::setText(const GlyphAtlas& atlas, const char* newText) {
+    if (text == newText) return;
+    text = newText;
+
+    // Glyph surfaces are already placed relative to the baseline, so
+    // laying out is just advancing the pen
+    quads.clear();
+    float penX = 0.0f;
+    for (char c : text) {
+        const GlyphAtlas::Glyph& glyph = atlas.get(c);
+        if (glyph.source.w > 0) {
+            quads.push_back(Quad{SDL_FRect{penX, 0.0f, static_cast<float>(glyph.source.w),
+                                           static_cast<float>(glyph.source.h)},
+                                 glyph.source});
+        }
+        penX += static_cast<float>(glyph.advance);
+    }
+    width = static_cast<int>(penX);
+}
+
+void TextLayer::clear() {
+    placed.clear();
+}
+
+void TextLayer::add(const TextLabel& label, float x, float y, SDL_Color color) {
+    if (!label.quads.empty()) {
+        placed.push_back(Placed{&label, x, y, color});
+    }
+}
+
+int TextLayer::flush(SDL_Renderer* renderer) {
+    if (placed.empty() || !atlas.isBuilt()) return 0;
+    SDL_Texture* texture = atlas.getTexture();
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int atlasW = 0;
+    int atlasH = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &atlasW, &atlasH);
+    const float invW = 1.0f / static_cast<float>(atlasW);
+    const float invH = 1.0f / static_cast<float>(atlasH);
+
+    vertices.clear();
+    indices.clear();
+    for (const Placed& p : placed) {
+        for (const TextLabel::Quad& q : p.label->quads) {
+            float x0 = p.x + q.dest.x;
+            float y0 = p.y + q.dest.y;
+            float x1 = x0 + q.dest.w;
+            float y1 = y0 + q.dest.h;
+            float u0 = static_cast<float>(q.source.x) * invW;
+            float v0 = static_cast<float>(q.source.y) * invH;
+            float u1 = static_cast<float>(q.source.x + q.source.w) * invW;
+            float v1 = static_cast<float>(q.source.y + q.source.h) * invH;
+
+            int base = static_cast<int>(vertices.size());
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y0}, p.color, SDL_FPoint{u0, v0}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y0}, p.color, SDL_FPoint{u1, v0}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x1, y1}, p.color, SDL_FPoint{u1, v1}});
+            vertices.push_back(SDL_Vertex{SDL_FPoint{x0, y1}, p.color, SDL_FPoint{u0, v1}});
+            indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+        }
+    }
+    if (SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size())) == 0) {
+        return 1;
+    }
+#endif
+
+    // One copy per glyph, still without creating any textures
+    int calls = 0;
+    for (const Placed& p : placed) {
+        SDL_SetTextureColorMod(texture, p.color.r, p.color.g, p.color.b);
+        SDL_SetTextureAlphaMod(texture, p.color.a);
+        for (const TextLabel::Quad& q : p.label->quads) {
+            SDL_FRect dest{p.x + q.dest.x, p.y + q.dest.y, q.dest.w, q.dest.h};
+            SDL_RenderCopyF(renderer, texture, &q.source, &dest);
+            ++calls;
+        }
+    }
+    SDL_SetTextureColorMod(texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(texture, 255);
+    return calls;
+}
@@ -0,0 +1,101 @@
+#ifndef STARSHIP_EXAMPLES_GLYPH_ATLAS_HXX
+#define STARSHIP_EXAMPLES_GLYPH_ATLAS_HXX
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Printable ASCII rendered once into a single texture. Built when the
+// font is loaded, so steady-state frames never create textures.
+class GlyphAtlas {
+public:
+    static constexpr char FIRST_GLYPH = ' ';
+    static constexpr char LAST_GLYPH = '~';
+
+    struct Glyph {
+        SDL_Rect source;  // Area of the atlas texture
+        int advance;      // Pen movement after this glyph
+    };
+
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // Render every glyph of `font` and upload the atlas; false on failure
+    bool build(SDL_Renderer* renderer, TTF_Font* font);
+    bool isBuilt() const { return texture != nullptr; }
+    // Free the texture; must happen before its renderer is destroyed
+    void release();
+
+    SDL_Texture* getTexture() const { return texture; }
+    int getLineHeight() const { return lineHeight; }
+
+    // Glyph for `c`; characters outside the atlas map to '?'
+    const Glyph& get(char c) const;
+
+private:
+    SDL_Texture* texture = nullptr;
+    int lineHeight = 0;
+    std::array<Glyph, LAST_GLYPH - FIRST_GLYPH + 1> glyphs{};
+};
+
+// One string laid out against an atlas. Layout is cached and redone only
+// when the text changes, so a label whose value is unchanged costs
+// nothing to keep.
+class TextLabel {
+public:
+    // Re-lays out only if `text` differs from the current string
+    void setText(const GlyphAtlas& atlas, const char* text);
+    const std::string& getText() const { return text; }
+
+    int getWidth() const { return width; }
+
+private:
+    friend class TextLayer;
+
+    // Per glyph: destination relative to the label origin, and source
+    struct Quad {
+        SDL_FRect dest;
+        SDL_Rect source;
+    };
+
+    std::string text;
+    std::vector<Quad> quads;
+    int width = 0;
+};
+
+// Collects the labels drawn this frame and submits them together: one
+// SDL_RenderGeometry call on SDL 2.0.18+, otherwise one SDL_RenderCopy
+// per glyph from the shared atlas texture.
+class TextLayer {
+public:
+    explicit TextLayer(const GlyphAtlas& atlas) : atlas(atlas) {}
+
+    void clear();
+    void add(const TextLabel& label, float x, float y, SDL_Color color);
+
+    // Draw everything added since clear(); returns the SDL draw calls used
+    int flush(SDL_Renderer* renderer);
+
+private:
+    struct Placed {
+        const TextLabel* label;
+        float x;
+        float y;
+        SDL_Color color;
+    };
+
+    const GlyphAtlas& atlas;
+    std::vector<Placed> placed;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+#endif
+};
+
+#endif // STARSHIP_EXAMPLES_GLYPH_ATLAS_HXX
@@ -0,0 +1,150 @@
+#include "line_batch.hxx"
+#include <cmath>
+#include <utility>
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+
+// Half the width of a line drawn as a quad, in pixels
+constexpr float HALF_WIDTH = 0.5f;
+
+} // namespace
+
+void LineBatch::clear() {
+    for (std::size_t i = 0; i < activeGroups; ++i) {
+        groups[i].points.clear();
+        groups[i].runs.clear();
+    }
+    activeGroups = 0;
+    setColor(255, 255, 255);
+}
+
+void LineBatch::setColor(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a) {
+    // A frame uses a handful of colours, so a linear search is enough
+    for (std::size_t i = 0; i < activeGroups; ++i) {
+        const SDL_Color& c = groups[i].color;
+        if (c.r == r && c.g == g && c.b == b && c.a == a) {
+            current = i;
+            return;
+        }
+    }
+    // Reuse a group left over from an earlier frame before adding one
+    if (activeGroups == groups.size()) {
+        groups.emplace_back();
+    }
+    current = activeGroups++;
+    groups[current].color = SDL_Color{r, g, b, a};
+}
+
+void LineBatch::addPolygon(const SDL_FPoint* points, std::size_t count) {
+    if (count < 2) return;
+    ColorGroup& g = group();
+    g.points.insert(g.points.end(), points, points + count);
+    g.points.push_back(points[0]);
+    g.runs.push_back(static_cast<std::uint32_t>(count + 1));
+}
+
+void LineBatch::addLine(float x1, float y1, float x2, float y2) {
+    ColorGroup& g = group();
+    g.points.push_back(SDL_FPoint{x1, y1});
+    g.points.push_back(SDL_FPoint{x2, y2});
+    g.runs.push_back(2);
+}
+
+void LineBatch::addCircle(float cx, float cy, float radius, int segments) {
+    const std::vector<SDL_FPoint>& unit = unitCircle(segments);
+    ColorGroup& g = group();
+    for (const SDL_FPoint& p : unit) {
+        g.points.push_back(SDL_FPoint{cx + p.x * radius, cy + p.y * radius});
+    }
+    g.points.push_back(SDL_FPoint{cx + unit[0].x * radius, cy + unit[0].y * radius});
+    g.runs.push_back(static_cast<std::uint32_t>(unit.size() + 1));
+}
+
+const std::vector<SDL_FPoint>& LineBatch::unitCircle(int segments) {
+    for (const CircleTable& table : circles) {
+        if (table.segments == segments) return table.unit;
+    }
+    CircleTable table;
+    table.segments = segments;
+    for (int i = 0; i < segments; ++i) {
+        float angle = TWO_PI * i / segments;
+        table.unit.push_back(SDL_FPoint{std::cos(angle), std::sin(angle)});
+    }
+    circles.push_back(std::move(table));
+    return circles.back().unit;
+}
+
+int LineBatch::flush(SDL_Renderer* renderer) {
+    lineCount = 0;
+    for (std::size_t i = 0; i < activeGroups; ++i) {
+        lineCount += groups[i].points.size() - groups[i].runs.size();
+    }
+    if (lineCount == 0) return 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (!geometryFailed && flushGeometry(renderer)) {
+        return 1;
+    }
+#endif
+    return flushLines(renderer);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+bool LineBatch::flushGeometry(SDL_Renderer* renderer) {
+    vertices.clear();
+    indices.clear();
+    vertices.reserve(lineCount * 4);
+    indices.reserve(lineCount * 6);
+
+    for (std::size_t gi = 0; gi < activeGroups; ++gi) {
+        const ColorGroup& g = groups[gi];
+        const SDL_FPoint* run = g.points.data();
+        for (std::uint32_t length : g.runs) {
+            for (std::uint32_t k = 0; k + 1 < length; ++k) {
+                SDL_FPoint a = run[k];
+                SDL_FPoint b = run[k + 1];
+                float dx = b.x - a.x;
+                float dy = b.y - a.y;
+                float len = std::sqrt(dx * dx + dy * dy);
+                if (len < 1e-6f) continue;
+                // Offset both ends by half a pixel along the normal
+                float nx = -dy / len * HALF_WIDTH;
+                float ny = dx / len * HALF_WIDTH;
+
+                int base = static_cast<int>(vertices.size());
+                vertices.push_back(SDL_Vertex{SDL_FPoint{a.x + nx, a.y + ny}, g.color, SDL_FPoint{0, 0}});
+                vertices.push_back(SDL_Vertex{SDL_FPoint{a.x - nx, a.y - ny}, g.color, SDL_FPoint{0, 0}});
+                vertices.push_back(SDL_Vertex{SDL_FPoint{b.x - nx, b.y - ny}, g.color, SDL_FPoint{0, 0}});
+                vertices.push_back(SDL_Vertex{SDL_FPoint{b.x + nx, b.y + ny}, g.color, SDL_FPoint{0, 0}});
+                indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+            }
+            run += length;
+        }
+    }
+
+    if (SDL_RenderGeometry(renderer, nullptr, vertices.data(), static_cast<int>(vertices.size()),
+                           indices.data(), static_cast<int>(indices.size())) != 0) {
+        // Renderer without geometry support: use lines from now on
+        geometryFailed = true;
+        return false;
+    }
+    return true;
+}
+#endif
+
+int LineBatch::flushLines(SDL_Renderer* renderer) {
+    int calls = 0;
+    for (std::size_t gi = 0; gi < activeGroups; ++gi) {
+        const ColorGroup& g = groups[gi];
+        SDL_SetRenderDrawColor(renderer, g.color.r, g.color.g, g.color.b, g.color.a);
+        const SDL_FPoint* run = g.points.data();
+        for (std::uint32_t length : g.runs) {
+            SDL_RenderDrawLinesF(renderer, run, static_cast<int>(length));
+            run += length;
+            ++calls;
+        }
+    }
+    return calls;
+}
@@ -0,0 +1,69 @@
+#ifndef STARSHIP_EXAMPLES_LINE_BATCH_HXX
+#define STARSHIP_EXAMPLES_LINE_BATCH_HXX
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Collects one frame of outline geometry and submits it in as few SDL
+// calls as possible. Outlines are grouped by colour. With SDL 2.0.18+
+// every segment becomes a thin quad, and the whole frame goes out in a
+// single SDL_RenderGeometry call. Older SDL, or renderers that refuse
+// geometry, get one SDL_RenderDrawLinesF call per outline instead.
+// Buffers keep their capacity, so a steady scene stops allocating.
+class LineBatch {
+public:
+    // Start a new frame; keeps every buffer's capacity
+    void clear();
+
+    // Colour for the outlines added next
+    void setColor(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t a = 255);
+
+    // Closed outline through `count` points
+    void addPolygon(const SDL_FPoint* points, std::size_t count);
+    void addLine(float x1, float y1, float x2, float y2);
+    // Regular polygon approximating a circle
+    void addCircle(float cx, float cy, float radius, int segments);
+
+    // Draw everything added since clear(); returns the SDL draw calls used
+    int flush(SDL_Renderer* renderer);
+
+    // Segments submitted by the last flush
+    std::size_t getLineCount() const { return lineCount; }
+
+private:
+    // Outlines of one colour: points of every outline back to back, with
+    // the closing point repeated, and the length of each outline
+    struct ColorGroup {
+        SDL_Color color;
+        std::vector<SDL_FPoint> points;
+        std::vector<std::uint32_t> runs;
+    };
+
+    struct CircleTable {
+        int segments;
+        std::vector<SDL_FPoint> unit;
+    };
+
+    std::vector<ColorGroup> groups;
+    std::size_t activeGroups = 0;
+    std::size_t current = 0;
+    std::size_t lineCount = 0;
+
+    std::vector<CircleTable> circles;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+    bool geometryFailed = false;
+
+    bool flushGeometry(SDL_Renderer* renderer);
+#endif
+    int flushLines(SDL_Renderer* renderer);
+
+    ColorGroup& group() { return groups[current]; }
+    const std::vector<SDL_FPoint>& unitCircle(int segments);
+};
+
+#endif // STARSHIP_EXAMPLES_LINE_BATCH_HXX
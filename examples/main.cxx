@@ -1,32 +1,42 @@
 #include "starship/game.hxx"
+#include "starship/asteroid_outlines.hxx"
+#include "starship/render_snapshot.hxx"
+#include "starship/replay.hxx"
+#include "starship/tick_profiler.hxx"
+#include "line_batch.hxx"
+#include "glyph_atlas.hxx"
+#include "sim_thread.hxx"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <thread>
-#include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
 
-// Helper function to render text
-void renderText(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, 
-                int x, int y, SDL_Color color = {255, 255, 255, 255}) {
-    SDL_Surface* surface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (surface) {
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-        if (texture) {
-            SDL_Rect rect{x, y, surface->w, surface->h};
-            SDL_RenderCopy(renderer, texture, nullptr, &rect);
-            SDL_DestroyTexture(texture);
-        }
-        SDL_FreeSurface(surface);
-    }
-}
-
-int main() {
+int main(int argc, char** argv) {
     const int SCREEN_WIDTH = 800;
     const int SCREEN_HEIGHT = 600;
 
+    // --seed=N fixes the world; --record=file saves the session for
+    // headless replay (starship-bench --replay=file)
+    std::uint32_t seed = std::random_device{}();
+    std::string recordPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = static_cast<std::uint32_t>(std::strtoul(argv[i] + 7, nullptr, 10));
+        } else if (std::strncmp(argv[i], "--record=", 9) == 0) {
+            recordPath = argv[i] + 9;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--seed=N] [--record=file]" << std::endl;
+            return 2;
+        }
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0) {
         std::cerr << "SDL_Init Error: " << SDL_GetError() << std::endl;
         return 1;
@@ -76,18 +86,55 @@ int main() {
         std::cerr << "Warning: Could not load font, using default rendering" << std::endl;
     }
 
-    starship::Game game(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT));
+    // Every glyph is rasterised once here; frames only draw quads from it
+    GlyphAtlas atlas;
+    if (font && !atlas.build(renderer, font)) {
+        std::cerr << "Warning: Could not build glyph atlas: " << SDL_GetError() << std::endl;
+    }
+    TextLayer text(atlas);
+
+    // HUD labels re-lay out only when their string changes
+    TextLabel scoreLabel, livesLabel, statsLabel;
+    TextLabel shieldLabel, multiShotLabel, rapidFireLabel, speedBoostLabel;
+    TextLabel gameOverLabel, finalScoreLabel, levelLabel;
+    shieldLabel.setText(atlas, "SHIELD");
+    multiShotLabel.setText(atlas, "MULTI-SHOT");
+    rapidFireLabel.setText(atlas, "RAPID FIRE");
+    speedBoostLabel.setText(atlas, "SPEED BOOST");
+    gameOverLabel.setText(atlas, "GAME OVER");
+    // F4 overlay: p50 / p99 / max of each update phase
+    TextLabel profileLabels[starship::TICK_PHASE_COUNT];
+    char textBuffer[96];
+
+    starship::Game game(static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT), seed);
+    starship::InputRecorder recorder(game);
+    
+    // The game runs on its own thread from here until sim.stop(); this
+    // thread only sees the snapshots it publishes
+    SimulationThread sim(game, recorder);
+    starship::TripleBuffer<starship::RenderSnapshot>& snapshots = sim.getSnapshots();
+    
+    // The last two snapshots, and the blend of them that gets drawn
+    starship::RenderSnapshot previous, current, frame;
+    auto currentArrived = std::chrono::steady_clock::now();
+    // Outlines are rebuilt here from the snapshot's shape seed
+    starship::AsteroidShapeLibrary shapes;
+    starship::AsteroidOutlines outlines;
+
+    // Outline batch, reused every frame
+    LineBatch lines;
+    bool showStats = false;  // F3 toggles the draw-call overlay
+    bool showProfile = false;
+    std::uint64_t frames = 0;
+    std::uint64_t totalDrawCalls = 0;
+    int lastDrawCalls = 0;
 
     bool running = true;
-    auto lastTime = std::chrono::high_resolution_clock::now();
+    bool firePressed = false;  // Kept until the sim thread has it
+    starship::InputMask lastSent = starship::INPUT_NONE;
+    sim.start();
 
     while (running) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<float> elapsed = currentTime - lastTime;
-        lastTime = currentTime;
-        float deltaTime = elapsed.count();
-        if (deltaTime > 0.1f) deltaTime = 0.1f;
-
         // Handle events
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -98,61 +145,62 @@ int main() {
                 if (kc == SDLK_q || kc == SDLK_ESCAPE) {
                     running = false;
                 }
+                if (kc == SDLK_F3) {
+                    showStats = !showStats;
+                }
+                if (kc == SDLK_F4) {
+                    showProfile = !showProfile;
+                }
                 // Fire on space
                 if (kc == SDLK_SPACE) {
-                    game.handleInput(' ', deltaTime);
+                    firePressed = true;
                 }
             }
         }
 
         // Poll keyboard state for continuous actions
         const Uint8* state = SDL_GetKeyboardState(NULL);
-        bool movingLeft = state[SDL_SCANCODE_A] || state[SDL_SCANCODE_LEFT];
-        bool movingRight = state[SDL_SCANCODE_D] || state[SDL_SCANCODE_RIGHT];
-        
-        if (movingLeft) {
-            game.handleInput('a', deltaTime);
-        } else if (movingRight) {
-            game.handleInput('d', deltaTime);
-        } else {
-            // Stop moving when no keys pressed
-            game.getPlayer().stopMoving();
+        starship::InputMask input = starship::INPUT_NONE;
+        if (state[SDL_SCANCODE_A] || state[SDL_SCANCODE_LEFT]) input |= starship::INPUT_LEFT;
+        if (state[SDL_SCANCODE_D] || state[SDL_SCANCODE_RIGHT]) input |= starship::INPUT_RIGHT;
+        if (state[SDL_SCANCODE_W] || state[SDL_SCANCODE_UP]) input |= starship::INPUT_THRUST;
+        if (firePressed || state[SDL_SCANCODE_SPACE]) input |= starship::INPUT_FIRE;
+
+        // Hand the control state to the sim thread when it changes. The
+        // sim latches fire, so a tap shorter than a tick still shoots.
+        if ((input != lastSent || firePressed) && sim.sendInput(input)) {
+            lastSent = input;
+            firePressed = false;
         }
         
-        if (state[SDL_SCANCODE_W] || state[SDL_SCANCODE_UP]) {
-            game.handleInput('w', deltaTime);
+        // Draw one tick behind the sim, blending the last two snapshots
+        // by how far we are into the tick after the newer one arrived
+        auto now = std::chrono::steady_clock::now();
+        if (snapshots.update()) {
+            std::swap(previous, current);
+            current = snapshots.readBuffer();
+            currentArrived = now;
         }
-
-        // Update game logic
-        game.update(deltaTime);
+        float alpha = std::chrono::duration<float>(now - currentArrived).count() / sim.getTimestep();
+        starship::blendSnapshots(previous, current, std::min(alpha, 1.0f), frame);
 
         // Render
         SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
         SDL_RenderClear(renderer);
+        lines.clear();
 
         // Draw player as detailed rocket
-        const auto& player = game.getPlayer();
-        float px = player.getPosition().x;
-        float py = player.getPosition().y;
+        float px = frame.playerPosition.x;
+        float py = frame.playerPosition.y;
         
         // Shield effect (cyan glow around player)
-        if (game.isShielded()) {
-            SDL_SetRenderDrawColor(renderer, 0, 255, 255, 100);  // Semi-transparent cyan
-            float shieldRadius = 25.0f;
-            int segments = 16;
-            for (int i = 0; i < segments; i++) {
-                float angle1 = 2.0f * 3.14159f * i / segments;
-                float angle2 = 2.0f * 3.14159f * (i + 1) / segments;
-                float x1 = px + shieldRadius * std::cos(angle1);
-                float y1 = py + shieldRadius * std::sin(angle1);
-                float x2 = px + shieldRadius * std::cos(angle2);
-                float y2 = py + shieldRadius * std::sin(angle2);
-                SDL_RenderDrawLineF(renderer, x1, y1, x2, y2);
-            }
+        if (frame.shielded) {
+            lines.setColor(0, 255, 255, 100);  // Semi-transparent cyan
+            lines.addCircle(px, py, 25.0f, 16);
         }
         
         // Rocket: nose cone, body, fins, and flame
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);  // White body
+        lines.setColor(255, 255, 255);  // White body
         
         // Nose cone (pointed tip)
         SDL_FPoint noseCone[3] = {
@@ -160,25 +208,21 @@ int main() {
             {px - 3.0f, py - 10.0f},            // left
             {px + 3.0f, py - 10.0f}             // right
         };
-        SDL_RenderDrawLineF(renderer, noseCone[0].x, noseCone[0].y, noseCone[1].x, noseCone[1].y);
-        SDL_RenderDrawLineF(renderer, noseCone[1].x, noseCone[1].y, noseCone[2].x, noseCone[2].y);
-        SDL_RenderDrawLineF(renderer, noseCone[2].x, noseCone[2].y, noseCone[0].x, noseCone[0].y);
+        lines.addPolygon(noseCone, 3);
         
         // Main body (cylinder)
-        SDL_RenderDrawLineF(renderer, px - 3.0f, py - 10.0f, px - 3.0f, py + 8.0f);
-        SDL_RenderDrawLineF(renderer, px + 3.0f, py - 10.0f, px + 3.0f, py + 8.0f);
-        SDL_RenderDrawLineF(renderer, px - 3.0f, py + 8.0f, px + 3.0f, py + 8.0f);
+        lines.addLine(px - 3.0f, py - 10.0f, px - 3.0f, py + 8.0f);
+        lines.addLine(px + 3.0f, py - 10.0f, px + 3.0f, py + 8.0f);
+        lines.addLine(px - 3.0f, py + 8.0f, px + 3.0f, py + 8.0f);
         
         // Left fin
-        SDL_SetRenderDrawColor(renderer, 200, 200, 255, 255);  // Light blue fins
+        lines.setColor(200, 200, 255);  // Light blue fins
         SDL_FPoint leftFin[3] = {
             {px - 3.0f, py + 4.0f},
             {px - 10.0f, py + 10.0f},
             {px - 3.0f, py + 8.0f}
         };
-        SDL_RenderDrawLineF(renderer, leftFin[0].x, leftFin[0].y, leftFin[1].x, leftFin[1].y);
-        SDL_RenderDrawLineF(renderer, leftFin[1].x, leftFin[1].y, leftFin[2].x, leftFin[2].y);
-        SDL_RenderDrawLineF(renderer, leftFin[2].x, leftFin[2].y, leftFin[0].x, leftFin[0].y);
+        lines.addPolygon(leftFin, 3);
         
         // Right fin
         SDL_FPoint rightFin[3] = {
@@ -186,175 +230,196 @@ int main() {
             {px + 10.0f, py + 10.0f},
             {px + 3.0f, py + 8.0f}
         };
-        SDL_RenderDrawLineF(renderer, rightFin[0].x, rightFin[0].y, rightFin[1].x, rightFin[1].y);
-        SDL_RenderDrawLineF(renderer, rightFin[1].x, rightFin[1].y, rightFin[2].x, rightFin[2].y);
-        SDL_RenderDrawLineF(renderer, rightFin[2].x, rightFin[2].y, rightFin[0].x, rightFin[0].y);
+        lines.addPolygon(rightFin, 3);
         
         // Flame effect at base
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);    // Yellow flame
+        lines.setColor(255, 255, 0);    // Yellow flame
         SDL_FPoint flameYellow[3] = {
             {px - 2.0f, py + 8.0f},
             {px + 2.0f, py + 8.0f},
             {px, py + 15.0f}
         };
-        SDL_RenderDrawLineF(renderer, flameYellow[0].x, flameYellow[0].y, flameYellow[1].x, flameYellow[1].y);
-        SDL_RenderDrawLineF(renderer, flameYellow[1].x, flameYellow[1].y, flameYellow[2].x, flameYellow[2].y);
-        SDL_RenderDrawLineF(renderer, flameYellow[2].x, flameYellow[2].y, flameYellow[0].x, flameYellow[0].y);
+        lines.addPolygon(flameYellow, 3);
         
         // Inner orange flame
-        SDL_SetRenderDrawColor(renderer, 255, 165, 0, 255);    // Orange
+        lines.setColor(255, 165, 0);    // Orange
         SDL_FPoint flameOrange[3] = {
             {px - 1.0f, py + 9.0f},
             {px + 1.0f, py + 9.0f},
             {px, py + 12.0f}
         };
-        SDL_RenderDrawLineF(renderer, flameOrange[0].x, flameOrange[0].y, flameOrange[1].x, flameOrange[1].y);
-        SDL_RenderDrawLineF(renderer, flameOrange[1].x, flameOrange[1].y, flameOrange[2].x, flameOrange[2].y);
-        SDL_RenderDrawLineF(renderer, flameOrange[2].x, flameOrange[2].y, flameOrange[0].x, flameOrange[0].y);
-
-        // Draw asteroids as rotating, irregular polygons
-        SDL_SetRenderDrawColor(renderer, 160, 160, 160, 255);
-        for (const auto& asteroid : game.getAsteroids()) {
-            const auto& shape = asteroid.getShape();
-            float ax = asteroid.getPosition().x;
-            float ay = asteroid.getPosition().y;
-            float rotation = asteroid.getRotation() * static_cast<float>(M_PI) / 180.0f;
-            float cosA = std::cos(rotation);
-            float sinA = std::sin(rotation);
+        lines.addPolygon(flameOrange, 3);
 
-            for (size_t i = 0; i < shape.size(); ++i) {
-                size_t next = (i + 1) % shape.size();
-                float x1 = ax + (shape[i].x * cosA - shape[i].y * sinA);
-                float y1 = ay + (shape[i].x * sinA + shape[i].y * cosA);
-                float x2 = ax + (shape[next].x * cosA - shape[next].y * sinA);
-                float y2 = ay + (shape[next].x * sinA + shape[next].y * cosA);
-                SDL_RenderDrawLineF(renderer, x1, y1, x2, y2);
-            }
+        // Draw asteroids from a world-space outline buffer built from the
+        // snapshot; Vector2D and SDL_FPoint are both a pair of floats.
+        // Snapshots hold live entities only.
+        lines.setColor(160, 160, 160);
+        if (shapes.getSeed() != frame.shapeSeed) {
+            shapes.setSeed(frame.shapeSeed);
+        }
+        outlines.build(frame, shapes);
+        for (size_t i = 0; i < outlines.size(); ++i) {
+            starship::ShapeView outline = outlines[i];
+            lines.addPolygon(reinterpret_cast<const SDL_FPoint*>(outline.points), outline.size());
         }
 
         // Draw power-ups as colored circles
-        for (const auto& powerUp : game.getPowerUps()) {
-            float r = powerUp.getRadius();
-            float px = powerUp.getPosition().x;
-            float py = powerUp.getPosition().y;
-            auto color = powerUp.getColor();
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-            
-            // Draw as circle using multiple line segments
-            int segments = 8;
-            for (int i = 0; i < segments; i++) {
-                float angle1 = 2.0f * 3.14159f * i / segments;
-                float angle2 = 2.0f * 3.14159f * (i + 1) / segments;
-                float x1 = px + r * std::cos(angle1);
-                float y1 = py + r * std::sin(angle1);
-                float x2 = px + r * std::cos(angle2);
-                float y2 = py + r * std::sin(angle2);
-                SDL_RenderDrawLineF(renderer, x1, y1, x2, y2);
-            }
+        for (const auto& powerUp : frame.powerUps) {
+            auto color = starship::PowerUp::getColorForType(powerUp.type);
+            lines.setColor(color.r, color.g, color.b, color.a);
+            lines.addCircle(powerUp.position.x, powerUp.position.y, powerUp.radius, 8);
         }
 
         // Draw projectiles as fire (small flame shapes - orange to yellow gradient) - LARGER
-        for (const auto& projectile : game.getProjectiles()) {
-            float prx = projectile.getPosition().x;
-            float pry = projectile.getPosition().y;
+        for (const auto& projectile : frame.projectiles) {
+            float prx = projectile.position.x;
+            float pry = projectile.position.y;
             
             // Yellow flame tip (larger)
-            SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+            lines.setColor(255, 255, 0);
             SDL_FPoint flame_tip[3] = {
                 {prx, pry - 7.0f},               // tip (increased)
                 {prx - 3.5f, pry + 3.0f},        // left (increased)
                 {prx + 3.5f, pry + 3.0f}         // right (increased)
             };
-            SDL_RenderDrawLineF(renderer, flame_tip[0].x, flame_tip[0].y, flame_tip[1].x, flame_tip[1].y);
-            SDL_RenderDrawLineF(renderer, flame_tip[1].x, flame_tip[1].y, flame_tip[2].x, flame_tip[2].y);
-            SDL_RenderDrawLineF(renderer, flame_tip[2].x, flame_tip[2].y, flame_tip[0].x, flame_tip[0].y);
+            lines.addPolygon(flame_tip, 3);
             
             // Orange flame base
-            SDL_SetRenderDrawColor(renderer, 255, 165, 0, 255);
+            lines.setColor(255, 165, 0);
             SDL_FPoint flame_base[3] = {
                 {prx - 2.5f, pry + 3.0f},
                 {prx - 2.0f, pry + 6.0f},
                 {prx + 2.0f, pry + 6.0f}
             };
-            SDL_RenderDrawLineF(renderer, flame_base[0].x, flame_base[0].y, flame_base[1].x, flame_base[1].y);
-            SDL_RenderDrawLineF(renderer, flame_base[1].x, flame_base[1].y, flame_base[2].x, flame_base[2].y);
-            SDL_RenderDrawLineF(renderer, flame_base[2].x, flame_base[2].y, flame_base[0].x, flame_base[0].y);
+            lines.addPolygon(flame_base, 3);
         }
 
         // Draw screen boundaries (left and right)
-        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-        SDL_RenderDrawLineF(renderer, 0.0f, 0.0f, 0.0f, static_cast<float>(SCREEN_HEIGHT));
-        SDL_RenderDrawLineF(renderer, static_cast<float>(SCREEN_WIDTH), 0.0f, static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT));
+        lines.setColor(100, 100, 100);
+        lines.addLine(0.0f, 0.0f, 0.0f, static_cast<float>(SCREEN_HEIGHT));
+        lines.addLine(static_cast<float>(SCREEN_WIDTH), 0.0f, static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT));
+
+        // One submission for all the outlines above
+        int drawCalls = lines.flush(renderer);
 
         // Render score and lives at top center
-        if (font) {
-            std::ostringstream scoreStream;
-            scoreStream << "Score: " << game.getScore();
-            renderText(renderer, font, scoreStream.str(), SCREEN_WIDTH / 2 - 40, 10);
+        if (atlas.isBuilt()) {
+            text.clear();
+            const SDL_Color white = {255, 255, 255, 255};
+            
+            std::snprintf(textBuffer, sizeof(textBuffer), "Score: %d", frame.score);
+            scoreLabel.setText(atlas, textBuffer);
+            text.add(scoreLabel, SCREEN_WIDTH / 2 - 40, 10, white);
             
-            std::ostringstream livesStream;
-            livesStream << "Lives: " << game.getPlayer().getHealth();
-            renderText(renderer, font, livesStream.str(), SCREEN_WIDTH / 2 - 40, 40);
+            std::snprintf(textBuffer, sizeof(textBuffer), "Lives: %d", frame.lives);
+            livesLabel.setText(atlas, textBuffer);
+            text.add(livesLabel, SCREEN_WIDTH / 2 - 40, 40, white);
             
             // Display active power-ups
-            int powerUpY = 70;
-            if (game.isShielded()) {
-                SDL_Color cyan = {0, 255, 255, 255};
-                renderText(renderer, font, "SHIELD", 10, powerUpY, cyan);
+            float powerUpY = 70.0f;
+            if (frame.shielded) {
+                text.add(shieldLabel, 10, powerUpY, SDL_Color{0, 255, 255, 255});
                 powerUpY += 30;
             }
-            if (game.hasMultiShot()) {
-                SDL_Color magenta = {255, 0, 255, 255};
-                renderText(renderer, font, "MULTI-SHOT", 10, powerUpY, magenta);
+            if (frame.multiShot) {
+                text.add(multiShotLabel, 10, powerUpY, SDL_Color{255, 0, 255, 255});
                 powerUpY += 30;
             }
-            if (game.hasRapidFire()) {
-                SDL_Color yellow = {255, 255, 0, 255};
-                renderText(renderer, font, "RAPID FIRE", 10, powerUpY, yellow);
+            if (frame.rapidFire) {
+                text.add(rapidFireLabel, 10, powerUpY, SDL_Color{255, 255, 0, 255});
                 powerUpY += 30;
             }
-            if (game.hasSpeedBoost()) {
-                SDL_Color orange = {255, 165, 0, 255};
-                renderText(renderer, font, "SPEED BOOST", 10, powerUpY, orange);
+            if (frame.speedBoost) {
+                text.add(speedBoostLabel, 10, powerUpY, SDL_Color{255, 165, 0, 255});
                 powerUpY += 30;
             }
             
             // Display game over message when lives exhausted
-            if (game.isGameOver()) {
-                SDL_Color redColor = {255, 0, 0, 255};
-                std::string gameOverMsg = "GAME OVER";
-                renderText(renderer, font, gameOverMsg, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 - 40, redColor);
+            if (frame.gameOver) {
+                const SDL_Color red = {255, 0, 0, 255};
+                text.add(gameOverLabel, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 - 40, red);
                 
-                std::ostringstream finalScoreStream;
-                finalScoreStream << "Final Score: " << game.getScore();
-                renderText(renderer, font, finalScoreStream.str(), SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2, redColor);
+                std::snprintf(textBuffer, sizeof(textBuffer), "Final Score: %d", frame.score);
+                finalScoreLabel.setText(atlas, textBuffer);
+                text.add(finalScoreLabel, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2, red);
                 
-                std::ostringstream levelStream;
-                levelStream << "Level Reached: " << game.getLevel();
-                renderText(renderer, font, levelStream.str(), SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 + 40, redColor);
+                std::snprintf(textBuffer, sizeof(textBuffer), "Level Reached: %d", frame.level);
+                levelLabel.setText(atlas, textBuffer);
+                text.add(levelLabel, SCREEN_WIDTH / 2 - 80, SCREEN_HEIGHT / 2 + 40, red);
             }
+            
+            // Counts from the previous frame, which is complete
+            if (showStats) {
+                std::snprintf(textBuffer, sizeof(textBuffer), "Draw calls: %d  Lines: %zu",
+                              lastDrawCalls, lines.getLineCount());
+                statsLabel.setText(atlas, textBuffer);
+                text.add(statsLabel, 10, SCREEN_HEIGHT - 30, SDL_Color{128, 128, 128, 255});
+            }
+            
+            // Refreshed twice a second so the numbers stay readable
+            if (showProfile) {
+                for (std::size_t i = 0; i < starship::TICK_PHASE_COUNT; ++i) {
+                    if (frames % 30 == 0 || profileLabels[i].getText().empty()) {
+                        const starship::RenderSnapshot::PhaseSummary& h = frame.profile[i];
+                        std::snprintf(textBuffer, sizeof(textBuffer), "%-10s p50 %7.1fus  p99 %7.1fus  max %7.1fus",
+                                      starship::getPhaseName(static_cast<starship::TickPhase>(i)),
+                                      h.p50 / 1000.0, h.p99 / 1000.0, h.max / 1000.0);
+                        profileLabels[i].setText(atlas, textBuffer);
+                    }
+                    text.add(profileLabels[i], SCREEN_WIDTH - 420.0f, 10.0f + 22.0f * static_cast<float>(i),
+                             SDL_Color{128, 255, 128, 255});
+                }
+            }
+            
+            drawCalls += text.flush(renderer);
         }
 
         SDL_RenderPresent(renderer);
+        ++frames;
+        totalDrawCalls += static_cast<std::uint64_t>(drawCalls);
+        lastDrawCalls = drawCalls;
         
         // Exit game when lives exhausted
-        if (game.isGameOver()) {
+        if (frame.gameOver) {
             std::this_thread::sleep_for(std::chrono::seconds(3));  // Show final stats for 3 seconds
             running = false;
         }
     }
+    
+    // The game is ours again once the sim thread has stopped
+    sim.stop();
 
+    atlas.release();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     if (font) TTF_CloseFont(font);
     TTF_Quit();
     SDL_Quit();
 
+    if (!recordPath.empty()) {
+        recorder.finish(game);
+        if (recorder.getRecording().saveToFile(recordPath)) {
+            std::cout << "Recorded " << recorder.getRecording().getTickCount()
+                      << " ticks (seed " << game.getSeed() << ") to " << recordPath << std::endl;
+        } else {
+            std::cerr << "Could not write recording to " << recordPath << std::endl;
+        }
+    }
+
     // Print final game stats
     std::cout << std::endl;
     std::cout << "=== GAME OVER ===" << std::endl;
     std::cout << "Final Score: " << game.getScore() << std::endl;
     std::cout << "Level Reached: " << game.getLevel() << std::endl;
+    if (frames > 0) {
+        std::cout << "Average draw calls per frame: "
+                  << static_cast<double>(totalDrawCalls) / static_cast<double>(frames) << std::endl;
+    }
+    const starship::LatencyHistogram& tick = game.getProfile()[starship::TickPhase::UPDATE];
+    if (tick.getCount() > 0) {
+        std::cout << "Update p50/p99/max (us): " << tick.percentile(50) / 1000.0 << " / "
+                  << tick.percentile(99) / 1000.0 << " / " << tick.getMax() / 1000.0 << std::endl;
+    }
     std::cout << "Thank you for playing!" << std::endl;
 
     return 0;
@@ -0,0 +1,83 @@
+#include "sim_thread.hxx"
+#include <chrono>
+
+namespace {
+
+// Percentiles are recomputed twice a second rather than every tick
+constexpr std::uint64_t PROFILE_INTERVAL = 30;
+
+} // namespace
+
+SimulationThread::SimulationThread(starship::Game& game, starship::InputRecorder& recorder)
+    : game(game),
+      recorder(recorder),
+      timestep(game.getFixedTimestep()),
+      profile(),
+      nextProfileTick(0),
+      running(false) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (running.exchange(true)) return;
+    // The first snapshot is ready before the render thread looks
+    publish();
+    thread = std::thread([this] { run(); });
+}
+
+void SimulationThread::stop() {
+    running.store(false);
+    if (thread.joinable()) thread.join();
+}
+
+void SimulationThread::run() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration tickLength =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(timestep));
+    const int maxSubsteps = game.getMaxSubsteps();
+
+    starship::InputMask held = starship::INPUT_NONE;
+    bool firePressed = false;
+    Clock::time_point nextTick = Clock::now() + tickLength;
+
+    while (running.load(std::memory_order_relaxed)) {
+        starship::InputMask input;
+        while (inputs.tryPop(input)) {
+            held = input;
+            if (input & starship::INPUT_FIRE) firePressed = true;
+        }
+        input = held;
+        if (firePressed) input |= starship::INPUT_FIRE;
+
+        // Catch up on the ticks that are due, but at most maxSubsteps; a
+        // longer stall is dropped rather than replayed in a burst
+        const Clock::time_point now = Clock::now();
+        int ticks = 0;
+        while (nextTick <= now && ticks < maxSubsteps) {
+            game.step(input);
+            nextTick += tickLength;
+            ++ticks;
+        }
+        if (nextTick <= now) nextTick = now + tickLength;
+
+        if (ticks > 0) {
+            recorder.record(input, ticks);
+            firePressed = false;
+            publish();
+        }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+void SimulationThread::publish() {
+    if (game.getTickCount() >= nextProfileTick) {
+        profile = starship::RenderSnapshot::summarizeProfile(game.getProfile());
+        nextProfileTick = game.getTickCount() + PROFILE_INTERVAL;
+    }
+    starship::RenderSnapshot& snapshot = snapshots.writeBuffer();
+    snapshot.capture(game);
+    snapshot.profile = profile;
+    snapshots.publish();
+}
@@ -0,0 +1,63 @@
+#ifndef STARSHIP_EXAMPLES_SIM_THREAD_HXX
+#define STARSHIP_EXAMPLES_SIM_THREAD_HXX
+
+#include "starship/game.hxx"
+#include "starship/input.hxx"
+#include "starship/render_snapshot.hxx"
+#include "starship/replay.hxx"
+#include "starship/spsc_queue.hxx"
+#include "starship/triple_buffer.hxx"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Runs a Game on its own thread at the game's fixed timestep, so a slow
+// frame cannot stretch a tick and a slow tick cannot hold up a frame.
+//
+// The render thread talks to it only through lock-free structures: input
+// masks go in through an SPSC queue, and after every batch of ticks a
+// RenderSnapshot comes out through a triple buffer. The game itself must
+// not be touched between start() and stop().
+class SimulationThread {
+public:
+    SimulationThread(starship::Game& game, starship::InputRecorder& recorder);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    // Waits for the current tick to finish; the game is then safe to read
+    void stop();
+
+    // Render thread: the control state from now on. INPUT_FIRE is latched
+    // until a tick consumes it, so a tap between ticks is not lost.
+    // Returns false if the queue is full.
+    bool sendInput(starship::InputMask input) { return inputs.tryPush(input); }
+
+    // Render thread: the snapshots published after each batch of ticks
+    starship::TripleBuffer<starship::RenderSnapshot>& getSnapshots() { return snapshots; }
+
+    float getTimestep() const { return timestep; }
+
+private:
+    starship::Game& game;
+    starship::InputRecorder& recorder;
+    const float timestep;
+
+    starship::SpscQueue<starship::InputMask, 64> inputs;
+    starship::TripleBuffer<starship::RenderSnapshot> snapshots;
+
+    // Refreshed every PROFILE_INTERVAL ticks and copied into each snapshot
+    std::array<starship::RenderSnapshot::PhaseSummary, starship::TICK_PHASE_COUNT> profile;
+    std::uint64_t nextProfileTick;
+
+    std::atomic<bool> running;
+    std::thread thread;
+
+    void run();
+    void publish();
+};
+
+#endif // STARSHIP_EXAMPLES_SIM_THREAD_HXX
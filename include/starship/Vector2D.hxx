@@ -39,6 +39,11 @@ struct Vector2D {
         return std::sqrt(x * x + y * y);
     }
 
+    // Squared length, avoids the sqrt for comparisons
+    float lengthSquared() const {
+        return x * x + y * y;
+    }
+
     // Normalize the vector
     Vector2D normalized() const {
         float len = length();
@@ -52,6 +57,11 @@ struct Vector2D {
     static float distance(const Vector2D& a, const Vector2D& b) {
         return (b - a).length();
     }
+
+    // Squared distance between two points
+    static float distanceSquared(const Vector2D& a, const Vector2D& b) {
+        return (b - a).lengthSquared();
+    }
 };
 
 } // namespace starship
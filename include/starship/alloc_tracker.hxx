@@ -0,0 +1,99 @@
+#ifndef STARSHIP_ALLOC_TRACKER_HXX
+#define STARSHIP_ALLOC_TRACKER_HXX
+
+#include "tick_profiler.hxx"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace starship {
+
+// Heap activity over some span
+struct AllocationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t frees = 0;
+    std::uint64_t bytes = 0;   // Requested by the allocations
+
+    AllocationCounters& operator+=(const AllocationCounters& other) {
+        allocations += other.allocations;
+        frees += other.frees;
+        bytes += other.bytes;
+        return *this;
+    }
+    AllocationCounters operator-(const AllocationCounters& other) const {
+        return AllocationCounters{allocations - other.allocations, frees - other.frees, bytes - other.bytes};
+    }
+};
+
+// Heap activity of one tick on the thread that ran it, split by the tick
+// phase that was active. `total` also covers untagged allocations.
+struct TickAllocations {
+    AllocationCounters total;
+    std::array<AllocationCounters, TICK_PHASE_COUNT> phases;
+    std::uint64_t peakLiveBytes = 0;   // Process-wide high-water mark during the tick
+
+    const AllocationCounters& operator[](TickPhase phase) const {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+};
+
+// Opt-in heap accounting. Nothing is counted unless the program links the
+// starship_alloc_hooks CMake target, which replaces the global operator
+// new and delete. Counting is per thread, so work a ThreadPool worker does
+// for a tick is not attributed to it.
+namespace alloc {
+
+// Whether the hooks are linked in
+bool isTracking();
+
+// Everything this thread has allocated so far, split by phase
+TickAllocations threadCounters();
+// What this thread allocated since `start` (from threadCounters()); the
+// peak is process-wide since the last resetPeak()
+TickAllocations since(const TickAllocations& start);
+
+// Process-wide bytes currently allocated, and the most since resetPeak()
+std::uint64_t getLiveBytes();
+std::uint64_t getPeakLiveBytes();
+void resetPeak();
+
+// Tags this thread's allocations with a tick phase for its lifetime
+class PhaseScope {
+public:
+    explicit PhaseScope(TickPhase phase);
+    ~PhaseScope();
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    std::uint8_t previous;
+};
+
+// Called with the size of an allocation made while a Trap is active
+using TrapHandler = void (*)(std::size_t bytes);
+
+// Default handler: reports the size on stderr and aborts, so a debugger
+// stops at the offending call
+void setTrapHandler(TrapHandler handler);
+
+// Zero-allocation guard: while one is alive, every allocation on this
+// thread calls the trap handler. Has no effect without the hooks.
+class Trap {
+public:
+    Trap();
+    ~Trap();
+    Trap(const Trap&) = delete;
+    Trap& operator=(const Trap&) = delete;
+};
+
+namespace detail {
+// Called by the hooks
+void installed();
+void onAllocate(std::size_t bytes);
+void onFree(std::size_t bytes);
+} // namespace detail
+
+} // namespace alloc
+} // namespace starship
+
+#endif // STARSHIP_ALLOC_TRACKER_HXX
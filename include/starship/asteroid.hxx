@@ -2,9 +2,12 @@
 #define ASTEROID_HXX
 
 #include "entity.hxx"
-#include <vector>
+#include "game_config.hxx"
+#include "shape_library.hxx"
+#include "random.hxx"
+#include <cstdint>
 #include <random>
-#include <cmath>
+#include <type_traits>
 
 namespace starship {
 
@@ -20,10 +23,26 @@ private:
     Size size;
     float rotationSpeed;
     float rotation;
-    std::vector<Vector2D> shapePoints;
+    std::uint16_t shapeVariant;  // Index into AsteroidShapeLibrary
 
-    static constexpr float PI = 3.14159265358979323846f;
+public:
+    // Default constructor - places asteroid near center with default velocity
+    Asteroid()
+        : Entity(Vector2D(400.0f, 300.0f), getRadiusForSize(Size::LARGE)),
+          size(Size::LARGE), rotationSpeed(45.0f), rotation(0.0f), shapeVariant(0) {
+        velocity = Vector2D(50.0f, 50.0f);
+    }
 
+    Asteroid(const Vector2D& pos, const Vector2D& vel, Size s, std::mt19937& rng)
+        : Entity(pos, getRadiusForSize(s)),
+          size(s),
+          rotationSpeed(getRandomRotationSpeed(rng)),
+          rotation(std::uniform_real_distribution<float>(0.0f, 360.0f)(rng)),
+          shapeVariant(getRandomShapeVariant(rng)) {
+        velocity = vel;
+    }
+
+    // Random spin used for new asteroids
     static float getRandomRotationSpeed(std::mt19937& rng) {
         std::uniform_real_distribution<float> speedDist(20.0f, 60.0f);
         float speed = speedDist(rng);
@@ -33,68 +52,42 @@ private:
         return speed;
     }
 
-    static std::vector<Vector2D> generateShape(Size s, std::mt19937& rng) {
-        int vertexCount;
-        switch (s) {
-            case Size::LARGE:  vertexCount = 10; break;
-            case Size::MEDIUM: vertexCount = 8; break;
-            case Size::SMALL:  vertexCount = 6; break;
-            default:           vertexCount = 8; break;
-        }
+    // Which shared outline a new asteroid uses
+    static std::uint16_t getRandomShapeVariant(std::mt19937& rng) {
+        std::uniform_int_distribution<int> variantDist(0, AsteroidShapeLibrary::VARIANTS_PER_SIZE - 1);
+        return static_cast<std::uint16_t>(variantDist(rng));
+    }
 
-        float baseRadius = getRadiusForSize(s);
-        std::uniform_real_distribution<float> jitter(0.65f, 1.15f);
+    // The same two draws from a counter-based stream, as Game makes them
+    static float getRandomRotationSpeed(RandomStream& random) {
+        float speed = random.uniform(20.0f, 60.0f);
+        return random.uniformInt(0, 1) == 0 ? -speed : speed;
+    }
 
-        std::vector<Vector2D> shape;
-        shape.reserve(vertexCount);
-        for (int i = 0; i < vertexCount; ++i) {
-            float angle = 2.0f * PI * i / vertexCount;
-            float radius = baseRadius * jitter(rng);
-            shape.emplace_back(std::cos(angle) * radius, std::sin(angle) * radius);
-        }
-        return shape;
+    static std::uint16_t getRandomShapeVariant(RandomStream& random) {
+        return static_cast<std::uint16_t>(random.uniformInt(0, AsteroidShapeLibrary::VARIANTS_PER_SIZE - 1));
     }
 
-public:
-    // Default constructor - places asteroid near center with default velocity
-    Asteroid()
-        : Entity(Vector2D(400.0f, 300.0f), getRadiusForSize(Size::LARGE)),
-          size(Size::LARGE), rotationSpeed(45.0f), rotation(0.0f),
-          shapePoints({
-              { -18.0f, -5.0f }, { -12.0f, 10.0f }, { 0.0f, 18.0f },
-              { 12.0f, 12.0f }, { 18.0f, 0.0f }, { 10.0f, -12.0f },
-              { -8.0f, -18.0f }
-          }) {
-        velocity = Vector2D(50.0f, 50.0f);
+    // Get radius based on size
+    static constexpr float getRadiusForSize(Size s) {
+        return DefaultGameConfig::ASTEROID_RADIUS[static_cast<std::size_t>(s)];
     }
 
-    Asteroid(const Vector2D& pos, const Vector2D& vel, Size s, std::mt19937& rng)
-        : Entity(pos, getRadiusForSize(s)),
-          size(s),
-          rotationSpeed(getRandomRotationSpeed(rng)),
-          rotation(std::uniform_real_distribution<float>(0.0f, 360.0f)(rng)),
-          shapePoints(generateShape(s, rng)) {
-        velocity = vel;
+    // Points awarded for destroying an asteroid of the given size
+    static constexpr int getPointsForSize(Size s) {
+        return DefaultGameConfig::ASTEROID_POINTS[static_cast<std::size_t>(s)];
     }
 
-    // Get radius based on size
-    static float getRadiusForSize(Size s) {
-        switch (s) {
-            case Size::LARGE:  return 20.0f;
-            case Size::MEDIUM: return 12.0f;
-            case Size::SMALL:  return 6.0f;
-            default:           return 20.0f;
-        }
+    // Size of the fragments an asteroid splits into
+    static constexpr Size getNextSizeFor(Size s) {
+        if (s == Size::LARGE) return Size::MEDIUM;
+        if (s == Size::MEDIUM) return Size::SMALL;
+        return Size::SMALL;
     }
 
     // Points awarded for destroying this asteroid
     int getPoints() const {
-        switch (size) {
-            case Size::LARGE:  return 20;
-            case Size::MEDIUM: return 50;
-            case Size::SMALL:  return 100;
-            default:           return 0;
-        }
+        return getPointsForSize(size);
     }
 
     bool canSplit() const {
@@ -102,19 +95,23 @@ public:
     }
 
     Size getNextSize() const {
-        if (size == Size::LARGE) return Size::MEDIUM;
-        if (size == Size::MEDIUM) return Size::SMALL;
-        return Size::SMALL;
+        return getNextSizeFor(size);
     }
 
+    Size getSize() const { return size; }
+    float getRotationSpeed() const { return rotationSpeed; }
+
     // Getters for position/velocity
     const Vector2D& getPosition() const { return position; }
     const Vector2D& getVelocity() const { return velocity; }
     float getRotation() const { return rotation; }
-    const std::vector<Vector2D>& getShape() const { return shapePoints; }
+    std::uint16_t getShapeVariant() const { return shapeVariant; }
+    ShapeView getShape() const {
+        return AsteroidShapeLibrary::shared().getShape(static_cast<int>(size), shapeVariant);
+    }
 
     // Update position with wrapping (screen bounds managed externally)
-    void update(float deltaTime) override {
+    void update(float deltaTime) {
         Entity::update(deltaTime);
         rotation += rotationSpeed * deltaTime;
         if (rotation >= 360.0f) rotation -= 360.0f;
@@ -122,6 +119,9 @@ public:
     }
 };
 
+static_assert(std::is_trivially_copyable<Asteroid>::value,
+              "Asteroid must stay a plain record");
+
 } // namespace starship
 
 #endif // ASTEROID_HXX
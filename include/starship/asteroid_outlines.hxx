@@ -0,0 +1,53 @@
+#ifndef STARSHIP_ASTEROID_OUTLINES_HXX
+#define STARSHIP_ASTEROID_OUTLINES_HXX
+
+#include "entity_store.hxx"
+#include "shape_library.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+struct RenderSnapshot;
+
+// World-space outlines of every asteroid, packed back to back in one
+// buffer. Outline i occupies points [offsets[i], offsets[i + 1]) and
+// lines up with index i of the asteroid columns. Points are x,y float
+// pairs, so a frontend can pass them straight to a draw call.
+//
+// Rotation is resolved once per asteroid with a batched sin/cos, and
+// every vertex is transformed exactly once.
+class AsteroidOutlines {
+public:
+    // Recompute from the current columns; keeps buffer capacity
+    void build(const AsteroidColumns& asteroids);
+    // Same for the asteroids of a snapshot, with outlines from `shapes`
+    // (seeded from the snapshot's shapeSeed)
+    void build(const RenderSnapshot& snapshot, const AsteroidShapeLibrary& shapes);
+
+    std::size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    bool empty() const { return size() == 0; }
+
+    // Outline of asteroid i
+    ShapeView operator[](std::size_t i) const {
+        return ShapeView{points.data() + offsets[i], offsets[i + 1] - offsets[i]};
+    }
+
+    // Whole buffer, for a single submission
+    const Vector2D* data() const { return points.data(); }
+    std::size_t pointCount() const { return points.size(); }
+    // size() + 1 entries; the last one is pointCount()
+    const std::vector<std::uint32_t>& getOffsets() const { return offsets; }
+
+private:
+    std::vector<Vector2D> points;
+    std::vector<std::uint32_t> offsets;
+    std::vector<float> rotations;
+    std::vector<float> sines;
+    std::vector<float> cosines;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_ASTEROID_OUTLINES_HXX
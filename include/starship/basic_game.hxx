@@ -0,0 +1,417 @@
+#ifndef STARSHIP_BASIC_GAME_HXX
+#define STARSHIP_BASIC_GAME_HXX
+
+#include "starship.hxx"
+#include "asteroid.hxx"
+#include "powerup.hxx"
+#include "projectile.hxx"
+#include "fixed_store.hxx"
+#include "command_buffer.hxx"
+#include "collision_math.hxx"
+#include "game_config.hxx"
+#include "input.hxx"
+#include "random.hxx"
+#include "simd_kernels.hxx"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace starship {
+
+// Heap-free variant of Game for constrained builds. World size, entity
+// capacities and every tuning constant come from `Config` (see
+// game_config.hxx) at compile time, and all storage is inline, so a
+// BasicGame can live on the stack or in static memory and never calls
+// operator new.
+//
+// The rules are Game's, with circle collisions and no thread pool,
+// profiler or handles. Entity order and random keys match Game's, so with
+// DefaultGameConfig and the same seed and inputs both play out the same
+// way for as long as no capacity is reached. Once a store is full, further
+// spawns of that kind are dropped (they still use up their spawn serial).
+template <typename Config = DefaultGameConfig>
+class BasicGame {
+public:
+    static constexpr float WIDTH = Config::WIDTH;
+    static constexpr float HEIGHT = Config::HEIGHT;
+    static constexpr float DEFAULT_TIMESTEP = 1.0f / 60.0f;
+
+    using AsteroidStore = FixedAsteroidColumns<Config::MAX_ASTEROIDS>;
+    using ProjectileStore = FixedProjectileColumns<Config::MAX_PROJECTILES>;
+    using PowerUpStore = FixedPowerUpColumns<Config::MAX_POWERUPS>;
+
+    static constexpr float radiusFor(Asteroid::Size size) {
+        return Config::ASTEROID_RADIUS[static_cast<std::size_t>(size)];
+    }
+    static constexpr int pointsFor(Asteroid::Size size) {
+        return Config::ASTEROID_POINTS[static_cast<std::size_t>(size)];
+    }
+
+    explicit BasicGame(std::uint32_t seed)
+        : player(Vector2D(WIDTH / 2, HEIGHT / 2)),
+          seed(seed) {
+        asteroids.shapeLibrary.setRadii(Config::ASTEROID_RADIUS);
+        asteroids.shapeLibrary.setSeed(randomStream(RandomPurpose::SHAPES, 0).nextU32());
+        spawnAsteroids(Config::INITIAL_ASTEROIDS);
+    }
+
+    // Apply one tick's worth of input; see Game::applyInput
+    void applyInput(InputMask input, float deltaTime) {
+        if (gameOver) {
+            if (input & INPUT_RESTART) {
+                reset();
+            }
+            return;
+        }
+
+        const float boost = hasSpeedBoost() ? Config::SPEED_BOOST_MULTIPLIER : 1.0f;
+        if (input & INPUT_LEFT) {
+            player.moveLeft(Config::PLAYER_SPEED * boost);
+        } else if (input & INPUT_RIGHT) {
+            player.moveRight(Config::PLAYER_SPEED * boost);
+        } else {
+            player.stopMoving();
+        }
+        if (input & INPUT_THRUST) {
+            player.thrust(deltaTime, boost);
+        }
+        if ((input & INPUT_FIRE) && shootCooldown <= 0) {
+            shootProjectile();
+            shootCooldown = hasRapidFire() ? Config::SHOOT_DELAY * Config::RAPID_FIRE_DELAY_SCALE
+                                           : Config::SHOOT_DELAY;
+        }
+    }
+
+    void update(float deltaTime) {
+        if (gameOver) return;
+
+        if (shootCooldown > 0) {
+            shootCooldown -= deltaTime;
+        }
+
+        if (player.isActive()) {
+            player.update(deltaTime);
+            player.applyDrag(deltaTime);
+            player.applyBoundaries(WIDTH, HEIGHT);
+        }
+
+        integrate(deltaTime);
+
+        if (shieldTimer > 0) shieldTimer -= deltaTime;
+        if (multiShotTimer > 0) multiShotTimer -= deltaTime;
+        if (rapidFireTimer > 0) rapidFireTimer -= deltaTime;
+        if (speedBoostTimer > 0) speedBoostTimer -= deltaTime;
+
+        checkCollisions(deltaTime);
+
+        asteroids.compact();
+        projectiles.compact();
+        powerUps.compact();
+
+        spawnTimer += deltaTime;
+        if (spawnTimer >= Config::SPAWN_INTERVAL) {
+            spawnTimer = 0.0f;
+            spawnAsteroids(1 + (level / 3));
+        }
+
+        if (asteroids.empty() && player.isActive()) {
+            level++;
+            spawnAsteroids(6 + level * 2);
+        }
+
+        if (!player.isActive() && player.getHealth() <= 0) {
+            gameOver = true;
+        }
+    }
+
+    // Run exactly one fixed tick: applyInput then update
+    void step(InputMask input, float timestep = DEFAULT_TIMESTEP) {
+        applyInput(input, timestep);
+        update(timestep);
+        ++tickCount;
+    }
+
+    // Start a new round. The RNG carries on from the previous round.
+    void reset() {
+        player = Starship(Vector2D(WIDTH / 2, HEIGHT / 2));
+        asteroids.clear();
+        projectiles.clear();
+        powerUps.clear();
+        score = 0;
+        level = 1;
+        shootCooldown = 0.0f;
+        spawnTimer = 0.0f;
+        shieldTimer = 0.0f;
+        multiShotTimer = 0.0f;
+        rapidFireTimer = 0.0f;
+        speedBoostTimer = 0.0f;
+        gameOver = false;
+        spawnAsteroids(Config::INITIAL_ASTEROIDS);
+    }
+
+    // Start over exactly as BasicGame(seed) would
+    void reset(std::uint32_t newSeed) {
+        seed = newSeed;
+        randomTick = 0;
+        spawnSerial = 0;
+        asteroids.shapeLibrary.setSeed(randomStream(RandomPurpose::SHAPES, 0).nextU32());
+        tickCount = 0;
+        reset();
+    }
+
+    void spawnAsteroids(int count) {
+        for (int i = 0; i < count; i++) {
+            const std::uint32_t id = spawnSerial++;
+            RandomStream random = randomStream(RandomPurpose::WAVE, id);
+            Vector2D pos(random.uniform(0.0f, WIDTH), -20.0f);
+            float speed = random.uniform(10.0f, 30.0f);
+            float horizontalAngle = random.uniform(-0.2f, 0.2f);
+            Vector2D vel(std::sin(horizontalAngle) * speed, speed);
+            RandomStream look = randomStream(RandomPurpose::ASTEROID, id);
+            pushAsteroid(rollAsteroid(pos, vel, Asteroid::Size::LARGE, look));
+        }
+    }
+
+    void shootProjectile() {
+        if (!player.isActive()) return;
+
+        const Vector2D pos = player.getPosition();
+        if (multiShotTimer > 0) {
+            projectiles.push(pos, Vector2D(-Config::MULTI_SHOT_SPREAD, -Config::PROJECTILE_SPEED));
+            projectiles.push(pos, Vector2D(0.0f, -Config::PROJECTILE_SPEED));
+            projectiles.push(pos, Vector2D(Config::MULTI_SHOT_SPREAD, -Config::PROJECTILE_SPEED));
+        } else {
+            projectiles.push(pos, Vector2D(0.0f, -Config::PROJECTILE_SPEED));
+        }
+    }
+
+    void applyPowerUp(PowerUp::Type type) {
+        switch (type) {
+            case PowerUp::Type::SHIELD:
+                shieldTimer = Config::EFFECT_DURATION;
+                break;
+            case PowerUp::Type::MULTI_SHOT:
+                multiShotTimer = Config::EFFECT_DURATION;
+                break;
+            case PowerUp::Type::RAPID_FIRE:
+                rapidFireTimer = Config::EFFECT_DURATION;
+                break;
+            case PowerUp::Type::SPEED_BOOST:
+                speedBoostTimer = Config::SPEED_BOOST_DURATION;
+                break;
+            case PowerUp::Type::EXTRA_LIFE:
+                if (player.getHealth() < Config::MAX_HEALTH) {
+                    player.restoreHealth();
+                }
+                break;
+        }
+    }
+
+    const Starship& getPlayer() const { return player; }
+    Starship& getPlayer() { return player; }
+    // Stores cover every slot; check isActive() before drawing an entry
+    const AsteroidStore& getAsteroids() const { return asteroids; }
+    const ProjectileStore& getProjectiles() const { return projectiles; }
+    const PowerUpStore& getPowerUps() const { return powerUps; }
+
+    int getScore() const { return score; }
+    int getLevel() const { return level; }
+    bool isGameOver() const { return gameOver; }
+    std::uint64_t getTickCount() const { return tickCount; }
+    std::uint32_t getSeed() const { return seed; }
+
+    bool isShielded() const { return shieldTimer > 0; }
+    bool hasMultiShot() const { return multiShotTimer > 0; }
+    bool hasRapidFire() const { return rapidFireTimer > 0; }
+    bool hasSpeedBoost() const { return speedBoostTimer > 0; }
+
+private:
+    static constexpr std::uint32_t NO_HIT = 0xFFFFFFFFu;
+
+    Starship player;
+    AsteroidStore asteroids;
+    ProjectileStore projectiles;
+    PowerUpStore powerUps;
+
+    int score = 0;
+    int level = 1;
+    std::uint32_t seed;
+    // Random keys, as in Game
+    std::uint64_t randomTick = 0;
+    std::uint32_t spawnSerial = 0;
+
+    float shootCooldown = 0.0f;
+    float spawnTimer = 0.0f;
+    float shieldTimer = 0.0f;
+    float multiShotTimer = 0.0f;
+    float rapidFireTimer = 0.0f;
+    float speedBoostTimer = 0.0f;
+    bool gameOver = false;
+    std::uint64_t tickCount = 0;
+
+    // Collision scratch, sized for the worst case. Each hit takes one
+    // projectile, and each hit splits into at most two fragments.
+    std::array<std::uint8_t, Config::MAX_ASTEROIDS> asteroidClaimed;
+    std::array<CommandBuffer::Hit, Config::MAX_PROJECTILES> hits;
+    std::array<CommandBuffer::AsteroidSpawn, 2 * Config::MAX_PROJECTILES> fragments;
+
+    RandomStream randomStream(RandomPurpose purpose, std::uint32_t id) const {
+        return RandomStream(seed, randomTick, id, purpose);
+    }
+
+    void pushAsteroid(const CommandBuffer::AsteroidSpawn& spawn) {
+        asteroids.push(spawn.position, spawn.velocity, spawn.size, radiusFor(spawn.size),
+                       spawn.rotation, spawn.rotationSpeed, spawn.shapeVariant);
+    }
+
+    void integrate(float deltaTime) {
+        const simd::Kernels& kernels = simd::activeKernels();
+
+        std::size_t count = asteroids.size();
+        kernels.integrate(asteroids.x.data(), asteroids.y.data(),
+                          asteroids.vx.data(), asteroids.vy.data(), count, deltaTime);
+        kernels.advanceRotation(asteroids.rotation.data(), asteroids.rotationSpeed.data(), count, deltaTime);
+        kernels.clearFlagAbove(asteroids.y.data(), asteroids.flags.data(), count, HEIGHT + 50, ENTITY_ACTIVE);
+
+        count = projectiles.size();
+        kernels.integrate(projectiles.x.data(), projectiles.y.data(),
+                          projectiles.vx.data(), projectiles.vy.data(), count, deltaTime);
+        kernels.advanceTimers(projectiles.lifetime.data(), count, deltaTime);
+        kernels.clearFlagAbove(projectiles.lifetime.data(), projectiles.flags.data(), count,
+                               Projectile::MAX_LIFETIME, ENTITY_ACTIVE);
+        kernels.clearFlagBelow(projectiles.y.data(), projectiles.flags.data(), count, -10, ENTITY_ACTIVE);
+
+        count = powerUps.size();
+        kernels.integrate(powerUps.x.data(), powerUps.y.data(),
+                          powerUps.vx.data(), powerUps.vy.data(), count, deltaTime);
+        kernels.advanceTimers(powerUps.lifetime.data(), count, deltaTime);
+        for (std::size_t i = 0; i < count; ++i) {
+            float& x = powerUps.x[i];
+            float& y = powerUps.y[i];
+            if (x < 0) x += WIDTH;
+            if (x > WIDTH) x -= WIDTH;
+            if (y < 0) y += HEIGHT;
+            if (y > HEIGHT) y -= HEIGHT;
+        }
+        kernels.clearFlagAbove(powerUps.lifetime.data(), powerUps.flags.data(), count,
+                               PowerUp::MAX_LIFETIME, ENTITY_ACTIVE);
+        kernels.clearFlagAbove(powerUps.y.data(), powerUps.flags.data(), count, HEIGHT + 50, ENTITY_ACTIVE);
+    }
+
+    bool available(std::size_t i) const {
+        return asteroids.isActive(i) && !asteroidClaimed[i];
+    }
+
+    // Lowest-index available asteroid touching the circle
+    std::uint32_t firstHit(const Vector2D& pos, float radius, std::size_t indexedCount) const {
+        for (std::size_t i = 0; i < indexedCount; ++i) {
+            if (!available(i)) continue;
+            float dx = asteroids.x[i] - pos.x;
+            float dy = asteroids.y[i] - pos.y;
+            float reach = radius + asteroids.radius[i];
+            if (dx * dx + dy * dy < reach * reach) return static_cast<std::uint32_t>(i);
+        }
+        return NO_HIT;
+    }
+
+    // Earliest swept impact along projectile p's path over the step, in
+    // each asteroid's frame; ties go to the lower index
+    std::uint32_t firstImpact(std::size_t p, float deltaTime, std::size_t indexedCount) const {
+        const Vector2D pos = projectiles.position(p);
+        std::uint32_t hit = NO_HIT;
+        float hitTime = NO_IMPACT;
+        for (std::size_t i = 0; i < indexedCount; ++i) {
+            if (!available(i)) continue;
+            const Vector2D travel((projectiles.vx[p] - asteroids.vx[i]) * deltaTime,
+                                  (projectiles.vy[p] - asteroids.vy[i]) * deltaTime);
+            float t = sweptCircleTime(pos - travel, travel, asteroids.position(i),
+                                      projectiles.radius[p] + asteroids.radius[i]);
+            if (t < hitTime) {
+                hitTime = t;
+                hit = static_cast<std::uint32_t>(i);
+            }
+        }
+        return hit;
+    }
+
+    // Detection, then every effect applied in one pass, as in Game
+    void checkCollisions(float deltaTime) {
+        ++randomTick;
+        const std::size_t indexedCount = asteroids.size();
+        for (std::size_t i = 0; i < indexedCount; ++i) asteroidClaimed[i] = 0;
+
+        // Each asteroid goes to the first projectile that reaches it
+        std::size_t hitCount = 0;
+        for (std::size_t p = 0; p < projectiles.size(); ++p) {
+            if (!projectiles.isActive(p)) continue;
+            std::uint32_t hit = firstImpact(p, deltaTime, indexedCount);
+            if (hit == NO_HIT) continue;
+            asteroidClaimed[hit] = 1;
+            hits[hitCount++] = CommandBuffer::Hit{static_cast<std::uint32_t>(p), hit};
+        }
+
+        std::uint32_t pickup = NO_HIT;
+        bool shielded = isShielded();
+        if (player.isActive()) {
+            const Vector2D playerPos = player.getPosition();
+            for (std::size_t i = 0; i < powerUps.size(); ++i) {
+                if (!powerUps.isActive(i)) continue;
+                float dx = powerUps.x[i] - playerPos.x;
+                float dy = powerUps.y[i] - playerPos.y;
+                float reach = player.getRadius() + powerUps.radius[i];
+                if (dx * dx + dy * dy < reach * reach) {
+                    pickup = static_cast<std::uint32_t>(i);
+                    shielded = shielded || powerUps.types[i] == PowerUp::Type::SHIELD;
+                    break;
+                }
+            }
+        }
+
+        std::uint32_t playerHitBy = NO_HIT;
+        if (player.isActive() && !shielded) {
+            playerHitBy = firstHit(player.getPosition(), player.getRadius(), indexedCount);
+        }
+
+        for (std::size_t h = 0; h < hitCount; ++h) {
+            projectiles.setActive(hits[h].projectile, false);
+            asteroids.setActive(hits[h].asteroid, false);
+            score += pointsFor(asteroids.sizes[hits[h].asteroid]);
+        }
+
+        // Same keys as Game::applyCommands, resolved serially
+        std::size_t fragmentCount = 0;
+        for (std::size_t h = 0; h < hitCount; ++h) {
+            const std::uint32_t a = hits[h].asteroid;
+            CommandBuffer::Outcome outcome;
+            RandomStream drop = randomStream(RandomPurpose::DROP, static_cast<std::uint32_t>(h));
+            RandomStream split = randomStream(RandomPurpose::SPLIT, static_cast<std::uint32_t>(h));
+            rollHit(asteroids.position(a), asteroids.velocity(a), asteroids.sizes[a], Config::POWERUP_DROP_CHANCE,
+                    drop, split, outcome, fragments.data() + fragmentCount);
+            if (outcome.dropped) {
+                powerUps.push(outcome.dropPosition, Vector2D(outcome.dropDrift, 80.0f), outcome.dropType);
+            }
+            if (asteroids.sizes[a] != Asteroid::Size::SMALL) fragmentCount += 2;
+        }
+        for (std::size_t f = 0; f < fragmentCount; ++f) {
+            pushAsteroid(fragments[f]);
+        }
+
+        if (pickup != NO_HIT) {
+            powerUps.setActive(pickup, false);
+            applyPowerUp(powerUps.types[pickup]);
+        }
+
+        if (playerHitBy != NO_HIT) {
+            player.takeDamage();
+            asteroids.setActive(playerHitBy, false);
+            if (player.getHealth() > 0) {
+                player.respawn(Vector2D(WIDTH / 2, HEIGHT / 2));
+            }
+        }
+    }
+};
+
+} // namespace starship
+
+#endif // STARSHIP_BASIC_GAME_HXX
@@ -0,0 +1,46 @@
+#ifndef STARSHIP_BOT_HXX
+#define STARSHIP_BOT_HXX
+
+#include "game.hxx"
+#include "input.hxx"
+#include <vector>
+
+namespace starship {
+
+// Scripted player for soak runs and demos. Each tick it looks at the
+// game through the spatial queries and picks the controls a careful
+// human would: dodge an asteroid that is about to land on the ship,
+// otherwise drift toward a nearby power-up or line up under the nearest
+// asteroid, and fire whenever something is straight above.
+//
+// Decisions depend only on the game state, so a run with a bot is as
+// reproducible as one with recorded input.
+class BotPlayer {
+public:
+    // How far ahead, in seconds, an asteroid's fall is checked for a hit
+    static constexpr float LOOKAHEAD = 1.2f;
+    // Clearance kept between the ship and a falling asteroid's edge
+    static constexpr float DODGE_MARGIN = 24.0f;
+    // Power-ups further than this are not worth chasing
+    static constexpr float PICKUP_RANGE = 220.0f;
+
+    // Controls for the next tick. After game over the bot asks for a
+    // restart when `restart` is set, and does nothing otherwise.
+    InputMask decide(const Game& game);
+
+    void setRestart(bool enabled) { restart = enabled; }
+
+private:
+    bool restart = true;
+
+    // Query results, kept to reuse their memory
+    std::vector<AsteroidHandle> asteroids;
+    std::vector<PowerUpHandle> powerUps;
+
+    // Move the ship toward x, or hold still once close enough
+    static InputMask steerTo(float shipX, float x);
+};
+
+} // namespace starship
+
+#endif // STARSHIP_BOT_HXX
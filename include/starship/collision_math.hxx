@@ -0,0 +1,31 @@
+#ifndef STARSHIP_COLLISION_MATH_HXX
+#define STARSHIP_COLLISION_MATH_HXX
+
+#include "Vector2D.hxx"
+#include <cmath>
+#include <limits>
+
+namespace starship {
+
+// Returned by the swept tests when there is no contact within the step
+constexpr float NO_IMPACT = std::numeric_limits<float>::infinity();
+
+// Fraction of `travel` after which a point starting at `start` comes
+// within `reach` of `center`: 0 if it starts inside, NO_IMPACT if never
+inline float sweptCircleTime(const Vector2D& start, const Vector2D& travel, const Vector2D& center, float reach) {
+    float fx = start.x - center.x;
+    float fy = start.y - center.y;
+    float c = fx * fx + fy * fy - reach * reach;
+    if (c < 0.0f) return 0.0f;
+    float a = travel.x * travel.x + travel.y * travel.y;
+    float halfB = fx * travel.x + fy * travel.y;
+    if (a <= 0.0f || halfB >= 0.0f) return NO_IMPACT;
+    float disc = halfB * halfB - a * c;
+    if (disc < 0.0f) return NO_IMPACT;
+    float t = (-halfB - std::sqrt(disc)) / a;
+    return t <= 1.0f ? t : NO_IMPACT;
+}
+
+} // namespace starship
+
+#endif // STARSHIP_COLLISION_MATH_HXX
@@ -0,0 +1,113 @@
+#ifndef STARSHIP_COMMAND_BUFFER_HXX
+#define STARSHIP_COMMAND_BUFFER_HXX
+
+#include "Vector2D.hxx"
+#include "asteroid.hxx"
+#include "powerup.hxx"
+#include "random.hxx"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+// Everything one collision pass decided, recorded during detection and
+// applied by Game afterwards in a single pass. Detection only reads the
+// entity stores, so nothing it holds can be invalidated under it.
+//
+// Entries are recorded in the order a serial scan would apply them:
+// hits by projectile index, then the player's pickup and damage. Each
+// hit's drop and split come from random streams keyed by its place in
+// that order (see random.hxx), so hits can be resolved in any order or
+// in parallel and still give the same result. The buffer is reused every
+// tick and keeps its capacity.
+struct CommandBuffer {
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    // Projectile destroyed asteroid; score, drop and split follow from it
+    struct Hit {
+        std::uint32_t projectile;
+        std::uint32_t asteroid;
+    };
+
+    // What a hit leaves behind: a power-up if `dropped`, and unless the
+    // asteroid was small, two fragments from asteroidSpawns[firstFragment]
+    struct Outcome {
+        Vector2D dropPosition;
+        float dropDrift;
+        PowerUp::Type dropType;
+        bool dropped;
+        std::uint32_t firstFragment;
+    };
+
+    // Fully rolled asteroid, ready to append
+    struct AsteroidSpawn {
+        Vector2D position;
+        Vector2D velocity;
+        Asteroid::Size size;
+        float rotation;
+        float rotationSpeed;
+        std::uint16_t shapeVariant;
+    };
+
+    std::vector<Hit> hits;
+    std::uint32_t pickup = NONE;          // Power-up the player touched
+    std::uint32_t playerHitBy = NONE;     // Asteroid that struck the player
+
+    // Filled while resolving hits, then appended in one batch: one
+    // outcome per hit, and the fragments of every split in hit order
+    std::vector<Outcome> outcomes;
+    std::vector<AsteroidSpawn> asteroidSpawns;
+
+    void clear() {
+        hits.clear();
+        pickup = NONE;
+        playerHitBy = NONE;
+        outcomes.clear();
+        asteroidSpawns.clear();
+    }
+
+    bool empty() const { return hits.empty() && pickup == NONE && playerHitBy == NONE; }
+};
+
+// A new asteroid's spin, angle and outline, in the Asteroid constructor's
+// draw order
+inline CommandBuffer::AsteroidSpawn rollAsteroid(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size,
+                                                 RandomStream& random) {
+    CommandBuffer::AsteroidSpawn spawn;
+    spawn.position = pos;
+    spawn.velocity = vel;
+    spawn.size = size;
+    spawn.rotationSpeed = Asteroid::getRandomRotationSpeed(random);
+    spawn.rotation = random.uniform(0.0f, 360.0f);
+    spawn.shapeVariant = Asteroid::getRandomShapeVariant(random);
+    return spawn;
+}
+
+// Roll what destroying an asteroid at (pos, vel) leaves behind into
+// `outcome` and, for a split, fragments[0] and fragments[1]. Reads nothing
+// but its arguments, so Game and BasicGame resolve hits the same way.
+inline void rollHit(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size, float dropChance,
+                    RandomStream& drop, RandomStream& split,
+                    CommandBuffer::Outcome& outcome, CommandBuffer::AsteroidSpawn* fragments) {
+    outcome.dropPosition = pos;
+    // All three come from one Philox block, so they are drawn either way
+    outcome.dropped = drop.nextFloat() < dropChance;
+    outcome.dropType = static_cast<PowerUp::Type>(drop.uniformInt(0, PowerUp::TYPE_COUNT - 1));
+    outcome.dropDrift = drop.uniform(-15.0f, 15.0f);
+
+    if (size == Asteroid::Size::SMALL) return;
+    const Asteroid::Size nextSize = Asteroid::getNextSizeFor(size);
+    const float heading = std::atan2(vel.y, vel.x);
+    const float speed = vel.length() * 1.2f;
+    for (int i = 0; i < 2; i++) {
+        float angle = heading + split.uniform(-0.5f, 0.5f);
+        Vector2D newVel(std::cos(angle) * speed, std::sin(angle) * speed);
+        fragments[i] = rollAsteroid(pos, newVel, nextSize, split);
+    }
+}
+
+} // namespace starship
+
+#endif // STARSHIP_COMMAND_BUFFER_HXX
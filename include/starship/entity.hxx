@@ -5,6 +5,8 @@
 
 namespace starship {
 
+// Plain (non-polymorphic) base for standalone entity objects. Game keeps
+// its entities in column stores and never dispatches through Entity.
 class Entity {
 protected:
     Vector2D position;
@@ -16,9 +18,7 @@ public:
     Entity(const Vector2D& pos, float radius)
         : position(pos), velocity(0, 0), radius(radius), active(true) {}
 
-    virtual ~Entity() = default;
-
-    virtual void update(float deltaTime) {
+    void update(float deltaTime) {
         position += velocity * deltaTime;
     }
 
@@ -35,8 +35,8 @@ public:
 
     // Collision detection
     bool collidesWith(const Entity& other) const {
-        float dist = Vector2D::distance(position, other.position);
-        return dist < (radius + other.radius);
+        float reach = radius + other.radius;
+        return Vector2D::distanceSquared(position, other.position) < reach * reach;
     }
 
     // Screen wrapping
@@ -0,0 +1,206 @@
+#ifndef STARSHIP_ENTITY_BVH_HXX
+#define STARSHIP_ENTITY_BVH_HXX
+
+#include "Vector2D.hxx"
+#include "entity_store.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+// Bounding volume hierarchy over the circles of one entity store, for
+// spatial queries that should not scan every entity: radius and box
+// searches, ray casts and k-nearest.
+//
+// Leaves hold slot indices into the columns, so the tree stays valid
+// only while the store keeps its slot layout. refresh() checks that: as
+// long as no entity was moved by compaction, it refits the existing
+// boxes to the new positions in one pass. Entities appended since the
+// build are kept in a short pending range that queries scan directly.
+// Compaction, too many pending entities, or a refit that has let the
+// boxes grow too loose (e.g. after a screen wrap) rebuild the tree.
+//
+// Every query takes the same columns the tree was refreshed from and
+// skips entities that have gone inactive since.
+class EntityBvh {
+public:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+    // Most entities in one leaf
+    static constexpr std::uint32_t LEAF_SIZE = 4;
+    // A refit whose summed box perimeters pass this multiple of the
+    // freshly built tree's is thrown away and rebuilt
+    static constexpr float REBUILD_RATIO = 2.0f;
+    // Appended entities are scanned until they pass LEAF_SIZE plus this
+    // fraction of the tree
+    static constexpr std::size_t PENDING_DIVISOR = 8;
+
+    struct RayHit {
+        std::uint32_t slot = NONE;
+        float distance = 0.0f;
+    };
+
+    struct Neighbor {
+        std::uint32_t slot;
+        float distanceSquared;
+    };
+
+    // The entities moved; the next refresh() brings the tree up to date
+    void invalidate() { stale = true; }
+    bool isStale() const { return stale; }
+
+    // Refit or rebuild after invalidate(); does nothing otherwise
+    void refresh(const BodyColumns& columns);
+
+    // Build from scratch over the active entities
+    void build(const BodyColumns& columns);
+
+    // Move the boxes to the entities' current positions. Returns false,
+    // leaving the tree to be rebuilt, if the slot layout changed or the
+    // result would be too loose.
+    bool refit(const BodyColumns& columns);
+
+    // Size the buffers for up to `count` entities
+    void reserve(std::size_t count);
+
+    // Entities indexed by the last build
+    std::size_t size() const { return items.size(); }
+    // Entities appended since, which queries scan
+    std::size_t getPendingCount() const { return pendingEnd - keptEnd; }
+    // How the tree has been brought up to date so far
+    std::uint64_t getBuildCount() const { return builds; }
+    std::uint64_t getRefitCount() const { return refits; }
+
+    // Visit the slot of every active entity whose circle overlaps the
+    // circle (center, range)
+    template <typename Fn>
+    void queryRadius(const BodyColumns& columns, const Vector2D& center, float range, Fn&& fn) const {
+        Box box{center.x - range, center.y - range, center.x + range, center.y + range};
+        visit(columns, box, [&](std::uint32_t slot) {
+            float reach = range + columns.radius[slot];
+            if (Vector2D::distanceSquared(center, columns.position(slot)) <= reach * reach) fn(slot);
+        });
+    }
+
+    // Visit the slot of every active entity whose circle overlaps the box
+    template <typename Fn>
+    void queryBox(const BodyColumns& columns, const Vector2D& min, const Vector2D& max, Fn&& fn) const {
+        Box box{min.x, min.y, max.x, max.y};
+        visit(columns, box, [&](std::uint32_t slot) {
+            if (box.distanceSquared(columns.x[slot], columns.y[slot]) <= columns.radius[slot] * columns.radius[slot]) {
+                fn(slot);
+            }
+        });
+    }
+
+    // First active entity whose circle the ray from `origin` along
+    // `direction` touches within `maxDistance`. A ray starting inside a
+    // circle hits it at distance 0. `direction` need not be unit length.
+    RayHit raycast(const BodyColumns& columns, const Vector2D& origin, const Vector2D& direction,
+                   float maxDistance) const;
+
+    // The `k` active entities whose centres lie closest to `point`,
+    // nearest first, ties broken by slot. `out` keeps its capacity.
+    void nearestK(const BodyColumns& columns, const Vector2D& point, std::size_t k,
+                  std::vector<Neighbor>& out) const;
+
+private:
+    struct Box {
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+
+        bool overlaps(const Box& o) const {
+            return minX <= o.maxX && o.minX <= maxX && minY <= o.maxY && o.minY <= maxY;
+        }
+        // Squared distance from a point to the box, 0 inside
+        float distanceSquared(float px, float py) const {
+            float dx = px < minX ? minX - px : (px > maxX ? px - maxX : 0.0f);
+            float dy = py < minY ? minY - py : (py > maxY ? py - maxY : 0.0f);
+            return dx * dx + dy * dy;
+        }
+        float perimeter() const {
+            return maxX < minX ? 0.0f : 2.0f * ((maxX - minX) + (maxY - minY));
+        }
+    };
+
+    // Nodes are laid out depth first: an inner node's left child follows
+    // it directly and `start` holds the right child. A leaf's entities
+    // are items[start, start + count).
+    struct Node {
+        Box box;
+        std::uint32_t start;
+        std::uint32_t count;
+
+        bool isLeaf() const { return count != 0; }
+    };
+
+    // Deep enough for any tree built by halving
+    static constexpr std::size_t STACK_DEPTH = 64;
+
+    // Centre of an entity while the tree is built
+    struct Centre {
+        float x;
+        float y;
+        std::uint32_t slot;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> items;
+    std::vector<Centre> centres;
+    // Handle id of every slot at the last build, to detect a new layout
+    std::vector<std::uint32_t> slotIds;
+    // Slots below keptEnd are those of the build that still exist; the
+    // ones from there to pendingEnd were appended since
+    std::uint32_t keptEnd = 0;
+    std::uint32_t pendingEnd = 0;
+    float builtPerimeter = 0.0f;
+    bool stale = true;
+    std::uint64_t builds = 0;
+    std::uint64_t refits = 0;
+
+    std::uint32_t buildNode(std::uint32_t begin, std::uint32_t end);
+    float fitNodes(const BodyColumns& columns);
+
+    // Whether a slot held by a leaf is still an active entity
+    bool isLive(const BodyColumns& columns, std::uint32_t slot) const {
+        return slot < keptEnd && columns.isActive(slot);
+    }
+
+    template <typename Fn>
+    void visit(const BodyColumns& columns, const Box& box, Fn&& fn) const {
+        for (std::uint32_t slot = keptEnd; slot < pendingEnd; ++slot) {
+            if (columns.isActive(slot)) fn(slot);
+        }
+        if (nodes.empty()) return;
+        std::uint32_t stack[STACK_DEPTH];
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const std::uint32_t index = stack[--top];
+            const Node& node = nodes[index];
+            if (!node.box.overlaps(box)) continue;
+            if (node.isLeaf()) {
+                for (std::uint32_t k = node.start; k < node.start + node.count; ++k) {
+                    if (isLive(columns, items[k])) fn(items[k]);
+                }
+            } else {
+                stack[top++] = node.start;
+                stack[top++] = index + 1;
+            }
+        }
+    }
+};
+
+// Result of Game::raycast
+template <typename Handle>
+struct RaycastHit {
+    Handle handle;
+    float distance = 0.0f;
+    Vector2D point;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_ENTITY_BVH_HXX
@@ -0,0 +1,357 @@
+#ifndef STARSHIP_ENTITY_STORE_HXX
+#define STARSHIP_ENTITY_STORE_HXX
+
+#include "Vector2D.hxx"
+#include "asteroid.hxx"
+#include "powerup.hxx"
+#include "projectile.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace starship {
+
+// Reads and writes the private pool state for snapshot.hxx
+struct SnapshotAccess;
+
+// Bits stored per entity in BodyColumns::flags
+enum EntityFlag : std::uint8_t {
+    ENTITY_ACTIVE = 1 << 0
+};
+
+// Stable reference to one entity of the store `Columns`. It survives
+// ticks and compaction, and goes stale once the entity is destroyed,
+// even if its id is later reused.
+template <typename Columns>
+struct EntityHandle {
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    std::uint32_t id = NONE;
+    std::uint32_t generation = 0;
+
+    bool isNull() const { return id == NONE; }
+    bool operator==(const EntityHandle& other) const {
+        return id == other.id && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// Maps handle ids to slots. Ids are recycled through a free list, and
+// each release bumps the id's generation so old handles stop matching.
+class HandleTable {
+public:
+    static constexpr std::uint32_t NO_SLOT = 0xFFFFFFFFu;
+
+    std::uint32_t acquire(std::uint32_t slot) {
+        std::uint32_t id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+            slots[id] = slot;
+        } else {
+            id = static_cast<std::uint32_t>(slots.size());
+            slots.push_back(slot);
+            generations.push_back(0);
+        }
+        return id;
+    }
+
+    void release(std::uint32_t id) {
+        slots[id] = NO_SLOT;
+        ++generations[id];
+        freeIds.push_back(id);
+    }
+
+    void move(std::uint32_t id, std::uint32_t slot) { slots[id] = slot; }
+
+    // Slot of a live id with a matching generation, otherwise NO_SLOT
+    std::uint32_t find(std::uint32_t id, std::uint32_t generation) const {
+        if (id >= slots.size() || generations[id] != generation) return NO_SLOT;
+        return slots[id];
+    }
+
+    std::uint32_t generationOf(std::uint32_t id) const { return generations[id]; }
+
+    void reserve(std::size_t n) {
+        slots.reserve(n);
+        generations.reserve(n);
+        freeIds.reserve(n);
+    }
+
+private:
+    friend struct SnapshotAccess;
+
+    std::vector<std::uint32_t> slots;
+    std::vector<std::uint32_t> generations;
+    std::vector<std::uint32_t> freeIds;
+};
+
+// Structure-of-arrays storage shared by every entity kind in Game.
+// Each attribute lives in its own contiguous column, so the per-tick
+// loops stream through memory without any virtual dispatch.
+//
+// The columns work as a pool. New entities are appended, and removing one
+// only releases its handle id and leaves a hole. Holes at the end are
+// dropped straight away. Interior holes stay, inactive, until they make up
+// more than 1 / COMPACT_DIVISOR of the slots; a stable compaction then
+// closes them. Between compactions, slot order is spawn order.
+struct BodyColumns {
+    static constexpr std::uint32_t NO_ID = HandleTable::NO_SLOT;
+    static constexpr std::size_t COMPACT_DIVISOR = 4;
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> radius;
+    std::vector<std::uint8_t> flags;
+    // Handle id of each slot; NO_ID for a hole
+    std::vector<std::uint32_t> ids;
+
+    HandleTable handles;
+
+    // Slots, holes included
+    std::size_t size() const { return flags.size(); }
+    bool empty() const { return flags.empty(); }
+    // Entities not yet released. Ones destroyed during the current tick
+    // still count until the end-of-tick release.
+    std::size_t liveCount() const { return flags.size() - holes; }
+    std::size_t holeCount() const { return holes; }
+
+    // Slot for a handle, or NO_ID if it is stale or destroyed
+    std::uint32_t find(std::uint32_t id, std::uint32_t generation) const {
+        std::uint32_t slot = handles.find(id, generation);
+        return slot != HandleTable::NO_SLOT && isActive(slot) ? slot : NO_ID;
+    }
+
+    bool isActive(std::size_t i) const { return (flags[i] & ENTITY_ACTIVE) != 0; }
+    void setActive(std::size_t i, bool state) {
+        if (state) {
+            flags[i] |= ENTITY_ACTIVE;
+        } else {
+            flags[i] &= static_cast<std::uint8_t>(~ENTITY_ACTIVE);
+        }
+    }
+
+    Vector2D position(std::size_t i) const { return Vector2D(x[i], y[i]); }
+    Vector2D velocity(std::size_t i) const { return Vector2D(vx[i], vy[i]); }
+    void setVelocity(std::size_t i, const Vector2D& vel) {
+        vx[i] = vel.x;
+        vy[i] = vel.y;
+    }
+
+protected:
+    friend struct SnapshotAccess;
+
+    std::size_t holes = 0;
+
+    std::uint32_t pushBody(const Vector2D& pos, const Vector2D& vel, float r) {
+        std::uint32_t id = handles.acquire(static_cast<std::uint32_t>(flags.size()));
+        x.push_back(pos.x);
+        y.push_back(pos.y);
+        vx.push_back(vel.x);
+        vy.push_back(vel.y);
+        radius.push_back(r);
+        flags.push_back(ENTITY_ACTIVE);
+        ids.push_back(id);
+        return id;
+    }
+
+    void reserveBody(std::size_t n) {
+        x.reserve(n);
+        y.reserve(n);
+        vx.reserve(n);
+        vy.reserve(n);
+        radius.reserve(n);
+        flags.reserve(n);
+        ids.reserve(n);
+        handles.reserve(n);
+    }
+
+    // Handles to the cleared entities go stale
+    void clearBody() {
+        for (std::uint32_t id : ids) {
+            if (id != NO_ID) handles.release(id);
+        }
+        x.clear();
+        y.clear();
+        vx.clear();
+        vy.clear();
+        radius.clear();
+        flags.clear();
+        ids.clear();
+        holes = 0;
+    }
+
+    // Release every inactive entry, trim trailing holes, and compact only
+    // if the holes left pass the threshold
+    template <typename... Extra>
+    void release(Extra&... extra) {
+        const std::size_t n = flags.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            if ((flags[i] & ENTITY_ACTIVE) || ids[i] == NO_ID) continue;
+            handles.release(ids[i]);
+            ids[i] = NO_ID;
+            // A hole keeps being integrated until trimmed or compacted, so park it
+            vx[i] = 0.0f;
+            vy[i] = 0.0f;
+            ++holes;
+        }
+
+        std::size_t end = n;
+        while (end > 0 && ids[end - 1] == NO_ID) --end;
+        if (end != n) {
+            holes -= n - end;
+            shrink(end, x, y, vx, vy, radius, flags, ids, extra...);
+        }
+
+        if (holes * COMPACT_DIVISOR > flags.size()) {
+            compact(extra...);
+        }
+    }
+
+    // Drop inactive entries from every column in one stable pass
+    template <typename... Extra>
+    void compact(Extra&... extra) {
+        std::size_t kept = 0;
+        const std::size_t n = flags.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!(flags[i] & ENTITY_ACTIVE)) {
+                if (ids[i] != NO_ID) handles.release(ids[i]);
+                continue;
+            }
+            if (kept != i) {
+                moveEntry(kept, i, x, y, vx, vy, radius, flags, ids, extra...);
+                handles.move(ids[kept], static_cast<std::uint32_t>(kept));
+            }
+            ++kept;
+        }
+        shrink(kept, x, y, vx, vy, radius, flags, ids, extra...);
+        holes = 0;
+    }
+
+private:
+    template <typename... Columns>
+    static void moveEntry(std::size_t to, std::size_t from, Columns&... columns) {
+        ((columns[to] = std::move(columns[from])), ...);
+    }
+
+    template <typename... Columns>
+    static void shrink(std::size_t n, Columns&... columns) {
+        (columns.erase(columns.begin() + static_cast<std::ptrdiff_t>(n), columns.end()), ...);
+    }
+};
+
+struct AsteroidColumns : BodyColumns {
+    using Handle = EntityHandle<AsteroidColumns>;
+
+    std::vector<float> rotation;
+    std::vector<float> rotationSpeed;
+    std::vector<Asteroid::Size> sizes;
+    std::vector<std::uint16_t> shapeVariants;
+
+    // Outlines the variants refer to; generated on first lookup
+    AsteroidShapeLibrary shapeLibrary;
+
+    std::uint32_t push(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size,
+                       float rot, float rotSpeed, std::uint16_t shapeVariant) {
+        rotation.push_back(rot);
+        rotationSpeed.push_back(rotSpeed);
+        sizes.push_back(size);
+        shapeVariants.push_back(shapeVariant);
+        return pushBody(pos, vel, Asteroid::getRadiusForSize(size));
+    }
+
+    ShapeView shape(std::size_t i) const {
+        return shapeLibrary.getShape(static_cast<int>(sizes[i]), shapeVariants[i]);
+    }
+
+    void reserve(std::size_t n) {
+        reserveBody(n);
+        rotation.reserve(n);
+        rotationSpeed.reserve(n);
+        sizes.reserve(n);
+        shapeVariants.reserve(n);
+    }
+
+    void clear() {
+        clearBody();
+        rotation.clear();
+        rotationSpeed.clear();
+        sizes.clear();
+        shapeVariants.clear();
+    }
+
+    void removeInactive() { compact(rotation, rotationSpeed, sizes, shapeVariants); }
+    void releaseInactive() { release(rotation, rotationSpeed, sizes, shapeVariants); }
+};
+
+struct ProjectileColumns : BodyColumns {
+    using Handle = EntityHandle<ProjectileColumns>;
+
+    // Tick on which Game's timer wheel retires the projectile
+    std::vector<std::uint64_t> expiresAt;
+
+    std::uint32_t push(const Vector2D& pos, const Vector2D& vel, std::uint64_t expiry) {
+        expiresAt.push_back(expiry);
+        return pushBody(pos, vel, Projectile::RADIUS);
+    }
+
+    void reserve(std::size_t n) {
+        reserveBody(n);
+        expiresAt.reserve(n);
+    }
+
+    void clear() {
+        clearBody();
+        expiresAt.clear();
+    }
+
+    void removeInactive() { compact(expiresAt); }
+    void releaseInactive() { release(expiresAt); }
+};
+
+struct PowerUpColumns : BodyColumns {
+    using Handle = EntityHandle<PowerUpColumns>;
+
+    // Ticks the power-up appeared on and is retired on
+    std::vector<std::uint64_t> spawnedAt;
+    std::vector<std::uint64_t> expiresAt;
+    std::vector<PowerUp::Type> types;
+
+    // Game's current tick, kept here for PowerUpRef::getLifetimeRatio
+    std::uint64_t now = 0;
+
+    std::uint32_t push(const Vector2D& pos, PowerUp::Type type, std::uint64_t expiry) {
+        spawnedAt.push_back(now);
+        expiresAt.push_back(expiry);
+        types.push_back(type);
+        return pushBody(pos, Vector2D(0, 0), PowerUp::RADIUS);
+    }
+
+    void reserve(std::size_t n) {
+        reserveBody(n);
+        spawnedAt.reserve(n);
+        expiresAt.reserve(n);
+        types.reserve(n);
+    }
+
+    void clear() {
+        clearBody();
+        spawnedAt.clear();
+        expiresAt.clear();
+        types.clear();
+    }
+
+    void removeInactive() { compact(spawnedAt, expiresAt, types); }
+    void releaseInactive() { release(spawnedAt, expiresAt, types); }
+};
+
+using AsteroidHandle = AsteroidColumns::Handle;
+using ProjectileHandle = ProjectileColumns::Handle;
+using PowerUpHandle = PowerUpColumns::Handle;
+
+} // namespace starship
+
+#endif // STARSHIP_ENTITY_STORE_HXX
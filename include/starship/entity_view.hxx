@@ -0,0 +1,167 @@
+#ifndef STARSHIP_ENTITY_VIEW_HXX
+#define STARSHIP_ENTITY_VIEW_HXX
+
+#include "entity_store.hxx"
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace starship {
+
+// Handle for the entity in slot `index`; null for a hole
+template <typename Columns>
+typename Columns::Handle handleAt(const Columns& columns, std::size_t index) {
+    typename Columns::Handle handle;
+    std::uint32_t id = columns.ids[index];
+    if (id != BodyColumns::NO_ID) {
+        handle.id = id;
+        handle.generation = columns.handles.generationOf(id);
+    }
+    return handle;
+}
+
+// Read-only handle to one asteroid stored in AsteroidColumns.
+// Mirrors the Asteroid getters so rendering code reads the same.
+class AsteroidRef {
+private:
+    const AsteroidColumns* columns;
+    std::size_t index;
+
+public:
+    AsteroidRef(const AsteroidColumns* columns, std::size_t index)
+        : columns(columns), index(index) {}
+
+    AsteroidColumns::Handle getHandle() const { return handleAt(*columns, index); }
+
+    Vector2D getPosition() const { return columns->position(index); }
+    Vector2D getVelocity() const { return columns->velocity(index); }
+    float getRadius() const { return columns->radius[index]; }
+    bool isActive() const { return columns->isActive(index); }
+
+    Asteroid::Size getSize() const { return columns->sizes[index]; }
+    float getRotation() const { return columns->rotation[index]; }
+    float getRotationSpeed() const { return columns->rotationSpeed[index]; }
+    std::uint16_t getShapeVariant() const { return columns->shapeVariants[index]; }
+    ShapeView getShape() const { return columns->shape(index); }
+
+    int getPoints() const { return Asteroid::getPointsForSize(getSize()); }
+    bool canSplit() const { return getSize() != Asteroid::Size::SMALL; }
+    Asteroid::Size getNextSize() const { return Asteroid::getNextSizeFor(getSize()); }
+};
+
+// Read-only handle to one projectile stored in ProjectileColumns
+class ProjectileRef {
+private:
+    const ProjectileColumns* columns;
+    std::size_t index;
+
+public:
+    ProjectileRef(const ProjectileColumns* columns, std::size_t index)
+        : columns(columns), index(index) {}
+
+    ProjectileColumns::Handle getHandle() const { return handleAt(*columns, index); }
+
+    Vector2D getPosition() const { return columns->position(index); }
+    Vector2D getVelocity() const { return columns->velocity(index); }
+    float getRadius() const { return columns->radius[index]; }
+    bool isActive() const { return columns->isActive(index); }
+};
+
+// Read-only handle to one power-up stored in PowerUpColumns
+class PowerUpRef {
+private:
+    const PowerUpColumns* columns;
+    std::size_t index;
+
+public:
+    PowerUpRef(const PowerUpColumns* columns, std::size_t index)
+        : columns(columns), index(index) {}
+
+    PowerUpColumns::Handle getHandle() const { return handleAt(*columns, index); }
+
+    Vector2D getPosition() const { return columns->position(index); }
+    Vector2D getVelocity() const { return columns->velocity(index); }
+    float getRadius() const { return columns->radius[index]; }
+    bool isActive() const { return columns->isActive(index); }
+
+    PowerUp::Type getType() const { return columns->types[index]; }
+    // Share of its time on screen used up, from 0 at spawn to 1 at expiry
+    float getLifetimeRatio() const {
+        const std::uint64_t total = columns->expiresAt[index] - columns->spawnedAt[index];
+        if (total == 0) return 1.0f;
+        return static_cast<float>(columns->now - columns->spawnedAt[index]) / static_cast<float>(total);
+    }
+    PowerUp::Color getColor() const { return PowerUp::getColorForType(getType()); }
+};
+
+// Indexable, iterable range over one column store. It holds a pointer to
+// the store rather than a copy, so a view kept across Game::update still
+// sees current values. The range covers every slot, so entries can be
+// inactive; check isActive() before drawing or counting one.
+template <typename Columns, typename Ref>
+class EntityView {
+private:
+    const Columns* columns;
+
+public:
+    class iterator {
+    private:
+        const Columns* columns;
+        std::size_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Ref;
+
+        iterator(const Columns* columns, std::size_t index)
+            : columns(columns), index(index) {}
+
+        Ref operator*() const { return Ref(columns, index); }
+        iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator old = *this;
+            ++index;
+            return old;
+        }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    explicit EntityView(const Columns* columns) : columns(columns) {}
+
+    std::size_t size() const { return columns->size(); }
+    bool empty() const { return columns->empty(); }
+    std::size_t liveCount() const { return columns->liveCount(); }
+    Ref operator[](std::size_t i) const { return Ref(columns, i); }
+    Ref front() const { return Ref(columns, 0); }
+    Ref back() const { return Ref(columns, columns->size() - 1); }
+
+    // Index of the entity a handle refers to, or npos if it is gone
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    std::size_t find(typename Columns::Handle handle) const {
+        if (handle.isNull()) return npos;
+        std::uint32_t slot = columns->find(handle.id, handle.generation);
+        return slot == BodyColumns::NO_ID ? npos : slot;
+    }
+    bool contains(typename Columns::Handle handle) const { return find(handle) != npos; }
+
+    iterator begin() const { return iterator(columns, 0); }
+    iterator end() const { return iterator(columns, columns->size()); }
+
+    // Direct access to the columns for batch consumers
+    const Columns& data() const { return *columns; }
+};
+
+using AsteroidView = EntityView<AsteroidColumns, AsteroidRef>;
+using ProjectileView = EntityView<ProjectileColumns, ProjectileRef>;
+using PowerUpView = EntityView<PowerUpColumns, PowerUpRef>;
+
+} // namespace starship
+
+#endif // STARSHIP_ENTITY_VIEW_HXX
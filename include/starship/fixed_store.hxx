@@ -0,0 +1,153 @@
+#ifndef STARSHIP_FIXED_STORE_HXX
+#define STARSHIP_FIXED_STORE_HXX
+
+#include "Vector2D.hxx"
+#include "asteroid.hxx"
+#include "entity_store.hxx"
+#include "powerup.hxx"
+#include "projectile.hxx"
+#include "shape_library.hxx"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace starship {
+
+// Fixed-capacity counterparts of the column stores in entity_store.hxx,
+// for BasicGame. Every column is an inline std::array, so a store never
+// allocates and its size is known at compile time.
+//
+// There are no handles: entities are addressed by slot. Destroyed entries
+// stay in place, inactive, until compact() closes them up in one stable
+// pass, so slot order is always spawn order. push() returns false and
+// stores nothing once the store is full.
+template <std::size_t N>
+struct FixedBodyColumns {
+    static constexpr std::size_t CAPACITY = N;
+
+    std::array<float, N> x;
+    std::array<float, N> y;
+    std::array<float, N> vx;
+    std::array<float, N> vy;
+    std::array<float, N> radius;
+    std::array<std::uint8_t, N> flags;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+
+    bool isActive(std::size_t i) const { return (flags[i] & ENTITY_ACTIVE) != 0; }
+    void setActive(std::size_t i, bool state) {
+        if (state) {
+            flags[i] |= ENTITY_ACTIVE;
+        } else {
+            flags[i] &= static_cast<std::uint8_t>(~ENTITY_ACTIVE);
+        }
+    }
+
+    Vector2D position(std::size_t i) const { return Vector2D(x[i], y[i]); }
+    Vector2D velocity(std::size_t i) const { return Vector2D(vx[i], vy[i]); }
+    void setVelocity(std::size_t i, const Vector2D& vel) {
+        vx[i] = vel.x;
+        vy[i] = vel.y;
+    }
+
+protected:
+    std::size_t count = 0;
+
+    // Slot of the new entry; the caller has checked full()
+    std::size_t pushBody(const Vector2D& pos, const Vector2D& vel, float r) {
+        const std::size_t i = count++;
+        x[i] = pos.x;
+        y[i] = pos.y;
+        vx[i] = vel.x;
+        vy[i] = vel.y;
+        radius[i] = r;
+        flags[i] = ENTITY_ACTIVE;
+        return i;
+    }
+
+    // Drop inactive entries from every column in one stable pass
+    template <typename... Extra>
+    void compactBody(Extra&... extra) {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!(flags[i] & ENTITY_ACTIVE)) continue;
+            if (kept != i) {
+                moveEntry(kept, i, x, y, vx, vy, radius, flags, extra...);
+            }
+            ++kept;
+        }
+        count = kept;
+    }
+
+private:
+    template <typename... Columns>
+    static void moveEntry(std::size_t to, std::size_t from, Columns&... columns) {
+        ((columns[to] = columns[from]), ...);
+    }
+};
+
+template <std::size_t N>
+struct FixedAsteroidColumns : FixedBodyColumns<N> {
+    std::array<float, N> rotation;
+    std::array<float, N> rotationSpeed;
+    std::array<Asteroid::Size, N> sizes;
+    std::array<std::uint16_t, N> shapeVariants;
+
+    // Outlines the variants refer to; generated on first lookup
+    AsteroidShapeLibrary shapeLibrary;
+
+    bool push(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size, float r,
+              float rot, float rotSpeed, std::uint16_t shapeVariant) {
+        if (this->full()) return false;
+        const std::size_t i = this->pushBody(pos, vel, r);
+        rotation[i] = rot;
+        rotationSpeed[i] = rotSpeed;
+        sizes[i] = size;
+        shapeVariants[i] = shapeVariant;
+        return true;
+    }
+
+    ShapeView shape(std::size_t i) const {
+        return shapeLibrary.getShape(static_cast<int>(sizes[i]), shapeVariants[i]);
+    }
+
+    void clear() { this->count = 0; }
+    void compact() { this->compactBody(rotation, rotationSpeed, sizes, shapeVariants); }
+};
+
+template <std::size_t N>
+struct FixedProjectileColumns : FixedBodyColumns<N> {
+    std::array<float, N> lifetime;
+
+    bool push(const Vector2D& pos, const Vector2D& vel) {
+        if (this->full()) return false;
+        lifetime[this->pushBody(pos, vel, Projectile::RADIUS)] = 0.0f;
+        return true;
+    }
+
+    void clear() { this->count = 0; }
+    void compact() { this->compactBody(lifetime); }
+};
+
+template <std::size_t N>
+struct FixedPowerUpColumns : FixedBodyColumns<N> {
+    std::array<float, N> lifetime;
+    std::array<PowerUp::Type, N> types;
+
+    bool push(const Vector2D& pos, const Vector2D& vel, PowerUp::Type type) {
+        if (this->full()) return false;
+        const std::size_t i = this->pushBody(pos, vel, PowerUp::RADIUS);
+        lifetime[i] = 0.0f;
+        types[i] = type;
+        return true;
+    }
+
+    void clear() { this->count = 0; }
+    void compact() { this->compactBody(lifetime, types); }
+};
+
+} // namespace starship
+
+#endif // STARSHIP_FIXED_STORE_HXX
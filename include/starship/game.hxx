@@ -5,60 +5,267 @@
 #include "asteroid.hxx"
 #include "projectile.hxx"
 #include "powerup.hxx"
+#include "spatial_grid.hxx"
+#include "entity_store.hxx"
+#include "entity_view.hxx"
+#include "asteroid_outlines.hxx"
+#include "entity_bvh.hxx"
+#include "timer_wheel.hxx"
+#include "world_sectors.hxx"
+#include "command_buffer.hxx"
+#include "random.hxx"
+#include "input.hxx"
+#include "game_config.hxx"
+#include "thread_pool.hxx"
+#include "tick_profiler.hxx"
+#include "alloc_tracker.hxx"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <memory>
-#include <random>
 
 namespace starship {
 
 class Game {
 private:
+    friend struct SnapshotAccess;
+
     Starship player;
-    std::vector<Asteroid> asteroids;
-    std::vector<Projectile> projectiles;
-    std::vector<PowerUp> powerUps;
+    
+    // Entities are stored column-wise; see entity_store.hxx
+    AsteroidColumns asteroids;
+    ProjectileColumns projectiles;
+    PowerUpColumns powerUps;
     
     int score;
     int level;
     float width;
     float height;
     
-    std::mt19937 rng;
+    std::uint32_t seed;
     
-    float shootCooldown;
-    const float shootDelay = 0.3f;
+    // Every random decision draws from its own stream keyed by (seed,
+    // randomTick, id, purpose); see random.hxx. The tick moves on once per
+    // collision pass. Hits use their index in the pass as id; other spawns
+    // take the next serial, so draws never depend on evaluation order.
+    std::uint64_t randomTick;
+    std::uint32_t spawnSerial;
+    RandomStream randomStream(RandomPurpose purpose, std::uint32_t id) const {
+        return RandomStream(seed, randomTick, id, purpose);
+    }
+    
+    // Collision broad phase, rebuilt from the asteroid list every tick
+    SpatialGrid asteroidGrid;
+    
+    // Optional worker pool; null runs every phase on the calling thread
+    std::shared_ptr<ThreadPool> threadPool;
+    
+    // First asteroid hit by each projectile, found in parallel per tick
+    std::vector<std::uint32_t> projectileHits;
+    
+    // Asteroids already taken by an earlier projectile in this pass
+    std::vector<std::uint8_t> asteroidClaimed;
+    
+    // Effects of the current collision pass, applied after detection
+    CommandBuffer commands;
+    
+    // Built on request and reused until the asteroids next change
+    mutable AsteroidOutlines asteroidOutlines;
+    mutable bool outlinesDirty;
+    
+    // Spatial query indexes, brought up to date by the first query after
+    // the entities change
+    mutable EntityBvh asteroidBvh;
+    mutable EntityBvh powerUpBvh;
+    mutable std::vector<EntityBvh::Neighbor> nearestScratch;
     
+    // Projectile hits test asteroid outlines instead of circles
+    bool polygonCollisions;
+    
+    // Tuning constants; see game_config.hxx
+    using Config = DefaultGameConfig;
+    
+    float shootCooldown;
     float spawnTimer;
-    const float spawnInterval = 2.0f;  // Spawn new asteroid every 2 seconds
     
-    // Power-up effect timers
-    float shieldTimer;
-    float multiShotTimer;
-    float rapidFireTimer;
-    float speedBoostTimer;
+    // Power-up effects, indexed by PowerUp::Type: the tick each one ends
+    // on and a bit per effect still running. Picking an effect up again
+    // moves its end later; the timer wheel clears the bit once it passes.
+    std::array<std::uint64_t, PowerUp::TYPE_COUNT> effectEnds;
+    std::uint8_t activeEffects;
     bool gameOver;
+    
+    static std::uint8_t effectBit(PowerUp::Type type) {
+        return static_cast<std::uint8_t>(1u << static_cast<int>(type));
+    }
+    void startEffect(PowerUp::Type type, float duration);
+    
+    // Dormant asteroids of a world larger than the active region; off
+    // unless setSectors turns it on
+    WorldSectors sectors;
+    
+    // Projectile and power-up lifetimes, effect ends and dormant asteroid
+    // wake-ups, each scheduled once and handled in bulk when due; see
+    // timer_wheel.hxx
+    TimerWheel timers;
+    std::vector<TimerWheel::Timer> expiredTimers;
+    
+    // Clock the wheel runs on: one tick per step(), dt / fixedTimestep
+    // ticks for a direct update(dt), with the fraction carried over
+    std::uint64_t timerTick;
+    float tickCarry;
+    std::uint64_t ticksFor(float seconds) const;
+    void expireTimers(float deltaTime);
+    // Refill the wheel from the columns after a snapshot restore
+    void rebuildTimers();
+    
+    // Adds to the live columns, or parks the asteroid if its sector is dormant
+    AsteroidHandle pushAsteroid(const CommandBuffer::AsteroidSpawn& spawn);
+    AsteroidHandle appendAsteroid(const CommandBuffer::AsteroidSpawn& spawn);
+    
+    // Move the active region to the player's sector: wake the sectors it
+    // now covers, park live asteroids it has left behind
+    void refreshSectors();
+    // Bring a dormant asteroid to the current tick after a wake-up
+    void crossSector(std::uint32_t slot);
+    // Wake-up for when a dormant asteroid next changes sector or leaves the world
+    void scheduleWake(std::uint32_t slot);
+    PowerUpHandle pushPowerUp(const Vector2D& pos, PowerUp::Type type, float drift);
+    void applyCommands();
+    
+    // Fixed-timestep driver state (see advance)
+    float fixedTimestep;
+    int maxSubsteps;
+    float accumulator;
+    std::uint64_t tickCount;
+    
+    // Per-phase update timings; see tick_profiler.hxx
+    TickProfile profile;
+    bool profiling;
+    LatencyHistogram* phaseHistogram(TickPhase phase) { return profiling ? &profile[phase] : nullptr; }
+    
+    TickAllocations lastTickAllocations;
 
 public:
+    static constexpr float DEFAULT_TIMESTEP = 1.0f / 60.0f;
+    static constexpr int DEFAULT_MAX_SUBSTEPS = 5;
+    
+    // Seeds from std::random_device; use the seeded overload to reproduce a run
     Game(float width, float height);
+    Game(float width, float height, std::uint32_t seed);
     
     void update(float deltaTime);
     void handleInput(char input, float deltaTime);
     
+    // Apply one tick's worth of input. Unlike handleInput, this is the
+    // whole control state: with neither LEFT nor RIGHT set the player stops.
+    void applyInput(InputMask input, float deltaTime);
+    
+    // Run exactly one fixed tick: applyInput then update
+    void step(InputMask input);
+    
+    // Accumulate real frame time and run as many fixed ticks as fit, at
+    // most maxSubsteps; time beyond that is dropped so a stall cannot
+    // snowball. Returns the number of ticks run.
+    int advance(float frameTime, InputMask input);
+    
+    void setFixedTimestep(float timestep, int maxSubsteps = DEFAULT_MAX_SUBSTEPS);
+    float getFixedTimestep() const { return fixedTimestep; }
+    int getMaxSubsteps() const { return maxSubsteps; }
+    // Fraction of a tick left in the accumulator, for render interpolation
+    float getInterpolationAlpha() const { return accumulator / fixedTimestep; }
+    std::uint64_t getTickCount() const { return tickCount; }
+    std::uint32_t getSeed() const { return seed; }
+    
+    // Split the integration loops, collision queries and compaction across
+    // a pool. The pool can be shared by several games; null turns it off.
+    // Results are identical for any thread count.
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    // Convenience for setThreadPool: 0 = one thread per core, 1 = off
+    void setThreadCount(unsigned count);
+    unsigned getThreadCount() const { return threadPool ? threadPool->getThreadCount() : 1; }
+    
+    // Latency of each update phase over the ticks run so far. Timing costs
+    // a few clock reads per tick and is on by default; building with
+    // STARSHIP_PROFILING=0 removes it entirely.
+    const TickProfile& getProfile() const { return profile; }
+    void resetProfile() { profile.reset(); }
+    void setProfiling(bool enabled) { profiling = enabled; }
+    bool isProfiling() const { return STARSHIP_PROFILING && profiling; }
+    
+    // Heap activity of the last step(), per phase. Stays zero unless the
+    // program links starship_alloc_hooks; see alloc_tracker.hxx.
+    const TickAllocations& getLastTickAllocations() const { return lastTickAllocations; }
+    
+    // Hash of the simulation state, for checking that two runs match bit for bit
+    std::uint64_t checksum() const;
+    
     void spawnAsteroids(int count);
-    void spawnAsteroid(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size);
-    void spawnPowerUp(const Vector2D& pos);
+    // The returned handles stay valid until the entity is destroyed. With
+    // sectors on, an asteroid that goes dormant loses its handle, and one
+    // spawned into a dormant sector gets a null handle.
+    AsteroidHandle spawnAsteroid(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size);
+    PowerUpHandle spawnPowerUp(const Vector2D& pos);
+    ProjectileHandle spawnProjectile(const Vector2D& pos, const Vector2D& vel);
     void shootProjectile();
     void applyPowerUp(PowerUp::Type type);
     
-    void checkCollisions();
+    // Projectile paths over the last `deltaTime` are swept, so a shot
+    // cannot tunnel through an asteroid at a coarse timestep. With 0 only
+    // end-of-tick positions are tested. update() passes its own step.
+    void checkCollisions(float deltaTime = 0.0f);
+    
+    // What the last collision pass did, e.g. for sound or effects
+    const CommandBuffer& getLastCommands() const { return commands; }
+    
+    // Narrow phase for projectile hits: the asteroid's collision circle
+    // (default), or its actual outline from getAsteroidOutlines(). Outlines
+    // cost more and generate the shape library in headless runs.
+    void setPolygonCollisions(bool enabled) { polygonCollisions = enabled; }
+    bool hasPolygonCollisions() const { return polygonCollisions; }
+    // Free the slots of destroyed entities. Each store is compacted only
+    // once its holes pass the threshold in entity_store.hxx. Called by
+    // update().
+    void releaseInactiveEntities();
+    // Compact every store now, closing all holes
     void removeInactiveEntities();
     
     // Getters for rendering
     const Starship& getPlayer() const { return player; }
     Starship& getPlayer() { return player; }
-    const std::vector<Asteroid>& getAsteroids() const { return asteroids; }
-    const std::vector<Projectile>& getProjectiles() const { return projectiles; }
-    const std::vector<PowerUp>& getPowerUps() const { return powerUps; }
+    AsteroidView getAsteroids() const { return AsteroidView(&asteroids); }
+    ProjectileView getProjectiles() const { return ProjectileView(&projectiles); }
+    PowerUpView getPowerUps() const { return PowerUpView(&powerUps); }
+    
+    // World-space outline of every asteroid, indexed like getAsteroids().
+    // Rebuilt at most once per tick and only when asked for, so headless
+    // runs never pay for it. Not safe to call from two threads at once.
+    const AsteroidOutlines& getAsteroidOutlines() const;
+    
+    // Spatial queries over the live asteroids or power-ups, picked by the
+    // handle type of the result. Each store keeps a bounding volume
+    // hierarchy (entity_bvh.hxx) that the first query after a tick refits
+    // to the new positions, or rebuilds if entities were added or
+    // compacted, so each query costs O(log n) however many a tick makes.
+    // The world is treated as flat: queries do not wrap at the screen
+    // edges. Results replace the contents of `out`, in no particular
+    // order unless stated. Not safe to call from two threads at once.
+    
+    // Entities whose circle overlaps the circle (center, radius)
+    std::size_t queryRadius(const Vector2D& center, float radius, std::vector<AsteroidHandle>& out) const;
+    std::size_t queryRadius(const Vector2D& center, float radius, std::vector<PowerUpHandle>& out) const;
+    // Entities whose circle overlaps the box [min, max]
+    std::size_t queryAABB(const Vector2D& min, const Vector2D& max, std::vector<AsteroidHandle>& out) const;
+    std::size_t queryAABB(const Vector2D& min, const Vector2D& max, std::vector<PowerUpHandle>& out) const;
+    // The first entity the ray from `origin` along `direction` touches
+    // within `maxDistance`; false if there is none
+    bool raycast(const Vector2D& origin, const Vector2D& direction, float maxDistance,
+                 RaycastHit<AsteroidHandle>& hit) const;
+    bool raycast(const Vector2D& origin, const Vector2D& direction, float maxDistance,
+                 RaycastHit<PowerUpHandle>& hit) const;
+    // The k entities with centres closest to `point`, nearest first
+    std::size_t nearestK(const Vector2D& point, std::size_t k, std::vector<AsteroidHandle>& out) const;
+    std::size_t nearestK(const Vector2D& point, std::size_t k, std::vector<PowerUpHandle>& out) const;
     
     int getScore() const { return score; }
     int getLevel() const { return level; }
@@ -66,12 +273,37 @@ public:
     float getWidth() const { return width; }
     float getHeight() const { return height; }
     
-    bool isShielded() const { return shieldTimer > 0; }
-    bool hasMultiShot() const { return multiShotTimer > 0; }
-    bool hasRapidFire() const { return rapidFireTimer > 0; }
-    bool hasSpeedBoost() const { return speedBoostTimer > 0; }
+    bool hasEffect(PowerUp::Type type) const { return (activeEffects & effectBit(type)) != 0; }
+    bool isShielded() const { return hasEffect(PowerUp::Type::SHIELD); }
+    bool hasMultiShot() const { return hasEffect(PowerUp::Type::MULTI_SHOT); }
+    bool hasRapidFire() const { return hasEffect(PowerUp::Type::RAPID_FIRE); }
+    bool hasSpeedBoost() const { return hasEffect(PowerUp::Type::SPEED_BOOST); }
+    // Timers waiting on the wheel, including ones for entities already
+    // destroyed, which are dropped when they come due
+    std::size_t getPendingTimerCount() const { return timers.size(); }
+
+    // Simulation level of detail for worlds larger than the view; see
+    // world_sectors.hxx. Asteroids more than `activeRadius` squares of
+    // `sectorSize` from the player's go dormant: they move on analytically
+    // and skip collisions until their sector comes back in range. Choose
+    // the two so the active squares cover the view and projectile range.
+    // A size of 0 (the default) wakes everything and turns sectors off.
+    void setSectors(float sectorSize, int activeRadius = 1);
+    const WorldSectors& getSectors() const { return sectors; }
+    // Live asteroids plus dormant ones
+    std::size_t getAsteroidCount() const { return asteroids.liveCount() + sectors.size(); }
+
+    // Pre-size the entity columns so a game stops allocating once warm
+    void reserve(std::size_t asteroidCount, std::size_t projectileCount, std::size_t powerUpCount);
 
+    // Start a new round. Random draws carry on from the previous round.
     void reset();
+    // Start over exactly as Game(width, height, seed) would, keeping the
+    // memory already allocated
+    void reset(std::uint32_t seed);
+    // Jump to `level` without touching the field: later waves and the
+    // continuous spawns follow it. For soak runs and debugging.
+    void setLevel(int newLevel) { level = newLevel; }
 };
 
 } // namespace starship
@@ -0,0 +1,85 @@
+#ifndef STARSHIP_GAME_BATCH_HXX
+#define STARSHIP_GAME_BATCH_HXX
+
+#include "game.hxx"
+#include "input.hxx"
+#include "thread_pool.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace starship {
+
+// Many independent games stepped together, for balance sweeps and agent
+// training. Games live in one contiguous array, and their columns are
+// reserved up front so the batch stops allocating once warm. Per-game
+// results are kept in parallel output arrays (one entry per game) that
+// callers can hand straight to numeric code.
+class GameBatch {
+public:
+    // Columns reserved per game; enough for a late-level screen
+    static constexpr std::size_t RESERVED_ASTEROIDS = 128;
+    static constexpr std::size_t RESERVED_PROJECTILES = 64;
+    static constexpr std::size_t RESERVED_POWERUPS = 16;
+
+    // Games `0..count-1` are seeded from baseSeed; see seedFor
+    GameBatch(std::size_t count, float width, float height, std::uint32_t baseSeed);
+
+    // Advance every game by one fixed tick. `inputs` holds one mask per
+    // game, or is null for no input. Outputs are refreshed afterwards.
+    void step(const InputMask* inputs);
+
+    // Run `ticks` ticks with the same inputs each tick
+    void run(const InputMask* inputs, int ticks);
+
+    // Restart a finished game inside step() with the next episode's seed
+    void setAutoReset(bool enabled) { autoReset = enabled; }
+    bool getAutoReset() const { return autoReset; }
+
+    // Restart every game (or one) at episode 0, reusing all memory
+    void reset();
+    void reset(std::size_t index);
+
+    // Spread games across a pool; null steps them on the calling thread.
+    // Results do not depend on the thread count.
+    void setThreadPool(std::shared_ptr<ThreadPool> pool);
+    void setThreadCount(unsigned count);
+    unsigned getThreadCount() const { return threadPool ? threadPool->getThreadCount() : 1; }
+
+    std::size_t size() const { return games.size(); }
+    Game& getGame(std::size_t index) { return games[index]; }
+    const Game& getGame(std::size_t index) const { return games[index]; }
+
+    // Per-game outputs, contiguous, valid until the next step or reset
+    const std::int32_t* getScores() const { return scores.data(); }
+    const std::int32_t* getLevels() const { return levels.data(); }
+    const std::uint8_t* getGameOver() const { return gameOver.data(); }
+    const std::uint32_t* getEpisodes() const { return episodes.data(); }
+
+    // Total ticks simulated across all games
+    std::uint64_t getTotalTicks() const { return totalTicks; }
+
+    // Seed of a game's episode: a hash of all three, so neighbouring
+    // games and episodes get unrelated streams
+    static std::uint32_t seedFor(std::uint32_t baseSeed, std::size_t index, std::uint32_t episode);
+
+private:
+    std::vector<Game> games;
+    std::uint32_t baseSeed;
+    bool autoReset;
+    std::uint64_t totalTicks;
+    std::shared_ptr<ThreadPool> threadPool;
+
+    std::vector<std::int32_t> scores;
+    std::vector<std::int32_t> levels;
+    std::vector<std::uint8_t> gameOver;
+    std::vector<std::uint32_t> episodes;
+
+    void stepRange(const InputMask* inputs, std::size_t begin, std::size_t end);
+    void publish(std::size_t index);
+};
+
+} // namespace starship
+
+#endif // STARSHIP_GAME_BATCH_HXX
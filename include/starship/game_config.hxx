@@ -0,0 +1,52 @@
+#ifndef STARSHIP_GAME_CONFIG_HXX
+#define STARSHIP_GAME_CONFIG_HXX
+
+#include <array>
+#include <cstddef>
+
+namespace starship {
+
+// Tuning constants and capacities, fixed at compile time. Game takes its
+// tuning from DefaultGameConfig; BasicGame<Config> takes everything,
+// including its world size and entity capacities, from its parameter.
+//
+// A custom config can derive from DefaultGameConfig and shadow only the
+// members it changes. Per-size tables are indexed like Asteroid::Size
+// (LARGE, MEDIUM, SMALL).
+struct DefaultGameConfig {
+    // World size in pixels (BasicGame only; Game takes it at run time)
+    static constexpr float WIDTH = 800.0f;
+    static constexpr float HEIGHT = 600.0f;
+
+    // Most entities of each kind alive at once (BasicGame only). Spawns
+    // past a limit are dropped.
+    static constexpr std::size_t MAX_ASTEROIDS = 256;
+    static constexpr std::size_t MAX_PROJECTILES = 128;
+    static constexpr std::size_t MAX_POWERUPS = 32;
+
+    // Player
+    static constexpr float PLAYER_SPEED = 150.0f;
+    static constexpr float SPEED_BOOST_MULTIPLIER = 2.0f;
+    static constexpr int MAX_HEALTH = 5;
+
+    // Shooting
+    static constexpr float SHOOT_DELAY = 0.3f;
+    static constexpr float RAPID_FIRE_DELAY_SCALE = 0.5f;
+    static constexpr float PROJECTILE_SPEED = 300.0f;
+    static constexpr float MULTI_SHOT_SPREAD = 50.0f;   // Sideways speed of the outer shots
+
+    // Asteroids
+    static constexpr int INITIAL_ASTEROIDS = 8;
+    static constexpr float SPAWN_INTERVAL = 2.0f;
+    static constexpr std::array<float, 3> ASTEROID_RADIUS = {20.0f, 12.0f, 6.0f};
+    static constexpr std::array<int, 3> ASTEROID_POINTS = {20, 50, 100};
+
+    // Power-ups
+    static constexpr float POWERUP_DROP_CHANCE = 0.15f;
+    static constexpr float EFFECT_DURATION = 8.0f;        // Shield, multi-shot, rapid fire
+    static constexpr float SPEED_BOOST_DURATION = 5.0f;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_GAME_CONFIG_HXX
@@ -0,0 +1,24 @@
+#ifndef STARSHIP_INPUT_HXX
+#define STARSHIP_INPUT_HXX
+
+#include <cstdint>
+
+namespace starship {
+
+// Player input for one simulation tick, one bit per control. A tick's
+// input is the full state of the controls, not a list of key events, so a
+// session is reproduced exactly by replaying one mask per tick.
+using InputMask = std::uint8_t;
+
+enum InputBit : InputMask {
+    INPUT_NONE    = 0,
+    INPUT_LEFT    = 1 << 0,
+    INPUT_RIGHT   = 1 << 1,
+    INPUT_THRUST  = 1 << 2,
+    INPUT_FIRE    = 1 << 3,
+    INPUT_RESTART = 1 << 4
+};
+
+} // namespace starship
+
+#endif // STARSHIP_INPUT_HXX
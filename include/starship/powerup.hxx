@@ -14,6 +14,7 @@ public:
         EXTRA_LIFE,
         SPEED_BOOST
     };
+    static constexpr int TYPE_COUNT = 5;
 
 private:
     Type type;
@@ -21,12 +22,15 @@ private:
     float maxLifetime;  // How long power-up stays on screen
 
 public:
+    static constexpr float RADIUS = 8.0f;
+    static constexpr float MAX_LIFETIME = 10.0f;
+
     PowerUp(const Vector2D& pos, Type t)
-        : Entity(pos, 8.0f), type(t), lifetime(0.0f), maxLifetime(10.0f) {
+        : Entity(pos, RADIUS), type(t), lifetime(0.0f), maxLifetime(MAX_LIFETIME) {
         // Velocity will be set by the spawning method
     }
 
-    void update(float deltaTime) override {
+    void update(float deltaTime) {
         Entity::update(deltaTime);
         lifetime += deltaTime;
 
@@ -44,8 +48,8 @@ public:
         int r, g, b, a;
     };
     
-    Color getColor() const {
-        switch (type) {
+    static Color getColorForType(Type t) {
+        switch (t) {
             case Type::SHIELD:      return {0, 255, 255, 255};    // Cyan
             case Type::MULTI_SHOT:  return {255, 0, 255, 255};    // Magenta
             case Type::RAPID_FIRE:  return {255, 255, 0, 255};    // Yellow
@@ -54,6 +58,10 @@ public:
             default:                return {255, 255, 255, 255};  // White
         }
     }
+
+    Color getColor() const {
+        return getColorForType(type);
+    }
 };
 
 } // namespace starship
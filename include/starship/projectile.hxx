@@ -11,12 +11,15 @@ private:
     float maxLifetime;
 
 public:
+    static constexpr float RADIUS = 0.3f;
+    static constexpr float MAX_LIFETIME = 2.0f;
+
     Projectile(const Vector2D& pos, const Vector2D& vel)
-        : Entity(pos, 0.3f), lifetime(0.0f), maxLifetime(2.0f) {
+        : Entity(pos, RADIUS), lifetime(0.0f), maxLifetime(MAX_LIFETIME) {
         velocity = vel;
     }
 
-    void update(float deltaTime) override {
+    void update(float deltaTime) {
         Entity::update(deltaTime);
         lifetime += deltaTime;
         
@@ -0,0 +1,97 @@
+#ifndef STARSHIP_RANDOM_HXX
+#define STARSHIP_RANDOM_HXX
+
+#include <array>
+#include <cstdint>
+
+namespace starship {
+
+// Counter-based random numbers: Philox4x32-10 (Salmon et al., "Parallel
+// Random Numbers: As Easy as 1, 2, 3", SC 2011). A block of four 32-bit
+// outputs is a pure function of a 128-bit counter and a 64-bit key, so
+// there is no engine state to share or advance: a draw depends only on
+// what it is for, never on how many draws came before it or on which
+// thread makes it.
+namespace philox {
+
+using Block = std::array<std::uint32_t, 4>;
+
+inline Block philox4x32(Block counter, std::uint32_t key0, std::uint32_t key1) {
+    constexpr std::uint64_t M0 = 0xD2511F53u;
+    constexpr std::uint64_t M1 = 0xCD9E8D57u;
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = M0 * counter[0];
+        const std::uint64_t p1 = M1 * counter[2];
+        counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key0,
+                   static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key1,
+                   static_cast<std::uint32_t>(p0)};
+        key0 += 0x9E3779B9u;
+        key1 += 0xBB67AE85u;
+    }
+    return counter;
+}
+
+} // namespace philox
+
+// What a draw decides. Part of every key, so two decisions about the same
+// entity on the same tick never share numbers.
+enum class RandomPurpose : std::uint8_t {
+    SHAPES,     // Seed of the asteroid shape library
+    WAVE,       // Entry point and drift of a wave asteroid
+    ASTEROID,   // Spin, angle and outline of a new asteroid
+    POWER_UP,   // Type and drift of a spawned power-up
+    DROP,       // Whether a destroyed asteroid leaves a power-up, and which
+    SPLIT       // Headings and looks of a destroyed asteroid's fragments
+};
+
+// The numbers for one (seed, tick, id, purpose) key, in order. Making a
+// stream costs nothing; each block of four draws is one Philox call.
+// Streams with different keys are independent, so callers give every
+// decision its own stream instead of sharing one.
+class RandomStream {
+public:
+    RandomStream(std::uint32_t seed, std::uint64_t tick, std::uint32_t id, RandomPurpose purpose)
+        : counter{id, static_cast<std::uint32_t>(purpose) << 24,
+                  static_cast<std::uint32_t>(tick), static_cast<std::uint32_t>(tick >> 32)},
+          block{},
+          key(seed),
+          used(4) {}
+
+    std::uint32_t nextU32() {
+        if (used == 4) {
+            block = philox::philox4x32(counter, key, 0);
+            // The low 24 bits of the purpose word count blocks
+            ++counter[1];
+            used = 0;
+        }
+        return block[used++];
+    }
+
+    // Uniform in [0, 1), from the top 24 bits
+    float nextFloat() {
+        return static_cast<float>(nextU32() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // Uniform in [lo, hi)
+    float uniform(float lo, float hi) {
+        return lo + (hi - lo) * nextFloat();
+    }
+
+    // Uniform in [lo, hi], inclusive. Multiply-shift reduction: the bias
+    // is below (hi - lo + 1) / 2^32.
+    int uniformInt(int lo, int hi) {
+        const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo + 1);
+        return lo + static_cast<int>((nextU32() * range) >> 32);
+    }
+
+private:
+    philox::Block counter;
+    philox::Block block;
+    std::uint32_t key;
+    unsigned used;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_RANDOM_HXX
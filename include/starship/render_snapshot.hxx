@@ -0,0 +1,94 @@
+#ifndef STARSHIP_RENDER_SNAPSHOT_HXX
+#define STARSHIP_RENDER_SNAPSHOT_HXX
+
+#include "Vector2D.hxx"
+#include "asteroid.hxx"
+#include "powerup.hxx"
+#include "entity_store.hxx"
+#include "tick_profiler.hxx"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+class Game;
+
+// Everything a frontend needs to draw one tick, copied out of a Game so a
+// render thread can use it while the simulation moves on. Only live
+// entities are included, in slot order, each with its handle so two
+// snapshots can be matched up for interpolation.
+//
+// Outlines are not copied. A snapshot carries the shape library seed,
+// and the frontend keeps its own AsteroidShapeLibrary with that seed;
+// see AsteroidOutlines::build(const RenderSnapshot&, ...).
+struct RenderSnapshot {
+    struct AsteroidState {
+        AsteroidHandle handle;
+        Vector2D position;
+        float rotation;          // Degrees, in [0, 360)
+        Asteroid::Size size;
+        std::uint16_t shapeVariant;
+    };
+
+    struct ProjectileState {
+        ProjectileHandle handle;
+        Vector2D position;
+    };
+
+    struct PowerUpState {
+        PowerUpHandle handle;
+        Vector2D position;
+        float radius;
+        PowerUp::Type type;
+    };
+
+    // Latency summary of one tick phase, in nanoseconds
+    struct PhaseSummary {
+        std::uint64_t p50 = 0;
+        std::uint64_t p99 = 0;
+        std::uint64_t max = 0;
+    };
+
+    std::uint64_t tick = 0;
+
+    Vector2D playerPosition;
+    float playerRotation = 0.0f;
+    bool playerActive = false;
+
+    // HUD
+    int score = 0;
+    int lives = 0;
+    int level = 0;
+    bool gameOver = false;
+    bool shielded = false;
+    bool multiShot = false;
+    bool rapidFire = false;
+    bool speedBoost = false;
+
+    std::uint32_t shapeSeed = 0;
+
+    std::vector<AsteroidState> asteroids;
+    std::vector<ProjectileState> projectiles;
+    std::vector<PowerUpState> powerUps;
+
+    // Not filled by capture(); a producer that wants the profile overlay
+    // sets it, e.g. from summarizeProfile()
+    std::array<PhaseSummary, TICK_PHASE_COUNT> profile;
+
+    // Copy the game's current state; keeps the vectors' capacity
+    void capture(const Game& game);
+
+    static std::array<PhaseSummary, TICK_PHASE_COUNT> summarizeProfile(const TickProfile& profile);
+};
+
+// Write the state `alpha` of the way from `from` to `to` into `out`.
+// Entities present in both are matched by handle and have their position
+// (and asteroid rotation, the short way round) interpolated; the rest
+// are taken from `to` as they are. Everything else comes from `to`.
+// `out` keeps its capacity and must not alias either input.
+void blendSnapshots(const RenderSnapshot& from, const RenderSnapshot& to, float alpha, RenderSnapshot& out);
+
+} // namespace starship
+
+#endif // STARSHIP_RENDER_SNAPSHOT_HXX
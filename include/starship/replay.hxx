@@ -0,0 +1,87 @@
+#ifndef STARSHIP_REPLAY_HXX
+#define STARSHIP_REPLAY_HXX
+
+#include "game.hxx"
+#include "input.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace starship {
+
+// Everything needed to reproduce a session: the game's construction
+// parameters, the settings that change simulation results, and one input
+// mask per fixed tick. Given the same build and SIMD backend, replaying it
+// yields a bit-identical game. Settings are taken when recording starts,
+// so they must not change during the session.
+struct Recording {
+    std::uint32_t seed = 0;
+    float width = 0.0f;
+    float height = 0.0f;
+    float timestep = Game::DEFAULT_TIMESTEP;
+    float sectorSize = 0.0f;          // Game::setSectors, 0 if off
+    std::int32_t activeRadius = 0;
+    bool polygonCollisions = false;
+    std::vector<InputMask> inputs;    // One entry per tick
+    std::uint64_t finalChecksum = 0;  // Game::checksum() at the end, 0 if unknown
+
+    std::size_t getTickCount() const { return inputs.size(); }
+
+    // Game in the state the recording started from
+    Game createGame() const;
+
+    // Binary format: header, then run-length encoded inputs. Held keys
+    // make runs long, so a minute of play is typically a few hundred bytes.
+    bool save(std::ostream& out) const;
+    bool load(std::istream& in);
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+};
+
+// Captures the input of a live session tick by tick
+class InputRecorder {
+private:
+    Recording recording;
+
+public:
+    // Takes seed, size, timestep and settings from a freshly constructed
+    // and configured game
+    explicit InputRecorder(const Game& game);
+
+    // Record `ticks` consecutive ticks that used the same input, as
+    // returned by Game::advance
+    void record(InputMask input, int ticks = 1);
+
+    // Store the final checksum so a replay can be verified
+    void finish(const Game& game) { recording.finalChecksum = game.checksum(); }
+
+    const Recording& getRecording() const { return recording; }
+};
+
+// Feeds a recording back one tick at a time
+class InputPlayer {
+private:
+    const Recording* recording;
+    std::size_t cursor;
+
+public:
+    explicit InputPlayer(const Recording& recording)
+        : recording(&recording), cursor(0) {}
+
+    bool isDone() const { return cursor >= recording->inputs.size(); }
+    std::size_t getPosition() const { return cursor; }
+
+    // Next tick's input; INPUT_NONE once the recording is exhausted
+    InputMask next() { return isDone() ? InputMask(INPUT_NONE) : recording->inputs[cursor++]; }
+};
+
+// Replay the whole recording headless, as fast as the simulation runs.
+// `game` must come from recording.createGame(). Returns false if the
+// recording has a checksum and the final state does not match it.
+bool replay(const Recording& recording, Game& game);
+
+} // namespace starship
+
+#endif // STARSHIP_REPLAY_HXX
@@ -0,0 +1,107 @@
+#ifndef STARSHIP_REWIND_BUFFER_HXX
+#define STARSHIP_REWIND_BUFFER_HXX
+
+#include "game.hxx"
+#include "input.hxx"
+#include "snapshot.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+// The last few seconds of a game, one state per tick, for rollback and
+// "what just happened" debugging. Every keyframeInterval-th tick is kept
+// as a full Snapshot. The ticks in between are SnapshotDeltas against
+// their keyframe, so a tick costs only the columns that moved. Rewinding
+// to any held tick applies at most one delta.
+//
+// The buffer holds a contiguous run of ticks. Recording a tick at or
+// before the newest one (after rewindTo, or a Game::reset) drops the
+// newer ticks first; skipping ticks starts the buffer over.
+class RewindBuffer {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 600;           // Ten seconds at 60 Hz
+    static constexpr std::size_t DEFAULT_KEYFRAME_INTERVAL = 60;
+
+    // What the buffer costs, for tuning capacity and keyframe interval
+    struct Stats {
+        std::size_t ticks = 0;
+        std::size_t keyframes = 0;
+        std::size_t memoryBytes = 0;   // Everything allocated, scratch included
+        std::size_t fullBytes = 0;     // What the held ticks would take as full snapshots
+        double lastRecordNanos = 0.0;
+        double averageRecordNanos = 0.0;
+    };
+
+    explicit RewindBuffer(std::size_t capacity = DEFAULT_CAPACITY,
+                          std::size_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // Record the state after a tick. `input` is what that tick was stepped
+    // with, for resimulate().
+    void record(const Game& game, InputMask input = INPUT_NONE);
+
+    // Put `game` back to its state right after `tick`; false if not held
+    bool rewindTo(Game& game, std::uint64_t tick);
+
+    // Step `game` forward to `tick` with the recorded inputs. `game` must
+    // be at a held tick, e.g. just after rewindTo.
+    bool resimulate(Game& game, std::uint64_t tick) const;
+
+    bool contains(std::uint64_t tick) const { return count > 0 && tick >= oldestTick && tick <= getNewestTick(); }
+    // Input recorded for a held tick
+    InputMask getInput(std::uint64_t tick) const { return frames[slotOf(tick)].input; }
+
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
+    std::size_t getCapacity() const { return frames.size(); }
+    std::size_t getKeyframeInterval() const { return keyframeInterval; }
+    std::uint64_t getOldestTick() const { return oldestTick; }
+    std::uint64_t getNewestTick() const { return oldestTick + count - 1; }
+
+    Stats getStats() const;
+
+    // Forget every tick; keeps the memory for reuse
+    void clear();
+
+private:
+    static constexpr std::size_t NO_KEYFRAME = static_cast<std::size_t>(-1);
+
+    struct Frame {
+        std::size_t keyframe = NO_KEYFRAME;   // Index into keyframes
+        std::size_t distance = 0;             // Ticks since its keyframe
+        InputMask input = INPUT_NONE;
+        std::size_t fullBytes = 0;
+        SnapshotDelta delta;                  // Empty for keyframes
+    };
+
+    struct Keyframe {
+        Snapshot snapshot;
+        std::size_t users = 0;                // Frames that refer to it
+    };
+
+    std::vector<Frame> frames;                // Ring, oldest at `head`
+    std::vector<Keyframe> keyframes;
+    std::size_t keyframeInterval;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    std::uint64_t oldestTick = 0;
+
+    Snapshot scratch;                         // Rewind target
+
+    std::uint64_t recordCount = 0;
+    double totalRecordNanos = 0.0;
+    double lastRecordNanos = 0.0;
+
+    std::size_t slotOf(std::uint64_t tick) const {
+        return (head + static_cast<std::size_t>(tick - oldestTick)) % frames.size();
+    }
+    void dropOldest();
+    void dropNewest();
+    void releaseFrame(Frame& frame);
+    std::size_t freeKeyframe();
+};
+
+} // namespace starship
+
+#endif // STARSHIP_REWIND_BUFFER_HXX
@@ -0,0 +1,90 @@
+#ifndef STARSHIP_SHAPE_LIBRARY_HXX
+#define STARSHIP_SHAPE_LIBRARY_HXX
+
+#include "Vector2D.hxx"
+#include "game_config.hxx"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace starship {
+
+// Non-owning range over the points of one outline
+struct ShapeView {
+    const Vector2D* points;
+    std::size_t count;
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const Vector2D& operator[](std::size_t i) const { return points[i]; }
+    const Vector2D* begin() const { return points; }
+    const Vector2D* end() const { return points + count; }
+};
+
+// Fixed pool of jittered asteroid outlines. Asteroids store a small
+// variant index instead of owning their points. The pool is generated
+// from the seed on first access, so a headless run that never looks at
+// a shape never pays for the trig.
+//
+// Sizes are indexed the same way as Asteroid::Size (LARGE, MEDIUM, SMALL).
+class AsteroidShapeLibrary {
+public:
+    static constexpr int SIZE_COUNT = 3;
+    static constexpr int VARIANTS_PER_SIZE = 16;
+    static constexpr int MAX_VERTICES = 10;
+    static constexpr std::uint32_t DEFAULT_SEED = 0x5EEDu;
+    // Outline points lie between these multiples of the size's radius
+    static constexpr float MIN_JITTER = 0.65f;
+    static constexpr float MAX_JITTER = 1.15f;
+
+    using Radii = std::array<float, SIZE_COUNT>;
+
+    explicit AsteroidShapeLibrary(std::uint32_t seed = DEFAULT_SEED,
+                                  const Radii& radii = DefaultGameConfig::ASTEROID_RADIUS)
+        : seed(seed), radii(radii), built(false) {}
+
+    // Changing the seed discards any generated outlines
+    void setSeed(std::uint32_t newSeed) {
+        seed = newSeed;
+        built = false;
+    }
+    std::uint32_t getSeed() const { return seed; }
+
+    // Base radius of each size; changing it also discards the outlines
+    void setRadii(const Radii& newRadii) {
+        radii = newRadii;
+        built = false;
+    }
+    const Radii& getRadii() const { return radii; }
+
+    // Whether the outlines have been generated yet
+    bool isBuilt() const { return built; }
+
+    // Outline for a size index and variant; generates the pool on first use.
+    // Not safe to call for the first time from two threads at once.
+    ShapeView getShape(int sizeIndex, std::uint16_t variant) const;
+
+    static int getVertexCount(int sizeIndex) {
+        switch (sizeIndex) {
+            case 0:  return 10;
+            case 1:  return 8;
+            case 2:  return 6;
+            default: return 8;
+        }
+    }
+
+    // Library with the default seed, used by standalone Asteroid objects
+    static const AsteroidShapeLibrary& shared();
+
+private:
+    std::uint32_t seed;
+    Radii radii;
+    mutable bool built;
+    mutable std::array<Vector2D, SIZE_COUNT * VARIANTS_PER_SIZE * MAX_VERTICES> points;
+
+    void build() const;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_SHAPE_LIBRARY_HXX
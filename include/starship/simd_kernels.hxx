@@ -0,0 +1,71 @@
+#ifndef STARSHIP_SIMD_KERNELS_HXX
+#define STARSHIP_SIMD_KERNELS_HXX
+
+#include <cstddef>
+#include <cstdint>
+
+namespace starship {
+namespace simd {
+
+// Instruction sets the batch kernels are compiled for. SSE2 and AVX2 are
+// only available on x86; everything else runs the scalar versions.
+enum class Backend {
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Batch kernels over entity columns. Every backend fills the same table
+// and produces the same results as the scalar one.
+struct Kernels {
+    Backend backend;
+
+    // x += vx * dt, y += vy * dt
+    void (*integrate)(float* x, float* y, const float* vx, const float* vy,
+                      std::size_t count, float dt);
+
+    // rotation += speed * dt, wrapped back into [0, 360)
+    void (*advanceRotation)(float* rotation, const float* speed,
+                            std::size_t count, float dt);
+
+    // value += dt, used for lifetimes
+    void (*advanceTimers)(float* value, std::size_t count, float dt);
+
+    // Clear `bit` in flags wherever value > limit
+    void (*clearFlagAbove)(const float* value, std::uint8_t* flags,
+                           std::size_t count, float limit, std::uint8_t bit);
+
+    // Clear `bit` in flags wherever value < limit
+    void (*clearFlagBelow)(const float* value, std::uint8_t* flags,
+                           std::size_t count, float limit, std::uint8_t bit);
+
+    // sin and cos of angles in degrees, from a polynomial rather than libm
+    // (about 1e-7 absolute error) so every backend gives the same bits
+    void (*sinCosDegrees)(const float* degrees, float* sinOut, float* cosOut,
+                          std::size_t count);
+
+    // Rotate `count` interleaved x,y points by (cosA, sinA), then offset
+    // them by (tx, ty)
+    void (*transformPoints)(const float* local, float* world, std::size_t count,
+                            float cosA, float sinA, float tx, float ty);
+};
+
+// Whether this build and CPU can run the backend
+bool isSupported(Backend backend);
+
+// Kernels for a specific backend; unsupported ones fall back to scalar
+const Kernels& kernelsFor(Backend backend);
+
+// Kernels Game uses. Picks the best supported backend on first use.
+const Kernels& activeKernels();
+
+// Override the automatic choice, e.g. for A/B benchmarks.
+// Returns false and keeps the current choice if unsupported.
+bool setActiveBackend(Backend backend);
+
+const char* getBackendName(Backend backend);
+
+} // namespace simd
+} // namespace starship
+
+#endif // STARSHIP_SIMD_KERNELS_HXX
@@ -0,0 +1,123 @@
+#ifndef STARSHIP_SNAPSHOT_HXX
+#define STARSHIP_SNAPSHOT_HXX
+
+#include "game.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace starship {
+
+// Complete simulation state of a Game in one flat, versioned buffer:
+// player, every entity column and handle table, timers, score, level and
+// the counters random draws are keyed on. Each column is stored as a raw,
+// 16-byte aligned block behind a small section table, so restoring is one
+// bulk copy per column with no per-field parsing.
+//
+// The layout is the in-memory one, so a snapshot only loads into a build
+// with the same ABI (same compiler family and endianness); anything else
+// is rejected rather than misread. Restoring checks the structure, not
+// the content: compare getChecksum() against Game::checksum() to verify a
+// file from an untrusted source.
+class Snapshot {
+public:
+    Snapshot() = default;
+
+    static Snapshot capture(const Game& game);
+    // Capture into this snapshot, reusing its memory. Without the checksum
+    // (getChecksum() is then 0) this is a plain copy of the state.
+    void assign(const Game& game, bool withChecksum = true);
+
+    bool empty() const { return bytes.empty(); }
+    const std::uint8_t* data() const { return bytes.data(); }
+    std::size_t size() const { return bytes.size(); }
+
+    // Game::checksum() of the captured state; 0 if empty
+    std::uint64_t getChecksum() const;
+
+    // Overwrite `game` with the captured state. The game keeps its thread
+    // pool and other settings that are not simulation state. Returns
+    // false, leaving the game untouched, if this is not a valid snapshot
+    // for this build.
+    bool restore(Game& game) const;
+
+    bool save(std::ostream& out) const;
+    bool load(std::istream& in);
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    // Memory held, which can exceed size()
+    std::size_t capacity() const { return bytes.capacity(); }
+
+private:
+    friend class SnapshotDelta;
+
+    std::vector<std::uint8_t> bytes;
+};
+
+// Difference between a snapshot and an earlier one of the same game.
+// Each column is compared with its counterpart in 64-byte blocks and only
+// the blocks that changed are kept, so columns that did not move between
+// the two cost next to nothing.
+class SnapshotDelta {
+public:
+    // Replace this delta with the difference from `base` to `target`
+    void encode(const Snapshot& base, const Snapshot& target);
+    // Same as encoding against Snapshot::capture(game), without the
+    // intermediate copy
+    void encode(const Snapshot& base, const Game& game);
+
+    // Rebuild the target into `out`, reusing its memory. `base` must be
+    // the snapshot this delta was encoded against; returns false if the
+    // delta is empty or does not fit it.
+    bool apply(const Snapshot& base, Snapshot& out) const;
+
+    bool empty() const { return bytes.empty(); }
+    void clear() { bytes.clear(); }
+    std::size_t size() const { return bytes.size(); }
+    std::size_t capacity() const { return bytes.capacity(); }
+    // Size of the snapshot this delta rebuilds; 0 if empty
+    std::size_t getTargetSize() const;
+
+private:
+    std::vector<std::uint8_t> bytes;
+};
+
+// A snapshot file mapped read-only into memory. restore() copies the
+// columns straight out of the mapping, so a large checkpoint costs one
+// pass over its pages. Falls back to reading the file where mmap is not
+// available.
+class MappedSnapshot {
+public:
+    MappedSnapshot() = default;
+    explicit MappedSnapshot(const std::string& path) { open(path); }
+    ~MappedSnapshot() { close(); }
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+    MappedSnapshot(MappedSnapshot&& other) noexcept;
+    MappedSnapshot& operator=(MappedSnapshot&& other) noexcept;
+
+    // False if the file cannot be mapped or is not a valid snapshot
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return length != 0; }
+
+    const std::uint8_t* data() const { return mapped; }
+    std::size_t size() const { return length; }
+
+    std::uint64_t getChecksum() const;
+    bool restore(Game& game) const;
+
+private:
+    const std::uint8_t* mapped = nullptr;
+    std::size_t length = 0;
+    bool ownsMapping = false;           // false when reading into `fallback`
+    std::vector<std::uint8_t> fallback;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_SNAPSHOT_HXX
@@ -0,0 +1,80 @@
+#ifndef STARSHIP_SOAK_HXX
+#define STARSHIP_SOAK_HXX
+
+#include "bot.hxx"
+#include "game.hxx"
+#include "input.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace starship {
+
+// End-to-end load scenarios. Each one plays a full Game at the default
+// 800x600 for a fixed number of ticks, driven by a BotPlayer plus
+// whatever pressure the scenario adds (extra spawns, forced power-ups),
+// and reports throughput, peak entity counts, heap and tick latency
+// tails. Runs are seeded, so the same seed gives the same checksum.
+struct SoakScenario {
+    // Extra state a scenario's hooks may use
+    struct Context {
+        Game& game;
+        BotPlayer& bot;
+        std::mt19937& rng;    // Seeded per run, separate from the game's
+        std::uint64_t tick;   // Ticks run so far
+    };
+
+    std::string name;
+    std::string description;
+    std::uint64_t defaultTicks;
+
+    // Called once before the first tick
+    std::function<void(Context&)> setup;
+    // Called before every tick: may add load to the game, returns the input
+    std::function<InputMask(Context&)> drive;
+};
+
+struct SoakReport {
+    std::string name;
+    std::uint32_t seed = 0;
+    std::uint64_t ticks = 0;
+    double seconds = 0.0;           // Wall time spent in Game::step
+    double ticksPerSecond = 0.0;
+
+    std::size_t peakAsteroids = 0;
+    std::size_t peakProjectiles = 0;
+    std::size_t peakPowerUps = 0;
+
+    // Heap high-water mark and ticks that allocated; zero unless the
+    // program links starship_alloc_hooks
+    std::uint64_t peakLiveBytes = 0;
+    std::uint64_t allocatingTicks = 0;
+
+    // Latency of one Game::step, in nanoseconds
+    std::uint64_t tickP50 = 0;
+    std::uint64_t tickP99 = 0;
+    std::uint64_t tickP999 = 0;
+    std::uint64_t tickMax = 0;
+
+    int score = 0;                  // Final score of the current round
+    int maxLevel = 0;
+    int deaths = 0;                 // Rounds that ended in game over
+    std::uint64_t checksum = 0;     // Game::checksum after the last tick
+};
+
+// asteroidStorm, splittingCascade, powerUpFlood and botSurvival
+const std::vector<SoakScenario>& getSoakScenarios();
+
+// Null if no scenario has that name
+const SoakScenario* findSoakScenario(const std::string& name);
+
+// Play `scenario` from a fresh Game(800, 600, seed) for `ticks` ticks,
+// or its default length if 0
+SoakReport runSoak(const SoakScenario& scenario, std::uint32_t seed, std::uint64_t ticks = 0);
+
+} // namespace starship
+
+#endif // STARSHIP_SOAK_HXX
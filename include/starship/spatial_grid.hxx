@@ -0,0 +1,114 @@
+#ifndef STARSHIP_SPATIAL_GRID_HXX
+#define STARSHIP_SPATIAL_GRID_HXX
+
+#include "Vector2D.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+// Uniform spatial hash used as the collision broad phase.
+// Items are bucketed by the cell that contains their centre. The table is
+// rebuilt every tick with a counting sort, so its buffers are reused and
+// stop growing once they have seen the peak entity count.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 40.0f);
+
+    void setCellSize(float size);
+    float getCellSize() const { return cellSize; }
+
+    // Start a rebuild; expectedCount is only a capacity hint
+    void clear(std::size_t expectedCount = 0);
+
+    // Size every buffer for up to `count` items, so builds that stay
+    // within it never allocate
+    void reserve(std::size_t count);
+
+    // Add an item. Ids are caller-defined, usually an index into a vector.
+    void insert(std::uint32_t id, const Vector2D& pos, float radius);
+
+    // Sort the inserted items into buckets; call before querying
+    void build();
+
+    // Rebuild straight from entity columns, inserting every entry whose
+    // active bit is set with its index as the id. Replaces clear/insert/build.
+    void build(const float* x, const float* y, const float* radius,
+               const std::uint8_t* flags, std::uint8_t activeMask, std::size_t count);
+
+    std::size_t size() const { return sortedIds.size(); }
+    float getMaxRadius() const { return maxRadius; }
+
+    // Visit each item whose circle may overlap the circle (center, range).
+    // Every item is reported at most once; callers do the exact test.
+    template <typename Fn>
+    void query(const Vector2D& center, float range, Fn&& fn) const {
+        float reach = range + maxRadius;
+        queryBox(center.x - reach, center.y - reach,
+                 center.x + reach, center.y + reach, fn);
+    }
+
+private:
+    float cellSize;
+    float inverseCellSize;
+    float maxRadius;
+    std::uint32_t bucketMask;
+
+    // Items as inserted
+    std::vector<std::uint32_t> pendingIds;
+    std::vector<std::uint64_t> pendingCells;
+
+    // Bucket of each pending item, computed once per build
+    std::vector<std::uint32_t> pendingBuckets;
+
+    // Items grouped by bucket, bucketStart has bucketCount + 1 entries
+    std::vector<std::uint32_t> bucketStart;
+    std::vector<std::uint32_t> sortedIds;
+    std::vector<std::uint64_t> sortedCells;
+
+    void sizeTable(std::size_t count);
+    void scatter();
+
+    std::int32_t cellCoord(float v) const;
+
+    static std::uint64_t packCell(std::int32_t cx, std::int32_t cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint32_t>(cy);
+    }
+
+    std::uint32_t bucketFor(std::uint64_t cell) const {
+        std::uint32_t cx = static_cast<std::uint32_t>(cell >> 32);
+        std::uint32_t cy = static_cast<std::uint32_t>(cell);
+        return ((cx * 73856093u) ^ (cy * 19349663u)) & bucketMask;
+    }
+
+    // Items whose centre cell lies inside the box of cells covering
+    // [minX, maxX] x [minY, maxY]
+    template <typename Fn>
+    void queryBox(float minX, float minY, float maxX, float maxY, Fn& fn) const {
+        if (sortedIds.empty()) return;
+
+        std::int32_t x0 = cellCoord(minX);
+        std::int32_t y0 = cellCoord(minY);
+        std::int32_t x1 = cellCoord(maxX);
+        std::int32_t y1 = cellCoord(maxY);
+
+        for (std::int32_t cy = y0; cy <= y1; ++cy) {
+            for (std::int32_t cx = x0; cx <= x1; ++cx) {
+                std::uint64_t cell = packCell(cx, cy);
+                std::uint32_t bucket = bucketFor(cell);
+                for (std::uint32_t k = bucketStart[bucket]; k < bucketStart[bucket + 1]; ++k) {
+                    // Buckets are shared by several cells; skip the others
+                    if (sortedCells[k] == cell) {
+                        fn(sortedIds[k]);
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // namespace starship
+
+#endif // STARSHIP_SPATIAL_GRID_HXX
@@ -0,0 +1,58 @@
+#ifndef STARSHIP_SPSC_QUEUE_HXX
+#define STARSHIP_SPSC_QUEUE_HXX
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace starship {
+
+// Bounded lock-free FIFO between exactly one producer thread and one
+// consumer thread. Storage is inline; push fails rather than blocking
+// when the queue is full. Capacity must be a power of two.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer: false if the queue is full
+    bool tryPush(const T& value) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) return false;
+        items[t & (Capacity - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: false if the queue is empty
+    bool tryPop(T& value) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        value = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while the other side is active
+    std::size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> items;
+    // Counters only grow; the slot is the counter modulo Capacity
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_SPSC_QUEUE_HXX
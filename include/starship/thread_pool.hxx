@@ -0,0 +1,90 @@
+#ifndef STARSHIP_THREAD_POOL_HXX
+#define STARSHIP_THREAD_POOL_HXX
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace starship {
+
+// Fixed-size work-stealing pool for data-parallel loops.
+// Each thread owns a task deque: it pops its own work from the back and
+// steals from the front of the others when it runs dry. The thread that
+// calls parallelFor takes part in the work, so a pool of N threads starts
+// N - 1 workers, and a pool of one runs everything inline.
+class ThreadPool {
+public:
+    // 0 picks std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads doing work during parallelFor, the caller included
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // Call fn(begin, end) over [0, count) in chunks of at most `grain`
+    // items and return once every chunk has finished. Chunks may run in
+    // any order on any thread, so fn must only write to its own range.
+    // fn must not throw. Nested calls from inside fn are allowed.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grain, Fn&& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (queues.size() == 1 || count <= grain) {
+            fn(std::size_t(0), count);
+            return;
+        }
+        using Callable = typename std::remove_reference<Fn>::type;
+        run(&invoke<Callable>, const_cast<void*>(static_cast<const void*>(&fn)), count, grain);
+    }
+
+private:
+    // Type-erased chunk call; avoids a std::function allocation per loop
+    using TaskFn = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    struct Task {
+        TaskFn fn;
+        void* context;
+        std::size_t begin;
+        std::size_t end;
+        std::atomic<std::size_t>* remaining;  // Chunks left in this loop
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Slot 0 is shared by callers outside the pool; workers own 1..N-1
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<std::size_t> queued;  // Tasks sitting in any queue
+    bool stopping;
+
+    template <typename Callable>
+    static void invoke(void* context, std::size_t begin, std::size_t end) {
+        (*static_cast<Callable*>(context))(begin, end);
+    }
+
+    void run(TaskFn fn, void* context, std::size_t count, std::size_t grain);
+    bool tryRunOne(std::size_t self);
+    bool popLocal(std::size_t self, Task& task);
+    bool steal(std::size_t self, Task& task);
+    void workerLoop(std::size_t self);
+    std::size_t currentSlot() const;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_THREAD_POOL_HXX
@@ -0,0 +1,126 @@
+#ifndef STARSHIP_TICK_PROFILER_HXX
+#define STARSHIP_TICK_PROFILER_HXX
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set to 0 (CMake: -DSTARSHIP_ENABLE_PROFILING=OFF) to compile the tick
+// timers out entirely; the profile then stays empty
+#ifndef STARSHIP_PROFILING
+#define STARSHIP_PROFILING 1
+#endif
+
+namespace starship {
+
+// Parts of a tick that are timed separately. UPDATE is the whole of
+// Game::update, so it also covers the player and cooldowns in between.
+// TIMERS is the timer wheel firing expirations. SECTORS moves the active
+// region and only runs with sectors on. INPUT is applyInput, timed by
+// Game::step only.
+enum class TickPhase : std::uint8_t {
+    UPDATE,
+    INTEGRATE,
+    TIMERS,
+    SECTORS,
+    COLLISIONS,
+    RELEASE,
+    SPAWN,
+    LEVEL,
+    INPUT,
+    COUNT
+};
+
+constexpr std::size_t TICK_PHASE_COUNT = static_cast<std::size_t>(TickPhase::COUNT);
+
+const char* getPhaseName(TickPhase phase);
+
+// Latency histogram with log-linear buckets. Each power of two is split
+// into 8 sub-buckets, so a percentile is within 12.5% of the true value.
+// Recording is a bit scan and an increment. Values from 2^40 ns (about 18
+// minutes) up share the last bucket.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_BITS = 40;
+    static constexpr std::size_t BUCKET_COUNT = (MAX_BITS - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    void record(std::uint64_t nanos);
+
+    std::uint64_t getCount() const { return count; }
+    std::uint64_t getMin() const { return count > 0 ? min : 0; }
+    std::uint64_t getMax() const { return max; }
+    double getMean() const { return count > 0 ? static_cast<double>(total) / static_cast<double>(count) : 0.0; }
+
+    // Upper edge of the bucket holding the p-th percentile (0-100), capped
+    // at the largest value seen; 0 when empty
+    std::uint64_t percentile(double p) const;
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+private:
+    // Empty until the first sample, so idle histograms cost no memory
+    std::vector<std::uint32_t> buckets;
+    std::uint64_t count = 0;
+    std::uint64_t total = 0;
+    std::uint64_t min = 0;
+    std::uint64_t max = 0;
+
+    static std::size_t bucketOf(std::uint64_t nanos);
+    static std::uint64_t upperEdge(std::size_t bucket);
+};
+
+// One histogram per tick phase
+struct TickProfile {
+    std::array<LatencyHistogram, TICK_PHASE_COUNT> phases;
+
+    const LatencyHistogram& operator[](TickPhase phase) const {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+    LatencyHistogram& operator[](TickPhase phase) { return phases[static_cast<std::size_t>(phase)]; }
+
+    void reset() {
+        for (LatencyHistogram& h : phases) h.reset();
+    }
+};
+
+// Times its own scope into a histogram; does nothing if given null
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(LatencyHistogram* histogram)
+        : histogram(histogram) {
+        if (histogram) start = std::chrono::steady_clock::now();
+    }
+    ~ScopedPhaseTimer() {
+        if (histogram) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            histogram->record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    LatencyHistogram* histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace starship
+
+// Time the rest of the enclosing scope into `histogram` (a pointer, null
+// to skip). Expands to nothing when profiling is compiled out.
+#if STARSHIP_PROFILING
+#define STARSHIP_PROFILE_CONCAT_(a, b) a##b
+#define STARSHIP_PROFILE_CONCAT(a, b) STARSHIP_PROFILE_CONCAT_(a, b)
+#define STARSHIP_PROFILE_SCOPE(histogram) \
+    ::starship::ScopedPhaseTimer STARSHIP_PROFILE_CONCAT(profileTimer_, __LINE__)(histogram)
+#else
+#define STARSHIP_PROFILE_SCOPE(histogram) ((void)0)
+#endif
+
+#endif // STARSHIP_TICK_PROFILER_HXX
@@ -0,0 +1,87 @@
+#ifndef STARSHIP_TIMER_WHEEL_HXX
+#define STARSHIP_TIMER_WHEEL_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace starship {
+
+// Hierarchical timing wheel keyed on tick number. A timer is scheduled
+// once, for the tick it should fire on, and costs nothing until then:
+// advancing the clock touches only the slot for each new tick plus, every
+// 64 ticks, one slot of the next level up, whose timers move down a level.
+// Stretches where the lower levels are empty are skipped outright.
+// Four levels of 64 slots cover 2^24 ticks (over three days at 60 Hz);
+// later deadlines wait in an overflow list.
+//
+// Timers carry a caller-defined kind, id and generation instead of a
+// callback. There is no cancel: callers check on firing whether the
+// target still exists (for entities, that the handle generation still
+// matches), so a timer for something already gone fires harmlessly.
+//
+// Nodes come from a pool that keeps its memory, so once it has seen the
+// peak number of pending timers, scheduling and firing never allocate.
+class TimerWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;
+
+    struct Timer {
+        std::uint64_t deadline;     // Tick it fires on
+        std::uint32_t kind;
+        std::uint32_t id;
+        std::uint32_t generation;
+    };
+
+    // Start empty at tick `now`
+    explicit TimerWheel(std::uint64_t now = 0);
+
+    // Drop every timer and restart the clock at `now`
+    void reset(std::uint64_t now);
+
+    // Fire on `deadline`, or on the next advance if that has already passed
+    void schedule(std::uint64_t deadline, std::uint32_t kind, std::uint32_t id, std::uint32_t generation = 0);
+
+    // Move the clock to `now`, appending every timer due by then to
+    // `fired`. Timers due on the same tick come out in no set order.
+    void advance(std::uint64_t now, std::vector<Timer>& fired);
+
+    std::uint64_t getCurrentTick() const { return current; }
+    std::size_t size() const { return pending; }
+    bool empty() const { return pending == 0; }
+
+    // Pool room for `count` pending timers
+    void reserve(std::size_t count) { nodes.reserve(count); }
+
+private:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+
+    struct Node {
+        Timer timer;
+        std::uint32_t next;
+    };
+
+    std::uint64_t current;
+    std::size_t pending;
+
+    // Slot lists are singly linked through the node pool
+    std::vector<Node> nodes;
+    std::uint32_t freeList;
+    std::uint32_t slots[LEVELS][SLOTS];
+    std::uint32_t overflow;
+    // Timers filed at each level, so advance can skip empty stretches
+    std::size_t levelCounts[LEVELS];
+
+    // File node `index` by its deadline relative to the current tick,
+    // treating it as due no earlier than `earliest`
+    void place(std::uint32_t index, std::uint64_t earliest);
+    // Re-file every node of a list after the clock has moved; `level` is
+    // the one the list belongs to, LEVELS for the overflow list
+    void cascade(std::uint32_t& head, unsigned level);
+};
+
+} // namespace starship
+
+#endif // STARSHIP_TIMER_WHEEL_HXX
@@ -0,0 +1,63 @@
+#ifndef STARSHIP_TRIPLE_BUFFER_HXX
+#define STARSHIP_TRIPLE_BUFFER_HXX
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace starship {
+
+// Lock-free hand-off of the latest value from one producer thread to one
+// consumer thread. There are three slots: the producer owns one, the
+// consumer owns one, and the third holds the most recent publish. Neither
+// side ever waits; a consumer that falls behind simply skips to the
+// newest value, and a stalled consumer never holds up the producer.
+//
+// Slots are reused, so a T holding vectors keeps its capacity and steady
+// publishing does not allocate.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(1), writeIndex(0), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer: slot to fill before the next publish(). It holds whatever
+    // was written there a few publishes ago, not the latest value.
+    T& writeBuffer() { return slots[writeIndex]; }
+
+    // Producer: make the write slot the latest value and take a free one
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(writeIndex | FRESH),
+                                                std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Consumer: pick up the latest publish, if there is one since the last
+    // call. Returns whether readBuffer() changed.
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        std::uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Consumer: the value picked up by the last successful update()
+    const T& readBuffer() const { return slots[readIndex]; }
+
+private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH = 0x4;
+
+    std::array<T, 3> slots;
+    // Index of the shared slot, plus FRESH until the consumer takes it
+    alignas(64) std::atomic<std::uint8_t> middle;
+    // Each touched by one side only
+    alignas(64) std::uint8_t writeIndex;
+    alignas(64) std::uint8_t readIndex;
+};
+
+} // namespace starship
+
+#endif // STARSHIP_TRIPLE_BUFFER_HXX
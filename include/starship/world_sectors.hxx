@@ -0,0 +1,142 @@
+#ifndef STARSHIP_WORLD_SECTORS_HXX
+#define STARSHIP_WORLD_SECTORS_HXX
+
+#include "Vector2D.hxx"
+#include "command_buffer.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace starship {
+
+// Reads and writes the private pool state for snapshot.hxx
+struct SnapshotAccess;
+
+// Level of detail for worlds much larger than the view. The world is cut
+// into square sectors, and only the ones within `activeRadius` of the
+// player's sector (diagonals included) are simulated every tick. Asteroids
+// anywhere else are parked here, dormant: they are not integrated or
+// collision-checked and cost nothing per tick.
+//
+// Asteroids fly in straight lines at constant spin, so a dormant one's
+// state at any tick follows from the state it was parked with and the
+// tick it was parked on. Game brings it forward only when it crosses into
+// another sector, which is when it can next matter, and hands it back to
+// the live columns once its sector comes into range.
+//
+// Slots are pooled and keep their memory; dormant asteroids are linked
+// per sector, so waking a sector costs only what is in it.
+class WorldSectors {
+public:
+    static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+    static constexpr float NEVER = std::numeric_limits<float>::infinity();
+
+    // Cut a width x height world into squares of `sectorSize`; 0 turns
+    // sectors off. Drops every dormant asteroid.
+    void configure(float width, float height, float sectorSize, int activeRadius);
+
+    bool isEnabled() const { return sectorSize > 0.0f; }
+    float getSectorSize() const { return sectorSize; }
+    int getActiveRadius() const { return activeRadius; }
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+
+    // Sector holding (x, y). Points off the world belong to the nearest
+    // edge sector.
+    std::uint32_t sectorAt(float x, float y) const;
+    // At most `radius` sectors from `center` along each axis
+    bool isWithin(std::uint32_t sector, std::uint32_t center, int radius) const;
+
+    // Player's sector as of Game's last refresh; NONE before the first
+    std::uint32_t getCenter() const { return center; }
+    void setCenter(std::uint32_t sector) { center = sector; }
+    bool isActive(std::uint32_t sector) const {
+        return center != NONE && isWithin(sector, center, activeRadius);
+    }
+
+    // Call fn(sector) for every sector within `radius` of `center`
+    template <typename Fn>
+    void forEachWithin(std::uint32_t center, int radius, Fn&& fn) const {
+        const int cx = static_cast<int>(center % static_cast<std::uint32_t>(columns));
+        const int cy = static_cast<int>(center / static_cast<std::uint32_t>(columns));
+        for (int y = clampRow(cy - radius); y <= clampRow(cy + radius); ++y) {
+            for (int x = clampColumn(cx - radius); x <= clampColumn(cx + radius); ++x) {
+                fn(static_cast<std::uint32_t>(y * columns + x));
+            }
+        }
+    }
+
+    // Dormant asteroids currently parked
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Park an asteroid whose state holds at `tick`; returns its slot
+    std::uint32_t park(const CommandBuffer::AsteroidSpawn& asteroid, std::uint64_t tick);
+    // Take a dormant asteroid out, as it is at `tick`
+    CommandBuffer::AsteroidSpawn unpark(std::uint32_t slot, std::uint64_t tick, float timestep);
+    // Drop a dormant asteroid
+    void remove(std::uint32_t slot);
+    // Move a dormant asteroid's state forward to `tick`, filing it under
+    // the sector it is in by then
+    void advance(std::uint32_t slot, std::uint64_t tick, float timestep);
+    // Drop every dormant asteroid; slots keep their memory
+    void clear();
+    void reserve(std::size_t n);
+
+    // Seconds past its parked state until the asteroid enters another
+    // sector, or NEVER
+    float secondsToLeaveSector(std::uint32_t slot) const;
+    // Where a dormant asteroid is at `tick`
+    Vector2D positionAt(std::uint32_t slot, std::uint64_t tick, float timestep) const;
+
+    // Walk a sector's dormant asteroids: firstIn, then nextIn until NONE
+    std::uint32_t firstIn(std::uint32_t sector) const { return heads[sector]; }
+    std::uint32_t nextIn(std::uint32_t slot) const { return next[slot]; }
+
+    // Slots, free ones included, and whether one holds an asteroid
+    std::size_t slotCount() const { return sectors.size(); }
+    bool isParked(std::uint32_t slot) const { return slot < sectors.size() && sectors[slot] != NONE; }
+    // Bumped each time a slot is freed, so a stale wake-up can be told apart
+    std::uint32_t generationOf(std::uint32_t slot) const { return generations[slot]; }
+
+    // Dormant asteroid columns, indexed by slot. x, y and rotation hold as
+    // of parkedAt; sectors is NONE for a free slot.
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> rotation;
+    std::vector<float> rotationSpeed;
+    std::vector<Asteroid::Size> sizes;
+    std::vector<std::uint16_t> shapeVariants;
+    std::vector<std::uint64_t> parkedAt;
+    std::vector<std::uint32_t> sectors;
+
+private:
+    friend struct SnapshotAccess;
+
+    float sectorSize = 0.0f;
+    int activeRadius = 0;
+    int columns = 0;
+    int rows = 0;
+    std::uint32_t center = NONE;
+    std::size_t count = 0;
+
+    std::vector<std::uint32_t> generations;
+    // Doubly linked per sector, so unlinking any slot is O(1)
+    std::vector<std::uint32_t> next;
+    std::vector<std::uint32_t> prev;
+    std::vector<std::uint32_t> heads;
+    std::vector<std::uint32_t> freeSlots;
+
+    int clampColumn(int x) const { return x < 0 ? 0 : (x >= columns ? columns - 1 : x); }
+    int clampRow(int y) const { return y < 0 ? 0 : (y >= rows ? rows - 1 : y); }
+    void link(std::uint32_t slot, std::uint32_t sector);
+    void unlink(std::uint32_t slot);
+    void release(std::uint32_t slot);
+};
+
+} // namespace starship
+
+#endif // STARSHIP_WORLD_SECTORS_HXX
@@ -0,0 +1,77 @@
+// Global operator new/delete that report to alloc_tracker. Built as the
+// starship_alloc_hooks object library: linking it turns tracking on for
+// the whole program, leaving it out costs nothing.
+#include "starship/alloc_tracker.hxx"
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// Each block starts with its size, padded to keep malloc's alignment
+constexpr std::size_t HEADER = alignof(std::max_align_t) > sizeof(std::size_t)
+                                   ? alignof(std::max_align_t)
+                                   : sizeof(std::size_t);
+
+void* allocate(std::size_t size) noexcept {
+    void* block = std::malloc(size + HEADER);
+    if (!block) return nullptr;
+    *static_cast<std::size_t*>(block) = size;
+    starship::alloc::detail::onAllocate(size);
+    return static_cast<unsigned char*>(block) + HEADER;
+}
+
+void release(void* pointer) noexcept {
+    if (!pointer) return;
+    void* block = static_cast<unsigned char*>(pointer) - HEADER;
+    starship::alloc::detail::onFree(*static_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+// Flag the hooks as present during static initialization
+[[maybe_unused]] const bool registered = (starship::alloc::detail::installed(), true);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    void* p = allocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    release(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    release(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    release(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    release(pointer);
+}
@@ -0,0 +1,127 @@
+#include "starship/alloc_tracker.hxx"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace starship {
+namespace alloc {
+
+namespace {
+
+// Slot for allocations outside any phase
+constexpr std::uint8_t UNTAGGED = static_cast<std::uint8_t>(TICK_PHASE_COUNT);
+
+// Plain data only: the hooks can run before any dynamic initialization
+struct ThreadState {
+    AllocationCounters counters[TICK_PHASE_COUNT + 1];
+    std::uint8_t phase = UNTAGGED;
+    int traps = 0;
+    bool inHandler = false;
+};
+
+thread_local ThreadState state;
+
+std::atomic<bool> hooksInstalled{false};
+std::atomic<std::uint64_t> liveBytes{0};
+std::atomic<std::uint64_t> peakLiveBytes{0};
+std::atomic<TrapHandler> trapHandler{nullptr};
+
+void defaultTrap(std::size_t bytes) {
+    std::fprintf(stderr, "starship: %zu-byte allocation inside an allocation trap\n", bytes);
+    std::abort();
+}
+
+} // namespace
+
+bool isTracking() {
+    return hooksInstalled.load(std::memory_order_relaxed);
+}
+
+TickAllocations threadCounters() {
+    TickAllocations result;
+    for (std::size_t i = 0; i < TICK_PHASE_COUNT; ++i) {
+        result.phases[i] = state.counters[i];
+        result.total += state.counters[i];
+    }
+    result.total += state.counters[UNTAGGED];
+    result.peakLiveBytes = getPeakLiveBytes();
+    return result;
+}
+
+TickAllocations since(const TickAllocations& start) {
+    TickAllocations now = threadCounters();
+    now.total = now.total - start.total;
+    for (std::size_t i = 0; i < TICK_PHASE_COUNT; ++i) {
+        now.phases[i] = now.phases[i] - start.phases[i];
+    }
+    return now;
+}
+
+std::uint64_t getLiveBytes() {
+    return liveBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t getPeakLiveBytes() {
+    return peakLiveBytes.load(std::memory_order_relaxed);
+}
+
+void resetPeak() {
+    peakLiveBytes.store(liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+PhaseScope::PhaseScope(TickPhase phase)
+    : previous(state.phase) {
+    state.phase = static_cast<std::uint8_t>(phase);
+}
+
+PhaseScope::~PhaseScope() {
+    state.phase = previous;
+}
+
+void setTrapHandler(TrapHandler handler) {
+    trapHandler.store(handler, std::memory_order_relaxed);
+}
+
+Trap::Trap() {
+    ++state.traps;
+}
+
+Trap::~Trap() {
+    --state.traps;
+}
+
+namespace detail {
+
+void installed() {
+    hooksInstalled.store(true, std::memory_order_relaxed);
+}
+
+void onAllocate(std::size_t bytes) {
+    ThreadState& s = state;
+    AllocationCounters& c = s.counters[s.phase];
+    ++c.allocations;
+    c.bytes += bytes;
+
+    std::uint64_t live = liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::uint64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+
+    // The handler may itself allocate (e.g. to log), which must not recurse
+    if (s.traps > 0 && !s.inHandler) {
+        s.inHandler = true;
+        TrapHandler handler = trapHandler.load(std::memory_order_relaxed);
+        (handler ? handler : defaultTrap)(bytes);
+        s.inHandler = false;
+    }
+}
+
+void onFree(std::size_t bytes) {
+    ++state.counters[state.phase].frees;
+    liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+} // namespace alloc
+} // namespace starship
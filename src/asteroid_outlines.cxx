@@ -0,0 +1,67 @@
+#include "starship/asteroid_outlines.hxx"
+#include "starship/render_snapshot.hxx"
+#include "starship/simd_kernels.hxx"
+#include <type_traits>
+
+namespace starship {
+
+// The kernels read and write Vector2D arrays as interleaved floats
+static_assert(sizeof(Vector2D) == 2 * sizeof(float) && std::is_standard_layout<Vector2D>::value,
+              "Vector2D must be two packed floats");
+
+void AsteroidOutlines::build(const AsteroidColumns& asteroids) {
+    const std::size_t n = asteroids.size();
+    const simd::Kernels& kernels = simd::activeKernels();
+
+    sines.resize(n);
+    cosines.resize(n);
+    kernels.sinCosDegrees(asteroids.rotation.data(), sines.data(), cosines.data(), n);
+
+    offsets.resize(n + 1);
+    std::uint32_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        offsets[i] = total;
+        total += static_cast<std::uint32_t>(
+            AsteroidShapeLibrary::getVertexCount(static_cast<int>(asteroids.sizes[i])));
+    }
+    offsets[n] = total;
+    points.resize(total);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        ShapeView shape = asteroids.shape(i);
+        kernels.transformPoints(&shape.points[0].x, &points[offsets[i]].x, shape.size(),
+                                cosines[i], sines[i], asteroids.x[i], asteroids.y[i]);
+    }
+}
+
+void AsteroidOutlines::build(const RenderSnapshot& snapshot, const AsteroidShapeLibrary& shapes) {
+    const std::size_t n = snapshot.asteroids.size();
+    const simd::Kernels& kernels = simd::activeKernels();
+
+    rotations.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        rotations[i] = snapshot.asteroids[i].rotation;
+    }
+    sines.resize(n);
+    cosines.resize(n);
+    kernels.sinCosDegrees(rotations.data(), sines.data(), cosines.data(), n);
+
+    offsets.resize(n + 1);
+    std::uint32_t total = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        offsets[i] = total;
+        total += static_cast<std::uint32_t>(
+            AsteroidShapeLibrary::getVertexCount(static_cast<int>(snapshot.asteroids[i].size)));
+    }
+    offsets[n] = total;
+    points.resize(total);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const RenderSnapshot::AsteroidState& a = snapshot.asteroids[i];
+        ShapeView shape = shapes.getShape(static_cast<int>(a.size), a.shapeVariant);
+        kernels.transformPoints(&shape.points[0].x, &points[offsets[i]].x, shape.size(),
+                                cosines[i], sines[i], a.position.x, a.position.y);
+    }
+}
+
+} // namespace starship
@@ -0,0 +1,110 @@
+#include "starship/bot.hxx"
+#include "starship/game_config.hxx"
+#include <cmath>
+
+namespace starship {
+
+namespace {
+
+// Closer than this to its target the ship holds still instead of
+// twitching left and right every tick
+constexpr float STEER_DEADBAND = 3.0f;
+
+// Asteroids further to the side than this cannot reach the ship within
+// the lookahead; falling fragments drift at most a few pixels per tick
+constexpr float THREAT_HALF_WIDTH = 160.0f;
+
+// Steepest fall checked for threats, in pixels per second
+constexpr float MAX_FALL_SPEED = 120.0f;
+
+// Distance from the walls at which a dodge turns back toward the middle
+constexpr float WALL_MARGIN = 30.0f;
+
+} // namespace
+
+InputMask BotPlayer::steerTo(float shipX, float x) {
+    if (x < shipX - STEER_DEADBAND) return INPUT_LEFT;
+    if (x > shipX + STEER_DEADBAND) return INPUT_RIGHT;
+    return INPUT_NONE;
+}
+
+InputMask BotPlayer::decide(const Game& game) {
+    if (game.isGameOver()) return restart ? INPUT_RESTART : INPUT_NONE;
+    const Starship& player = game.getPlayer();
+    if (!player.isActive()) return INPUT_NONE;
+
+    const Vector2D ship = player.getPosition();
+    const AsteroidView view = game.getAsteroids();
+    InputMask input = INPUT_NONE;
+
+    // Fire whenever an asteroid is straight above
+    RaycastHit<AsteroidHandle> hit;
+    if (game.raycast(ship, Vector2D(0.0f, -1.0f), ship.y, hit)) {
+        input |= INPUT_FIRE;
+    }
+
+    // The asteroid that would reach the ship's row soonest on its way down
+    float threatTime = LOOKAHEAD;
+    float threatX = 0.0f;
+    bool threatened = false;
+    if (!game.isShielded()) {
+        game.queryAABB(Vector2D(ship.x - THREAT_HALF_WIDTH, ship.y - LOOKAHEAD * MAX_FALL_SPEED),
+                       Vector2D(ship.x + THREAT_HALF_WIDTH, ship.y), asteroids);
+        for (const AsteroidHandle& handle : asteroids) {
+            const AsteroidRef a = view[view.find(handle)];
+            const Vector2D pos = a.getPosition();
+            const Vector2D vel = a.getVelocity();
+            float t = 0.0f;
+            if (pos.y + a.getRadius() < ship.y) {
+                if (vel.y <= 0.0f) continue;
+                t = (ship.y - a.getRadius() - pos.y) / vel.y;
+            }
+            if (t >= threatTime) continue;
+            const float x = pos.x + vel.x * t;
+            if (std::fabs(x - ship.x) < a.getRadius() + DODGE_MARGIN) {
+                threatTime = t;
+                threatX = x;
+                threatened = true;
+            }
+        }
+    }
+
+    if (threatened) {
+        // Step out from under it, turning back if a wall is in the way
+        bool goLeft = threatX > ship.x || (threatX == ship.x && ship.x > game.getWidth() / 2);
+        if (goLeft && ship.x < WALL_MARGIN) goLeft = false;
+        if (!goLeft && ship.x > game.getWidth() - WALL_MARGIN) goLeft = true;
+        return input | (goLeft ? INPUT_LEFT : INPUT_RIGHT);
+    }
+
+    // Otherwise collect a nearby power-up
+    game.nearestK(ship, 1, powerUps);
+    if (!powerUps.empty()) {
+        const PowerUpView pickups = game.getPowerUps();
+        const Vector2D pos = pickups[pickups.find(powerUps[0])].getPosition();
+        if (Vector2D::distanceSquared(ship, pos) < PICKUP_RANGE * PICKUP_RANGE) {
+            return input | steerTo(ship.x, pos.x);
+        }
+    }
+
+    // Or line up under the closest asteroid above, leading the shot
+    game.nearestK(ship, 6, asteroids);
+    float bestOffset = 0.0f;
+    bool found = false;
+    for (const AsteroidHandle& handle : asteroids) {
+        const AsteroidRef a = view[view.find(handle)];
+        const Vector2D pos = a.getPosition();
+        if (pos.y >= ship.y - a.getRadius()) continue;
+        const Vector2D vel = a.getVelocity();
+        const float flight = (ship.y - pos.y) / (DefaultGameConfig::PROJECTILE_SPEED + vel.y);
+        const float offset = pos.x + vel.x * flight - ship.x;
+        if (!found || std::fabs(offset) < std::fabs(bestOffset)) {
+            bestOffset = offset;
+            found = true;
+        }
+    }
+    if (found) return input | steerTo(ship.x, ship.x + bestOffset);
+    return input | steerTo(ship.x, game.getWidth() / 2);
+}
+
+} // namespace starship
@@ -0,0 +1,275 @@
+#include "starship/entity_bvh.hxx"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace starship {
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Distance along the unit ray (o, d) to where it enters [lo, hi] on one
+// axis, and where it leaves it; false if it never does
+bool slab(float o, float d, float lo, float hi, float& enter, float& exit) {
+    if (d == 0.0f) return o >= lo && o <= hi;
+    float inv = 1.0f / d;
+    float t0 = (lo - o) * inv;
+    float t1 = (hi - o) * inv;
+    if (t0 > t1) std::swap(t0, t1);
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    return enter <= exit;
+}
+
+// Distance along the unit ray (o, d) to the circle (c, r); 0 from inside
+float rayCircle(const Vector2D& o, const Vector2D& d, float cx, float cy, float r) {
+    float mx = o.x - cx;
+    float my = o.y - cy;
+    float c = mx * mx + my * my - r * r;
+    if (c <= 0.0f) return 0.0f;
+    float b = mx * d.x + my * d.y;
+    if (b > 0.0f) return INF;
+    float disc = b * b - c;
+    if (disc < 0.0f) return INF;
+    return -b - std::sqrt(disc);
+}
+
+// Heap order for nearestK: the worst candidate sits at the front
+bool closer(const EntityBvh::Neighbor& a, const EntityBvh::Neighbor& b) {
+    if (a.distanceSquared != b.distanceSquared) return a.distanceSquared < b.distanceSquared;
+    return a.slot < b.slot;
+}
+
+} // namespace
+
+void EntityBvh::refresh(const BodyColumns& columns) {
+    if (!stale) return;
+    if (!refit(columns)) build(columns);
+}
+
+void EntityBvh::build(const BodyColumns& columns) {
+    const std::size_t n = columns.size();
+    // The split sorts a packed copy of the centres, not slots into columns.
+    // Slots left out are recorded as holes, so refit() notices if an
+    // entity turns up in one.
+    slotIds.resize(n);
+    centres.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (columns.isActive(i)) {
+            centres.push_back(Centre{columns.x[i], columns.y[i], static_cast<std::uint32_t>(i)});
+            slotIds[i] = columns.ids[i];
+        } else {
+            slotIds[i] = BodyColumns::NO_ID;
+        }
+    }
+
+    nodes.clear();
+    if (!centres.empty()) buildNode(0, static_cast<std::uint32_t>(centres.size()));
+    items.resize(centres.size());
+    for (std::size_t k = 0; k < centres.size(); ++k) {
+        items[k] = centres[k].slot;
+    }
+    keptEnd = static_cast<std::uint32_t>(n);
+    pendingEnd = keptEnd;
+    builtPerimeter = fitNodes(columns);
+    stale = false;
+    ++builds;
+}
+
+std::uint32_t EntityBvh::buildNode(std::uint32_t begin, std::uint32_t end) {
+    const std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(Node{Box{}, begin, end - begin});
+    if (end - begin <= LEAF_SIZE) return index;
+
+    // Halve along the longer side of the centres' bounds
+    float minX = INF, minY = INF, maxX = -INF, maxY = -INF;
+    for (std::uint32_t k = begin; k < end; ++k) {
+        minX = std::min(minX, centres[k].x);
+        maxX = std::max(maxX, centres[k].x);
+        minY = std::min(minY, centres[k].y);
+        maxY = std::max(maxY, centres[k].y);
+    }
+    const std::uint32_t mid = begin + (end - begin) / 2;
+    const auto first = centres.begin();
+    if (maxX - minX >= maxY - minY) {
+        std::nth_element(first + begin, first + mid, first + end, [](const Centre& a, const Centre& b) {
+            return a.x != b.x ? a.x < b.x : a.slot < b.slot;
+        });
+    } else {
+        std::nth_element(first + begin, first + mid, first + end, [](const Centre& a, const Centre& b) {
+            return a.y != b.y ? a.y < b.y : a.slot < b.slot;
+        });
+    }
+
+    buildNode(begin, mid);
+    const std::uint32_t right = buildNode(mid, end);
+    nodes[index].start = right;
+    nodes[index].count = 0;
+    return index;
+}
+
+float EntityBvh::fitNodes(const BodyColumns& columns) {
+    // Children come after their parent, so one backward pass fits bottom-up
+    float total = 0.0f;
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        Node& node = nodes[i];
+        Box box{INF, INF, -INF, -INF};
+        if (node.isLeaf()) {
+            for (std::uint32_t k = node.start; k < node.start + node.count; ++k) {
+                const std::uint32_t slot = items[k];
+                if (!isLive(columns, slot)) continue;
+                const float r = columns.radius[slot];
+                box.minX = std::min(box.minX, columns.x[slot] - r);
+                box.minY = std::min(box.minY, columns.y[slot] - r);
+                box.maxX = std::max(box.maxX, columns.x[slot] + r);
+                box.maxY = std::max(box.maxY, columns.y[slot] + r);
+            }
+        } else {
+            const Box& a = nodes[i + 1].box;
+            const Box& b = nodes[node.start].box;
+            box = Box{std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+                      std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+        }
+        node.box = box;
+        total += box.perimeter();
+    }
+    return total;
+}
+
+bool EntityBvh::refit(const BodyColumns& columns) {
+    // Trailing slots that were trimmed stay out of the tree for good, even
+    // once the store grows over them again
+    keptEnd = std::min(keptEnd, static_cast<std::uint32_t>(columns.size()));
+    pendingEnd = static_cast<std::uint32_t>(columns.size());
+    if (pendingEnd - keptEnd > LEAF_SIZE + items.size() / PENDING_DIVISOR) return false;
+
+    // Released slots may have become holes; any other change of id means
+    // compaction moved the entities
+    for (std::uint32_t i = 0; i < keptEnd; ++i) {
+        if (columns.ids[i] != slotIds[i] && columns.ids[i] != BodyColumns::NO_ID) return false;
+    }
+    if (fitNodes(columns) > REBUILD_RATIO * builtPerimeter) return false;
+    stale = false;
+    ++refits;
+    return true;
+}
+
+void EntityBvh::reserve(std::size_t count) {
+    nodes.reserve(2 * count);
+    items.reserve(count);
+    centres.reserve(count);
+    slotIds.reserve(count);
+}
+
+EntityBvh::RayHit EntityBvh::raycast(const BodyColumns& columns, const Vector2D& origin,
+                                     const Vector2D& direction, float maxDistance) const {
+    RayHit hit;
+    const float length = direction.length();
+    if (length == 0.0f || maxDistance < 0.0f) return hit;
+    const Vector2D d = direction * (1.0f / length);
+
+    // Entry distance into a node's box, INF if the ray misses it
+    auto enter = [&](const Box& box) {
+        if (box.maxX < box.minX) return INF;
+        float t0 = 0.0f;
+        float t1 = INF;
+        if (!slab(origin.x, d.x, box.minX, box.maxX, t0, t1)) return INF;
+        if (!slab(origin.y, d.y, box.minY, box.maxY, t0, t1)) return INF;
+        return t0;
+    };
+
+    struct Entry {
+        std::uint32_t node;
+        float t;
+    };
+    float best = maxDistance;
+    auto test = [&](std::uint32_t slot) {
+        float t = rayCircle(origin, d, columns.x[slot], columns.y[slot], columns.radius[slot]);
+        if (t == INF) return;
+        if (t < best || (t == best && slot < hit.slot)) {
+            best = t;
+            hit.slot = slot;
+            hit.distance = t;
+        }
+    };
+    for (std::uint32_t slot = keptEnd; slot < pendingEnd; ++slot) {
+        if (columns.isActive(slot)) test(slot);
+    }
+    if (nodes.empty()) return hit;
+
+    Entry stack[STACK_DEPTH];
+    std::size_t top = 0;
+    const float rootT = enter(nodes[0].box);
+    if (rootT <= best) stack[top++] = Entry{0, rootT};
+
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        if (entry.t > best) continue;
+        const Node& node = nodes[entry.node];
+        if (node.isLeaf()) {
+            for (std::uint32_t k = node.start; k < node.start + node.count; ++k) {
+                if (isLive(columns, items[k])) test(items[k]);
+            }
+            continue;
+        }
+        // Nearer child on top so it is searched first and tightens `best`
+        Entry left{entry.node + 1, enter(nodes[entry.node + 1].box)};
+        Entry right{node.start, enter(nodes[node.start].box)};
+        if (left.t > right.t) std::swap(left, right);
+        if (right.t <= best) stack[top++] = right;
+        if (left.t <= best) stack[top++] = left;
+    }
+    return hit;
+}
+
+void EntityBvh::nearestK(const BodyColumns& columns, const Vector2D& point, std::size_t k,
+                         std::vector<Neighbor>& out) const {
+    out.clear();
+    if (k == 0) return;
+
+    // Max-heap of the best k so far, the worst at the front
+    auto offer = [&](std::uint32_t slot) {
+        Neighbor candidate{slot, Vector2D::distanceSquared(point, columns.position(slot))};
+        if (out.size() < k) {
+            out.push_back(candidate);
+            std::push_heap(out.begin(), out.end(), closer);
+        } else if (closer(candidate, out.front())) {
+            std::pop_heap(out.begin(), out.end(), closer);
+            out.back() = candidate;
+            std::push_heap(out.begin(), out.end(), closer);
+        }
+    };
+    for (std::uint32_t slot = keptEnd; slot < pendingEnd; ++slot) {
+        if (columns.isActive(slot)) offer(slot);
+    }
+
+    struct Entry {
+        std::uint32_t node;
+        float distanceSquared;
+    };
+    Entry stack[STACK_DEPTH];
+    std::size_t top = 0;
+    if (!nodes.empty()) stack[top++] = Entry{0, nodes[0].box.distanceSquared(point.x, point.y)};
+
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        if (out.size() == k && entry.distanceSquared > out.front().distanceSquared) continue;
+        const Node& node = nodes[entry.node];
+        if (node.isLeaf()) {
+            for (std::uint32_t i = node.start; i < node.start + node.count; ++i) {
+                if (isLive(columns, items[i])) offer(items[i]);
+            }
+            continue;
+        }
+        // Nearer child on top
+        Entry left{entry.node + 1, nodes[entry.node + 1].box.distanceSquared(point.x, point.y)};
+        Entry right{node.start, nodes[node.start].box.distanceSquared(point.x, point.y)};
+        if (left.distanceSquared > right.distanceSquared) std::swap(left, right);
+        stack[top++] = right;
+        stack[top++] = left;
+    }
+    std::sort_heap(out.begin(), out.end(), closer);
+}
+
+} // namespace starship
@@ -1,28 +1,231 @@
 #include "starship/game.hxx"
+#include "starship/simd_kernels.hxx"
+#include "starship/collision_math.hxx"
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
 
 namespace starship {
 
+namespace {
+
+// FNV-1a over raw bytes; used by Game::checksum
+class StateHasher {
+private:
+    std::uint64_t hash = 14695981039346656037ull;
+
+public:
+    void bytes(const void* data, std::size_t size) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ p[i]) * 1099511628211ull;
+        }
+    }
+
+    template <typename T>
+    void value(const T& v) { bytes(&v, sizeof(T)); }
+
+    template <typename T>
+    void column(const std::vector<T>& v) {
+        value(v.size());
+        if (!v.empty()) bytes(v.data(), v.size() * sizeof(T));
+    }
+
+    void body(const BodyColumns& c) {
+        column(c.x);
+        column(c.y);
+        column(c.vx);
+        column(c.vy);
+        column(c.radius);
+        column(c.flags);
+    }
+
+    std::uint64_t result() const { return hash; }
+};
+
+// Chunk sizes for parallel loops: large enough that one chunk outweighs
+// the cost of handing it to another thread
+constexpr std::size_t INTEGRATE_GRAIN = 16384;
+constexpr std::size_t COLLISION_GRAIN = 512;
+constexpr std::size_t RESOLVE_GRAIN = 256;
+
+// Below this many asteroids checkCollisions scans instead of building the grid
+constexpr std::size_t LINEAR_SCAN_LIMIT = 32;
+
+// What a timer on the wheel retires. Its id is an entity id for the two
+// stores and a PowerUp::Type for effects.
+enum TimerKind : std::uint32_t {
+    TIMER_PROJECTILE,
+    TIMER_POWER_UP,
+    TIMER_EFFECT,
+    TIMER_DORMANT
+};
+
+// Entities this far below the world are gone
+constexpr float EXIT_MARGIN = 50.0f;
+
+// Latest a dormant asteroid's wake-up is put off; one that would take
+// longer to change sector is looked at again then
+constexpr float MAX_WAKE_TICKS = 1 << 30;
+
+// Slack when converting seconds to ticks, so 2 s at 60 Hz is 120 ticks
+// and not 121 from float rounding
+constexpr float TICK_EPSILON = 1e-3f;
+
+// Deactivate the entity a timer was set for, unless it is already gone
+template <typename Columns>
+void expireEntity(Columns& columns, const TimerWheel::Timer& timer) {
+    std::uint32_t slot = columns.handles.find(timer.id, timer.generation);
+    if (slot != HandleTable::NO_SLOT) columns.setActive(slot, false);
+}
+
+// Put every live entity's expiry back on the wheel
+template <typename Columns>
+void scheduleExpiries(TimerWheel& timers, const Columns& columns, TimerKind kind) {
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        if (!columns.isActive(i)) continue;
+        std::uint32_t id = columns.ids[i];
+        timers.schedule(columns.expiresAt[i], kind, id, columns.handles.generationOf(id));
+    }
+}
+
+float cross(const Vector2D& a, const Vector2D& b) {
+    return a.x * b.y - a.y * b.x;
+}
+
+// Like sweptCircleTime (collision_math.hxx), for the segment start..end
+// against a closed outline. The shot is
+// treated as a point; at 0.3 px its radius is below the outline's detail.
+float sweptPolygonTime(const Vector2D& start, const Vector2D& end, ShapeView outline) {
+    const std::size_t n = outline.size();
+    bool inside = false;
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+        const Vector2D& a = outline[i];
+        const Vector2D& b = outline[j];
+        if ((a.y > start.y) != (b.y > start.y) &&
+            start.x < (b.x - a.x) * (start.y - a.y) / (b.y - a.y) + a.x) {
+            inside = !inside;
+        }
+    }
+    if (inside) return 0.0f;
+    
+    // Earliest edge crossing: start + t * d == a + u * e
+    const Vector2D d = end - start;
+    float best = NO_IMPACT;
+    for (std::size_t i = 0, j = n - 1; i < n; j = i++) {
+        const Vector2D e = outline[i] - outline[j];
+        float denom = cross(d, e);
+        if (denom == 0.0f) continue;
+        const Vector2D w = outline[j] - start;
+        float t = cross(w, e) / denom;
+        float u = cross(w, d) / denom;
+        if (t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f && t < best) best = t;
+    }
+    return best;
+}
+
+// Call fn(begin, end) over [0, count), on the pool if there is one
+template <typename Fn>
+void forEachChunk(ThreadPool* pool, std::size_t count, std::size_t grain, Fn&& fn) {
+    if (pool) {
+        pool->parallelFor(count, grain, fn);
+    } else if (count > 0) {
+        fn(std::size_t(0), count);
+    }
+}
+
+// Bodies of the Game spatial queries, shared by the asteroid and
+// power-up overloads
+template <typename Columns>
+std::size_t collectRadius(EntityBvh& bvh, const Columns& columns, const Vector2D& center, float radius,
+                          std::vector<typename Columns::Handle>& out) {
+    bvh.refresh(columns);
+    out.clear();
+    bvh.queryRadius(columns, center, radius, [&](std::uint32_t slot) {
+        out.push_back(handleAt(columns, slot));
+    });
+    return out.size();
+}
+
+template <typename Columns>
+std::size_t collectBox(EntityBvh& bvh, const Columns& columns, const Vector2D& min, const Vector2D& max,
+                       std::vector<typename Columns::Handle>& out) {
+    bvh.refresh(columns);
+    out.clear();
+    bvh.queryBox(columns, min, max, [&](std::uint32_t slot) {
+        out.push_back(handleAt(columns, slot));
+    });
+    return out.size();
+}
+
+template <typename Columns>
+bool castRay(EntityBvh& bvh, const Columns& columns, const Vector2D& origin, const Vector2D& direction,
+             float maxDistance, RaycastHit<typename Columns::Handle>& hit) {
+    bvh.refresh(columns);
+    EntityBvh::RayHit found = bvh.raycast(columns, origin, direction, maxDistance);
+    if (found.slot == EntityBvh::NONE) return false;
+    hit.handle = handleAt(columns, found.slot);
+    hit.distance = found.distance;
+    hit.point = origin + direction.normalized() * found.distance;
+    return true;
+}
+
+template <typename Columns>
+std::size_t collectNearest(EntityBvh& bvh, const Columns& columns, const Vector2D& point, std::size_t k,
+                           std::vector<EntityBvh::Neighbor>& scratch,
+                           std::vector<typename Columns::Handle>& out) {
+    bvh.refresh(columns);
+    bvh.nearestK(columns, point, k, scratch);
+    out.clear();
+    for (const EntityBvh::Neighbor& n : scratch) {
+        out.push_back(handleAt(columns, n.slot));
+    }
+    return out.size();
+}
+
+} // namespace
+
 Game::Game(float width, float height)
+    : Game(width, height, std::random_device{}()) {}
+
+Game::Game(float width, float height, std::uint32_t seed)
     : player(Vector2D(width / 2, height / 2)),
       score(0),
       level(1),
       width(width),
       height(height),
-      rng(std::random_device{}()),
+      seed(seed),
+      randomTick(0),
+      spawnSerial(0),
+      asteroidGrid(2.0f * Asteroid::getRadiusForSize(Asteroid::Size::LARGE)),
+      outlinesDirty(true),
+      polygonCollisions(false),
       shootCooldown(0.0f),
       spawnTimer(0.0f),
-      shieldTimer(0.0f),
-      multiShotTimer(0.0f),
-      rapidFireTimer(0.0f),
-      speedBoostTimer(0.0f),
-      gameOver(false) {
-    spawnAsteroids(8);
+      effectEnds{},
+      activeEffects(0),
+      gameOver(false),
+      timerTick(0),
+      tickCarry(0.0f),
+      fixedTimestep(DEFAULT_TIMESTEP),
+      maxSubsteps(DEFAULT_MAX_SUBSTEPS),
+      accumulator(0.0f),
+      tickCount(0),
+      profiling(true) {
+    asteroids.shapeLibrary.setSeed(randomStream(RandomPurpose::SHAPES, 0).nextU32());
+    spawnAsteroids(Config::INITIAL_ASTEROIDS);
 }
 
 void Game::update(float deltaTime) {
     if (gameOver) return;
+    alloc::PhaseScope allocPhase(TickPhase::UPDATE);
+    STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::UPDATE));
+    asteroidBvh.invalidate();
+    powerUpBvh.invalidate();
+    outlinesDirty = true;
     
     // Update shoot cooldown
     if (shootCooldown > 0) {
@@ -36,46 +239,85 @@ void Game::update(float deltaTime) {
         player.applyBoundaries(width, height);
     }
     
-    // Update asteroids (remove if out of bounds)
-    for (auto& asteroid : asteroids) {
-        asteroid.update(deltaTime);
-        // Deactivate if off bottom of screen
-        if (asteroid.getPosition().y > height + 50) {
-            asteroid.setActive(false);
-        }
-    }
+    const simd::Kernels& kernels = simd::activeKernels();
+    
+    ThreadPool* pool = threadPool.get();
+    
+    {
+        alloc::PhaseScope allocPhase(TickPhase::INTEGRATE);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::INTEGRATE));
+        
+        // Update asteroids (remove if out of bounds)
+        forEachChunk(pool, asteroids.size(), INTEGRATE_GRAIN, [&](std::size_t begin, std::size_t end) {
+            const std::size_t count = end - begin;
+            kernels.integrate(asteroids.x.data() + begin, asteroids.y.data() + begin,
+                              asteroids.vx.data() + begin, asteroids.vy.data() + begin, count, deltaTime);
+            kernels.advanceRotation(asteroids.rotation.data() + begin, asteroids.rotationSpeed.data() + begin,
+                                    count, deltaTime);
+            // Deactivate if off bottom of screen
+            kernels.clearFlagAbove(asteroids.y.data() + begin, asteroids.flags.data() + begin, count,
+                                   height + EXIT_MARGIN, ENTITY_ACTIVE);
+        });
     
-    // Update projectiles
-    for (auto& projectile : projectiles) {
-        projectile.update(deltaTime);
-        // Deactivate if off top of screen
-        if (projectile.getPosition().y < -10) {
-            projectile.setActive(false);
+        // Update projectiles
+        forEachChunk(pool, projectiles.size(), INTEGRATE_GRAIN, [&](std::size_t begin, std::size_t end) {
+            const std::size_t count = end - begin;
+            kernels.integrate(projectiles.x.data() + begin, projectiles.y.data() + begin,
+                              projectiles.vx.data() + begin, projectiles.vy.data() + begin, count, deltaTime);
+            // Deactivate if off top of screen; running out of time is up to the timer wheel
+            kernels.clearFlagBelow(projectiles.y.data() + begin, projectiles.flags.data() + begin, count,
+                                   -10, ENTITY_ACTIVE);
+        });
+    
+        // Update power-ups
+        {
+            const std::size_t count = powerUps.size();
+            kernels.integrate(powerUps.x.data(), powerUps.y.data(),
+                              powerUps.vx.data(), powerUps.vy.data(), count, deltaTime);
+        
+            // Allow horizontal wrapping; power-ups are few, so this stays scalar
+            float* x = powerUps.x.data();
+            float* y = powerUps.y.data();
+            for (std::size_t i = 0; i < count; ++i) {
+                if (x[i] < 0) x[i] += width;
+                if (x[i] > width) x[i] -= width;
+                if (y[i] < 0) y[i] += height;
+                if (y[i] > height) y[i] -= height;
+            }
+            // Deactivate if off bottom of screen
+            kernels.clearFlagAbove(y, powerUps.flags.data(), count, height + EXIT_MARGIN, ENTITY_ACTIVE);
         }
     }
     
-    // Update power-ups
-    for (auto& powerUp : powerUps) {
-        powerUp.update(deltaTime);
-        powerUp.wrapScreen(width, height);  // Allow horizontal wrapping
-        // Deactivate if off bottom of screen
-        if (powerUp.getPosition().y > height + 50) {
-            powerUp.setActive(false);
-        }
+    // Expired projectiles, power-ups and effects, all in one pass
+    {
+        alloc::PhaseScope allocPhase(TickPhase::TIMERS);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::TIMERS));
+        expireTimers(deltaTime);
     }
     
-    // Update power-up timers
-    if (shieldTimer > 0) shieldTimer -= deltaTime;
-    if (multiShotTimer > 0) multiShotTimer -= deltaTime;
-    if (rapidFireTimer > 0) rapidFireTimer -= deltaTime;
-    if (speedBoostTimer > 0) speedBoostTimer -= deltaTime;
+    if (sectors.isEnabled()) {
+        alloc::PhaseScope allocPhase(TickPhase::SECTORS);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::SECTORS));
+        refreshSectors();
+    }
     
-    checkCollisions();
-    removeInactiveEntities();
+    {
+        alloc::PhaseScope allocPhase(TickPhase::COLLISIONS);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::COLLISIONS));
+        checkCollisions(deltaTime);
+    }
+    {
+        alloc::PhaseScope allocPhase(TickPhase::RELEASE);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::RELEASE));
+        releaseInactiveEntities();
+    }
     
     // Continuous asteroid spawning
     spawnTimer += deltaTime;
-    if (spawnTimer >= spawnInterval) {
+    if (spawnTimer >= Config::SPAWN_INTERVAL) {
+        alloc::PhaseScope allocPhase(TickPhase::SPAWN);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::SPAWN));
         spawnTimer = 0.0f;
         // Spawn 1-2 asteroids continuously, scaled by level
         int spawnCount = 1 + (level / 3);  // More asteroids as level increases
@@ -83,7 +325,9 @@ void Game::update(float deltaTime) {
     }
     
     // Check if all asteroids destroyed - advance level (bonus multiplier)
-    if (asteroids.empty() && player.isActive()) {
+    if (getAsteroidCount() == 0 && player.isActive()) {
+        alloc::PhaseScope allocPhase(TickPhase::LEVEL);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::LEVEL));
         level++;
         spawnAsteroids(6 + level * 2);
     }
@@ -104,16 +348,16 @@ void Game::handleInput(char input, float deltaTime) {
     
     switch (input) {
         case 'a': case 'A':
-            player.moveLeft(hasSpeedBoost() ? 300.0f : 150.0f);
+            player.moveLeft(Config::PLAYER_SPEED * (hasSpeedBoost() ? Config::SPEED_BOOST_MULTIPLIER : 1.0f));
             break;
         case 'd': case 'D':
-            player.moveRight(hasSpeedBoost() ? 300.0f : 150.0f);
+            player.moveRight(Config::PLAYER_SPEED * (hasSpeedBoost() ? Config::SPEED_BOOST_MULTIPLIER : 1.0f));
             break;
         case 'w': case 'W':
-            player.thrust(deltaTime, hasSpeedBoost() ? 2.0f : 1.0f);
+            player.thrust(deltaTime, hasSpeedBoost() ? Config::SPEED_BOOST_MULTIPLIER : 1.0f);
             break;
         case ' ':
-            float currentShootDelay = hasRapidFire() ? shootDelay * 0.5f : shootDelay;
+            float currentShootDelay = hasRapidFire() ? Config::SHOOT_DELAY * Config::RAPID_FIRE_DELAY_SCALE : Config::SHOOT_DELAY;
             if (shootCooldown <= 0) {
                 shootProjectile();
                 shootCooldown = currentShootDelay;
@@ -122,188 +366,707 @@ void Game::handleInput(char input, float deltaTime) {
     }
 }
 
-void Game::spawnAsteroids(int count) {
-    std::uniform_real_distribution<float> xDist(0, width);
-    std::uniform_real_distribution<float> speedDist(10.0f, 30.0f);
+void Game::applyInput(InputMask input, float deltaTime) {
+    if (gameOver) {
+        if (input & INPUT_RESTART) {
+            reset();
+        }
+        return;
+    }
+    
+    // Left wins over right, matching the example's key handling
+    if (input & INPUT_LEFT) {
+        handleInput('a', deltaTime);
+    } else if (input & INPUT_RIGHT) {
+        handleInput('d', deltaTime);
+    } else {
+        player.stopMoving();
+    }
+    if (input & INPUT_THRUST) {
+        handleInput('w', deltaTime);
+    }
+    if (input & INPUT_FIRE) {
+        handleInput(' ', deltaTime);
+    }
+}
+
+void Game::step(InputMask input) {
+    // Heap accounting, only when starship_alloc_hooks is linked in
+    const bool countAllocations = alloc::isTracking();
+    TickAllocations start;
+    if (countAllocations) {
+        alloc::resetPeak();
+        start = alloc::threadCounters();
+    }
+    
+    {
+        alloc::PhaseScope allocPhase(TickPhase::INPUT);
+        STARSHIP_PROFILE_SCOPE(phaseHistogram(TickPhase::INPUT));
+        applyInput(input, fixedTimestep);
+    }
+    update(fixedTimestep);
+    ++tickCount;
     
+    if (countAllocations) {
+        lastTickAllocations = alloc::since(start);
+    }
+}
+
+int Game::advance(float frameTime, InputMask input) {
+    accumulator += frameTime;
+    int ticks = 0;
+    while (accumulator >= fixedTimestep && ticks < maxSubsteps) {
+        step(input);
+        accumulator -= fixedTimestep;
+        ++ticks;
+    }
+    // Too far behind: drop the backlog rather than spiral
+    if (accumulator >= fixedTimestep) {
+        accumulator = 0.0f;
+    }
+    return ticks;
+}
+
+void Game::setFixedTimestep(float timestep, int maxSubsteps) {
+    fixedTimestep = timestep;
+    this->maxSubsteps = maxSubsteps > 0 ? maxSubsteps : 1;
+    accumulator = 0.0f;
+}
+
+std::uint64_t Game::checksum() const {
+    StateHasher h;
+    h.value(player.getPosition());
+    h.value(player.getVelocity());
+    h.value(player.getHealth());
+    h.value(player.isActive());
+    h.body(asteroids);
+    h.column(asteroids.rotation);
+    h.column(asteroids.rotationSpeed);
+    h.column(asteroids.sizes);
+    h.column(asteroids.shapeVariants);
+    h.value(sectors.size());
+    h.value(sectors.getCenter());
+    h.column(sectors.x);
+    h.column(sectors.y);
+    h.column(sectors.vx);
+    h.column(sectors.vy);
+    h.column(sectors.rotation);
+    h.column(sectors.parkedAt);
+    h.column(sectors.sectors);
+    h.body(projectiles);
+    h.column(projectiles.expiresAt);
+    h.body(powerUps);
+    h.column(powerUps.spawnedAt);
+    h.column(powerUps.expiresAt);
+    h.column(powerUps.types);
+    h.value(score);
+    h.value(level);
+    h.value(shootCooldown);
+    h.value(spawnTimer);
+    for (std::uint64_t end : effectEnds) h.value(end);
+    h.value(activeEffects);
+    h.value(timerTick);
+    h.value(tickCarry);
+    h.value(randomTick);
+    h.value(spawnSerial);
+    h.value(gameOver);
+    h.value(tickCount);
+    return h.result();
+}
+
+void Game::spawnAsteroids(int count) {
     for (int i = 0; i < count; i++) {
+        const std::uint32_t id = spawnSerial++;
+        RandomStream random = randomStream(RandomPurpose::WAVE, id);
+        
         // Spawn from top of screen, moving downward
-        Vector2D pos(xDist(rng), -20.0f);
+        Vector2D pos(random.uniform(0.0f, width), -20.0f);
         
         // Velocity moves downward (positive y direction)
-        float speed = speedDist(rng);
-        std::uniform_real_distribution<float> angleDist(-0.2f, 0.2f);
-        float horizontalAngle = angleDist(rng); // Slight horizontal drift
+        float speed = random.uniform(10.0f, 30.0f);
+        float horizontalAngle = random.uniform(-0.2f, 0.2f); // Slight horizontal drift
         Vector2D vel(std::sin(horizontalAngle) * speed, speed);
         
-        spawnAsteroid(pos, vel, Asteroid::Size::LARGE);
+        RandomStream look = randomStream(RandomPurpose::ASTEROID, id);
+        pushAsteroid(rollAsteroid(pos, vel, Asteroid::Size::LARGE, look));
+    }
+}
+
+AsteroidHandle Game::spawnAsteroid(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size) {
+    RandomStream look = randomStream(RandomPurpose::ASTEROID, spawnSerial++);
+    return pushAsteroid(rollAsteroid(pos, vel, size, look));
+}
+
+AsteroidHandle Game::pushAsteroid(const CommandBuffer::AsteroidSpawn& spawn) {
+    if (sectors.isEnabled() && !sectors.isActive(sectors.sectorAt(spawn.position.x, spawn.position.y))) {
+        scheduleWake(sectors.park(spawn, timerTick));
+        return AsteroidHandle{};
     }
+    return appendAsteroid(spawn);
 }
 
-void Game::spawnAsteroid(const Vector2D& pos, const Vector2D& vel, Asteroid::Size size) {
-    asteroids.emplace_back(pos, vel, size, rng);
+AsteroidHandle Game::appendAsteroid(const CommandBuffer::AsteroidSpawn& spawn) {
+    std::uint32_t id = asteroids.push(spawn.position, spawn.velocity, spawn.size,
+                                      spawn.rotation, spawn.rotationSpeed, spawn.shapeVariant);
+    outlinesDirty = true;
+    asteroidBvh.invalidate();
+    return AsteroidHandle{id, asteroids.handles.generationOf(id)};
 }
 
-void Game::spawnPowerUp(const Vector2D& pos) {
-    std::uniform_int_distribution<int> typeDist(0, 4);
-    PowerUp::Type type = static_cast<PowerUp::Type>(typeDist(rng));
-    powerUps.emplace_back(pos, type);
+PowerUpHandle Game::spawnPowerUp(const Vector2D& pos) {
+    RandomStream random = randomStream(RandomPurpose::POWER_UP, spawnSerial++);
+    PowerUp::Type type = static_cast<PowerUp::Type>(random.uniformInt(0, PowerUp::TYPE_COUNT - 1));
+    return pushPowerUp(pos, type, random.uniform(-15.0f, 15.0f));
+}
+
+PowerUpHandle Game::pushPowerUp(const Vector2D& pos, PowerUp::Type type, float drift) {
+    std::uint64_t expiry = timerTick + ticksFor(PowerUp::MAX_LIFETIME);
+    std::uint32_t id = powerUps.push(pos, type, expiry);
+    timers.schedule(expiry, TIMER_POWER_UP, id, powerUps.handles.generationOf(id));
+    powerUpBvh.invalidate();
     
     // Give the last added power-up some velocity
-    if (!powerUps.empty()) {
-        std::uniform_real_distribution<float> horizontalVel(-15.0f, 15.0f);
-        powerUps.back().setVelocity(Vector2D(horizontalVel(rng), 80.0f));  // Faster downward movement
-    }
+    powerUps.setVelocity(powerUps.size() - 1, Vector2D(drift, 80.0f));  // Faster downward movement
+    return PowerUpHandle{id, powerUps.handles.generationOf(id)};
+}
+
+ProjectileHandle Game::spawnProjectile(const Vector2D& pos, const Vector2D& vel) {
+    std::uint64_t expiry = timerTick + ticksFor(Projectile::MAX_LIFETIME);
+    std::uint32_t id = projectiles.push(pos, vel, expiry);
+    timers.schedule(expiry, TIMER_PROJECTILE, id, projectiles.handles.generationOf(id));
+    return ProjectileHandle{id, projectiles.handles.generationOf(id)};
 }
 
 void Game::applyPowerUp(PowerUp::Type type) {
-    const float effectDuration = 8.0f;  // 8 seconds
-    
     switch (type) {
         case PowerUp::Type::SHIELD:
-            shieldTimer = effectDuration;
-            break;
         case PowerUp::Type::MULTI_SHOT:
-            multiShotTimer = effectDuration;
-            break;
         case PowerUp::Type::RAPID_FIRE:
-            rapidFireTimer = effectDuration;
+            startEffect(type, Config::EFFECT_DURATION);
             break;
         case PowerUp::Type::SPEED_BOOST:
-            speedBoostTimer = 5.0f;
+            startEffect(type, Config::SPEED_BOOST_DURATION);
             break;
         case PowerUp::Type::EXTRA_LIFE:
-            if (player.getHealth() < 5) {  // Max 5 lives
+            if (player.getHealth() < Config::MAX_HEALTH) {
                 player.restoreHealth();
             }
             break;
     }
 }
 
+void Game::startEffect(PowerUp::Type type, float duration) {
+    const std::size_t index = static_cast<std::size_t>(type);
+    const std::uint64_t end = timerTick + ticksFor(duration);
+    // The timer for an earlier end stays on the wheel and is ignored
+    if (end > effectEnds[index]) {
+        effectEnds[index] = end;
+        timers.schedule(end, TIMER_EFFECT, static_cast<std::uint32_t>(index));
+    }
+    activeEffects |= effectBit(type);
+}
+
+std::uint64_t Game::ticksFor(float seconds) const {
+    return static_cast<std::uint64_t>(std::max(0.0f, std::ceil(seconds / fixedTimestep - TICK_EPSILON)));
+}
+
+void Game::expireTimers(float deltaTime) {
+    // A fixed tick is one tick of the clock. Other steps are converted,
+    // carrying the fraction so that short updates still add up.
+    if (deltaTime == fixedTimestep) {
+        ++timerTick;
+    } else {
+        float ticks = tickCarry + deltaTime / fixedTimestep;
+        float whole = std::max(0.0f, std::floor(ticks + TICK_EPSILON));
+        tickCarry = std::max(0.0f, ticks - whole);
+        timerTick += static_cast<std::uint64_t>(whole);
+    }
+    powerUps.now = timerTick;
+    
+    expiredTimers.clear();
+    timers.advance(timerTick, expiredTimers);
+    // The wheel's order for timers due together depends on when they were
+    // scheduled, which a restored game does not repeat. Wake-ups append to
+    // the asteroid columns, so they are taken in a fixed order.
+    std::sort(expiredTimers.begin(), expiredTimers.end(), [](const TimerWheel::Timer& a, const TimerWheel::Timer& b) {
+        return std::tie(a.kind, a.id, a.generation) < std::tie(b.kind, b.id, b.generation);
+    });
+    for (const TimerWheel::Timer& timer : expiredTimers) {
+        switch (timer.kind) {
+            case TIMER_PROJECTILE:
+                expireEntity(projectiles, timer);
+                break;
+            case TIMER_POWER_UP:
+                expireEntity(powerUps, timer);
+                break;
+            case TIMER_EFFECT:
+                // Unless picked up again since, which moved the end later
+                if (effectEnds[timer.id] <= timerTick) {
+                    activeEffects &= static_cast<std::uint8_t>(~effectBit(static_cast<PowerUp::Type>(timer.id)));
+                }
+                break;
+            case TIMER_DORMANT:
+                // Unless woken or dropped since
+                if (sectors.isParked(timer.id) && sectors.generationOf(timer.id) == timer.generation) {
+                    crossSector(timer.id);
+                }
+                break;
+        }
+    }
+}
+
+void Game::rebuildTimers() {
+    timers.reset(timerTick);
+    powerUps.now = timerTick;
+    scheduleExpiries(timers, projectiles, TIMER_PROJECTILE);
+    scheduleExpiries(timers, powerUps, TIMER_POWER_UP);
+    for (int type = 0; type < PowerUp::TYPE_COUNT; ++type) {
+        if (hasEffect(static_cast<PowerUp::Type>(type))) {
+            timers.schedule(effectEnds[type], TIMER_EFFECT, static_cast<std::uint32_t>(type));
+        }
+    }
+    for (std::uint32_t slot = 0; slot < sectors.slotCount(); ++slot) {
+        if (sectors.isParked(slot)) scheduleWake(slot);
+    }
+}
+
+void Game::setSectors(float sectorSize, int activeRadius) {
+    // Everything comes back to the live columns before the grid changes
+    for (std::uint32_t slot = 0; slot < sectors.slotCount(); ++slot) {
+        if (sectors.isParked(slot)) appendAsteroid(sectors.unpark(slot, timerTick, fixedTimestep));
+    }
+    sectors.configure(width, height, sectorSize, activeRadius);
+    if (sectors.isEnabled()) refreshSectors();
+    releaseInactiveEntities();
+}
+
+void Game::refreshSectors() {
+    const int radius = sectors.getActiveRadius();
+    const std::uint32_t previous = sectors.getCenter();
+    const std::uint32_t center = sectors.sectorAt(player.getPosition().x, player.getPosition().y);
+    sectors.setCenter(center);
+    
+    if (center != previous) {
+        // Wake the sectors that just came into range
+        sectors.forEachWithin(center, radius, [&](std::uint32_t sector) {
+            if (previous != WorldSectors::NONE && sectors.isWithin(sector, previous, radius)) return;
+            std::uint32_t slot = sectors.firstIn(sector);
+            while (slot != WorldSectors::NONE) {
+                const std::uint32_t next = sectors.nextIn(slot);
+                appendAsteroid(sectors.unpark(slot, timerTick, fixedTimestep));
+                slot = next;
+            }
+        });
+    }
+    
+    // Park what has drifted out of range. One sector of slack keeps an
+    // asteroid on the edge from going back and forth every tick.
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (!asteroids.isActive(i)) continue;
+        if (sectors.isWithin(sectors.sectorAt(asteroids.x[i], asteroids.y[i]), center, radius + 1)) continue;
+        CommandBuffer::AsteroidSpawn asteroid;
+        asteroid.position = asteroids.position(i);
+        asteroid.velocity = asteroids.velocity(i);
+        asteroid.size = asteroids.sizes[i];
+        asteroid.rotation = asteroids.rotation[i];
+        asteroid.rotationSpeed = asteroids.rotationSpeed[i];
+        asteroid.shapeVariant = asteroids.shapeVariants[i];
+        scheduleWake(sectors.park(asteroid, timerTick));
+        asteroids.setActive(i, false);
+    }
+}
+
+void Game::crossSector(std::uint32_t slot) {
+    sectors.advance(slot, timerTick, fixedTimestep);
+    if (sectors.y[slot] > height + EXIT_MARGIN) {
+        // Off the bottom, where a live one would be dropped too
+        sectors.remove(slot);
+    } else if (sectors.isActive(sectors.sectors[slot])) {
+        appendAsteroid(sectors.unpark(slot, timerTick, fixedTimestep));
+    } else {
+        scheduleWake(slot);
+    }
+}
+
+void Game::scheduleWake(std::uint32_t slot) {
+    float seconds = sectors.secondsToLeaveSector(slot);
+    if (sectors.vy[slot] > 0.0f) {
+        seconds = std::min(seconds, (height + EXIT_MARGIN - sectors.y[slot]) / sectors.vy[slot]);
+    }
+    if (seconds == WorldSectors::NEVER) return;
+    const float ticks = std::min(std::ceil(std::max(0.0f, seconds) / fixedTimestep), MAX_WAKE_TICKS);
+    const std::uint64_t deadline = sectors.parkedAt[slot] + std::max<std::uint64_t>(1, static_cast<std::uint64_t>(ticks));
+    timers.schedule(deadline, TIMER_DORMANT, slot, sectors.generationOf(slot));
+}
+
 void Game::shootProjectile() {
     if (!player.isActive()) return;
     
     // Projectiles always shoot upward (negative y direction)
     Vector2D pos = player.getPosition();
     
-    if (multiShotTimer > 0) {
+    if (hasMultiShot()) {
         // Multi-shot: 3 projectiles in spread
-        Vector2D velCenter(0.0f, -300.0f);
-        Vector2D velLeft(-50.0f, -300.0f);
-        Vector2D velRight(50.0f, -300.0f);
+        Vector2D velCenter(0.0f, -Config::PROJECTILE_SPEED);
+        Vector2D velLeft(-Config::MULTI_SHOT_SPREAD, -Config::PROJECTILE_SPEED);
+        Vector2D velRight(Config::MULTI_SHOT_SPREAD, -Config::PROJECTILE_SPEED);
         
-        projectiles.emplace_back(pos, velLeft);
-        projectiles.emplace_back(pos, velCenter);
-        projectiles.emplace_back(pos, velRight);
+        spawnProjectile(pos, velLeft);
+        spawnProjectile(pos, velCenter);
+        spawnProjectile(pos, velRight);
     } else {
         // Normal shot
-        Vector2D vel(0.0f, -300.0f);
-        projectiles.emplace_back(pos, vel);
+        Vector2D vel(0.0f, -Config::PROJECTILE_SPEED);
+        spawnProjectile(pos, vel);
     }
 }
 
-void Game::checkCollisions() {
-    // Check projectile-asteroid collisions
-    for (auto& projectile : projectiles) {
-        if (!projectile.isActive()) continue;
-        
-        for (auto& asteroid : asteroids) {
-            if (!asteroid.isActive()) continue;
-            
-            if (projectile.collidesWith(asteroid)) {
-                projectile.setActive(false);
-                asteroid.setActive(false);
-                score += asteroid.getPoints();
-                
-                // Chance to spawn power-up when asteroid is destroyed
-                std::uniform_real_distribution<float> powerUpChance(0.0f, 1.0f);
-                if (powerUpChance(rng) < 0.15f) {  // 15% chance
-                    spawnPowerUp(asteroid.getPosition());
-                }
-                
-                // Split asteroid if possible
-                if (asteroid.canSplit()) {
-                    Asteroid::Size nextSize = asteroid.getNextSize();
-                    std::uniform_real_distribution<float> angleDist(-0.5f, 0.5f);
-                    
-                    for (int i = 0; i < 2; i++) {
-                        Vector2D vel = asteroid.getVelocity();
-                        float angle = std::atan2(vel.y, vel.x) + angleDist(rng);
-                        float speed = vel.length() * 1.2f;
-                        Vector2D newVel(std::cos(angle) * speed, std::sin(angle) * speed);
-                        spawnAsteroid(asteroid.getPosition(), newVel, nextSize);
-                    }
-                }
-                break;
+void Game::checkCollisions(float deltaTime) {
+    constexpr std::uint32_t noHit = std::numeric_limits<std::uint32_t>::max();
+    
+    // Hits are keyed by their index in the pass, so each pass needs its own tick
+    ++randomTick;
+    
+    // Broad phase: bucket the live asteroids by position. Fragments split
+    // off by this pass are appended after detection, past indexedCount,
+    // and take part from the next tick. A handful of asteroids is cheaper
+    // to scan than to hash, which is the common case for batched games.
+    const std::size_t indexedCount = asteroids.size();
+    const bool useGrid = indexedCount > LINEAR_SCAN_LIMIT;
+    if (useGrid) {
+        asteroidGrid.build(asteroids.x.data(), asteroids.y.data(), asteroids.radius.data(),
+                           asteroids.flags.data(), ENTITY_ACTIVE, indexedCount);
+    }
+    
+    // Outlines are built here, before the parallel search reads them
+    const AsteroidOutlines* outlines = polygonCollisions ? &getAsteroidOutlines() : nullptr;
+    const float outlineScale = outlines ? AsteroidShapeLibrary::MAX_JITTER : 1.0f;
+    
+    // How far beyond its collision circle a hit can reach an asteroid's
+    // grid position: its own motion this step plus any outline overhang
+    float sweepMargin = 0.0f;
+    if (useGrid) {
+        float maxSpeedSq = 0.0f;
+        if (deltaTime > 0.0f) {
+            for (std::size_t i = 0; i < indexedCount; ++i) {
+                maxSpeedSq = std::max(maxSpeedSq, asteroids.vx[i] * asteroids.vx[i] + asteroids.vy[i] * asteroids.vy[i]);
             }
         }
+        sweepMargin = std::sqrt(maxSpeedSq) * deltaTime + asteroidGrid.getMaxRadius() * (outlineScale - 1.0f);
     }
     
-    // Check player-power-up collisions
-    if (player.isActive()) {
-        for (auto& powerUp : powerUps) {
-            if (!powerUp.isActive()) continue;
-            
-            if (player.collidesWith(powerUp)) {
-                powerUp.setActive(false);
-                applyPowerUp(powerUp.getType());
-                break;
+    auto touchesAsteroid = [&](const Vector2D& pos, float radius, std::size_t i) {
+        float dx = asteroids.x[i] - pos.x;
+        float dy = asteroids.y[i] - pos.y;
+        float reach = radius + asteroids.radius[i];
+        return dx * dx + dy * dy < reach * reach;
+    };
+    
+    // Not destroyed, and not yet claimed by a projectile in this pass
+    auto available = [&](std::size_t i) {
+        return asteroids.isActive(i) && !asteroidClaimed[i];
+    };
+    
+    // Lowest-index available asteroid touching the circle, matching the
+    // order a linear scan would find it in
+    auto firstHit = [&](const Vector2D& pos, float radius) {
+        std::uint32_t hit = noHit;
+        if (!useGrid) {
+            for (std::uint32_t i = 0; i < indexedCount; ++i) {
+                if (available(i) && touchesAsteroid(pos, radius, i)) return i;
             }
+            return hit;
         }
+        asteroidGrid.query(pos, radius, [&](std::uint32_t id) {
+            if (id < hit && available(id) && touchesAsteroid(pos, radius, id)) {
+                hit = id;
+            }
+        });
+        return hit;
+    };
+    
+    // When during the step a shot now at `pos` first touched asteroid i.
+    // Works in the asteroid's frame, where the shot moved by the relative
+    // velocity and the asteroid sits at its end-of-step position.
+    auto impactTime = [&](const Vector2D& pos, const Vector2D& vel, float radius, std::size_t i) {
+        const Vector2D travel((vel.x - asteroids.vx[i]) * deltaTime, (vel.y - asteroids.vy[i]) * deltaTime);
+        const Vector2D start = pos - travel;
+        float t = sweptCircleTime(start, travel, asteroids.position(i), radius + asteroids.radius[i] * outlineScale);
+        if (t == NO_IMPACT || !outlines) return t;
+        return sweptPolygonTime(start, pos, (*outlines)[i]);
+    };
+    
+    // Earliest impact along the shot's path; ties go to the lower index
+    auto firstImpact = [&](const Vector2D& pos, const Vector2D& vel, float radius) {
+        std::uint32_t hit = noHit;
+        float hitTime = NO_IMPACT;
+        auto consider = [&](std::uint32_t id) {
+            if (!available(id)) return;
+            float t = impactTime(pos, vel, radius, id);
+            if (t < hitTime || (t == hitTime && t != NO_IMPACT && id < hit)) {
+                hitTime = t;
+                hit = id;
+            }
+        };
+        if (!useGrid) {
+            for (std::uint32_t i = 0; i < indexedCount; ++i) consider(i);
+            return hit;
+        }
+        // Circle around the whole path
+        const Vector2D halfTravel = vel * (0.5f * deltaTime);
+        asteroidGrid.query(pos - halfTravel, halfTravel.length() + radius + sweepMargin, consider);
+        return hit;
+    };
+    
+    // Detection below only reads the stores and records what it finds in
+    // `commands`; applyCommands() then makes every change in one pass
+    commands.clear();
+    asteroidClaimed.assign(indexedCount, 0);
+    
+    // Find each projectile's target. This only reads shared state, so it
+    // runs in parallel chunks.
+    const std::size_t projectileCount = projectiles.size();
+    projectileHits.resize(projectileCount);
+    forEachChunk(threadPool.get(), projectileCount, COLLISION_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            projectileHits[p] = projectiles.isActive(p)
+                ? firstImpact(projectiles.position(p), projectiles.velocity(p), projectiles.radius[p])
+                : noHit;
+        }
+    });
+    
+    // Settle contested targets in projectile order: each asteroid goes to
+    // the first projectile that reaches it
+    for (std::size_t p = 0; p < projectileCount; ++p) {
+        std::uint32_t hit = projectileHits[p];
+        if (hit == noHit) continue;
+        
+        // An earlier projectile claimed our target. Everything that ranked
+        // ahead of it is already claimed, so the next candidate is found
+        // by querying again; an unclaimed target needs no re-check.
+        if (asteroidClaimed[hit]) {
+            hit = firstImpact(projectiles.position(p), projectiles.velocity(p), projectiles.radius[p]);
+            if (hit == noHit) continue;
+        }
+        asteroidClaimed[hit] = 1;
+        commands.hits.push_back(CommandBuffer::Hit{static_cast<std::uint32_t>(p), hit});
     }
     
-    // Check player-asteroid collisions
-    if (player.isActive() && !isShielded()) {
-        for (auto& asteroid : asteroids) {
-            if (!asteroid.isActive()) continue;
+    // Check player-power-up collisions. A single query point gains nothing
+    // from a grid, so this stays a linear squared-distance scan.
+    bool shielded = isShielded();
+    if (player.isActive()) {
+        const Vector2D playerPos = player.getPosition();
+        for (std::size_t i = 0; i < powerUps.size(); ++i) {
+            if (!powerUps.isActive(i)) continue;
             
-            if (player.collidesWith(asteroid)) {
-                player.takeDamage();
-                asteroid.setActive(false);
-                
-                if (player.getHealth() > 0) {
-                    player.respawn(Vector2D(width / 2, height / 2));
-                }
+            float dx = powerUps.x[i] - playerPos.x;
+            float dy = powerUps.y[i] - playerPos.y;
+            float reach = player.getRadius() + powerUps.radius[i];
+            if (dx * dx + dy * dy < reach * reach) {
+                commands.pickup = static_cast<std::uint32_t>(i);
+                // A shield picked up now already protects against this pass
+                shielded = shielded || powerUps.types[i] == PowerUp::Type::SHIELD;
                 break;
             }
         }
     }
+    
+    // Check player-asteroid collisions
+    if (player.isActive() && !shielded) {
+        commands.playerHitBy = firstHit(player.getPosition(), player.getRadius());
+    }
+    
+    applyCommands();
 }
 
-void Game::removeInactiveEntities() {
-    asteroids.erase(
-        std::remove_if(asteroids.begin(), asteroids.end(),
-            [](const Asteroid& a) { return !a.isActive(); }),
-        asteroids.end()
-    );
+void Game::applyCommands() {
+    // Destruction and score first: plain flag and counter updates
+    for (const CommandBuffer::Hit& hit : commands.hits) {
+        projectiles.setActive(hit.projectile, false);
+        asteroids.setActive(hit.asteroid, false);
+        score += Asteroid::getPointsForSize(asteroids.sizes[hit.asteroid]);
+    }
+    
+    // Drops and splits are rolled into the buffer, each hit from its own
+    // streams and into its own entries, so hits resolve in parallel. The
+    // results are appended in hit order, after the last read of the
+    // destroyed asteroids.
+    const std::size_t hitCount = commands.hits.size();
+    commands.outcomes.resize(hitCount);
+    std::uint32_t fragmentCount = 0;
+    for (std::size_t h = 0; h < hitCount; ++h) {
+        commands.outcomes[h].firstFragment = fragmentCount;
+        if (asteroids.sizes[commands.hits[h].asteroid] != Asteroid::Size::SMALL) fragmentCount += 2;
+    }
+    commands.asteroidSpawns.resize(fragmentCount);
+    forEachChunk(threadPool.get(), hitCount, RESOLVE_GRAIN, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t h = begin; h < end; ++h) {
+            const std::uint32_t a = commands.hits[h].asteroid;
+            CommandBuffer::Outcome& outcome = commands.outcomes[h];
+            RandomStream drop = randomStream(RandomPurpose::DROP, static_cast<std::uint32_t>(h));
+            RandomStream split = randomStream(RandomPurpose::SPLIT, static_cast<std::uint32_t>(h));
+            rollHit(asteroids.position(a), asteroids.velocity(a), asteroids.sizes[a], Config::POWERUP_DROP_CHANCE,
+                    drop, split, outcome, commands.asteroidSpawns.data() + outcome.firstFragment);
+        }
+    });
+    
+    for (const CommandBuffer::Outcome& outcome : commands.outcomes) {
+        if (outcome.dropped) pushPowerUp(outcome.dropPosition, outcome.dropType, outcome.dropDrift);
+    }
+    for (const CommandBuffer::AsteroidSpawn& spawn : commands.asteroidSpawns) {
+        pushAsteroid(spawn);
+    }
     
-    projectiles.erase(
-        std::remove_if(projectiles.begin(), projectiles.end(),
-            [](const Projectile& p) { return !p.isActive(); }),
-        projectiles.end()
-    );
+    if (commands.pickup != CommandBuffer::NONE) {
+        powerUps.setActive(commands.pickup, false);
+        applyPowerUp(powerUps.types[commands.pickup]);
+    }
     
-    powerUps.erase(
-        std::remove_if(powerUps.begin(), powerUps.end(),
-            [](const PowerUp& p) { return !p.isActive(); }),
-        powerUps.end()
-    );
+    if (commands.playerHitBy != CommandBuffer::NONE) {
+        player.takeDamage();
+        asteroids.setActive(commands.playerHitBy, false);
+        
+        if (player.getHealth() > 0) {
+            player.respawn(Vector2D(width / 2, height / 2));
+        }
+    }
+}
+
+void Game::releaseInactiveEntities() {
+    outlinesDirty = true;
+    asteroidBvh.invalidate();
+    powerUpBvh.invalidate();
+    // The three stores are independent, so they are processed concurrently
+    forEachChunk(threadPool.get(), 3, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t store = begin; store < end; ++store) {
+            switch (store) {
+                case 0: asteroids.releaseInactive(); break;
+                case 1: projectiles.releaseInactive(); break;
+                default: powerUps.releaseInactive(); break;
+            }
+        }
+    });
+}
+
+void Game::removeInactiveEntities() {
+    outlinesDirty = true;
+    asteroidBvh.invalidate();
+    powerUpBvh.invalidate();
+    forEachChunk(threadPool.get(), 3, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t store = begin; store < end; ++store) {
+            switch (store) {
+                case 0: asteroids.removeInactive(); break;
+                case 1: projectiles.removeInactive(); break;
+                default: powerUps.removeInactive(); break;
+            }
+        }
+    });
+}
+
+const AsteroidOutlines& Game::getAsteroidOutlines() const {
+    if (outlinesDirty) {
+        asteroidOutlines.build(asteroids);
+        outlinesDirty = false;
+    }
+    return asteroidOutlines;
+}
+
+std::size_t Game::queryRadius(const Vector2D& center, float radius, std::vector<AsteroidHandle>& out) const {
+    return collectRadius(asteroidBvh, asteroids, center, radius, out);
+}
+
+std::size_t Game::queryRadius(const Vector2D& center, float radius, std::vector<PowerUpHandle>& out) const {
+    return collectRadius(powerUpBvh, powerUps, center, radius, out);
+}
+
+std::size_t Game::queryAABB(const Vector2D& min, const Vector2D& max, std::vector<AsteroidHandle>& out) const {
+    return collectBox(asteroidBvh, asteroids, min, max, out);
+}
+
+std::size_t Game::queryAABB(const Vector2D& min, const Vector2D& max, std::vector<PowerUpHandle>& out) const {
+    return collectBox(powerUpBvh, powerUps, min, max, out);
+}
+
+bool Game::raycast(const Vector2D& origin, const Vector2D& direction, float maxDistance,
+                   RaycastHit<AsteroidHandle>& hit) const {
+    return castRay(asteroidBvh, asteroids, origin, direction, maxDistance, hit);
+}
+
+bool Game::raycast(const Vector2D& origin, const Vector2D& direction, float maxDistance,
+                   RaycastHit<PowerUpHandle>& hit) const {
+    return castRay(powerUpBvh, powerUps, origin, direction, maxDistance, hit);
+}
+
+std::size_t Game::nearestK(const Vector2D& point, std::size_t k, std::vector<AsteroidHandle>& out) const {
+    return collectNearest(asteroidBvh, asteroids, point, k, nearestScratch, out);
+}
+
+std::size_t Game::nearestK(const Vector2D& point, std::size_t k, std::vector<PowerUpHandle>& out) const {
+    return collectNearest(powerUpBvh, powerUps, point, k, nearestScratch, out);
+}
+
+void Game::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    // A one-thread pool would only add overhead
+    if (pool && pool->getThreadCount() <= 1) pool.reset();
+    threadPool = std::move(pool);
+}
+
+void Game::setThreadCount(unsigned count) {
+    setThreadPool(count == 1 ? nullptr : std::make_shared<ThreadPool>(count));
 }
 
 void Game::reset() {
     player = Starship(Vector2D(width / 2, height / 2));
     asteroids.clear();
+    sectors.clear();
+    outlinesDirty = true;
     projectiles.clear();
     powerUps.clear();
+    asteroidBvh.invalidate();
+    powerUpBvh.invalidate();
     score = 0;
     level = 1;
     shootCooldown = 0.0f;
     spawnTimer = 0.0f;
-    shieldTimer = 0.0f;
-    multiShotTimer = 0.0f;
-    rapidFireTimer = 0.0f;
+    effectEnds.fill(0);
+    activeEffects = 0;
+    timers.reset(timerTick);
     gameOver = false;
-    spawnAsteroids(8);
+    if (sectors.isEnabled()) refreshSectors();
+    spawnAsteroids(Config::INITIAL_ASTEROIDS);
+}
+
+void Game::reset(std::uint32_t newSeed) {
+    // Same draws as the constructor: shape seed first, then the first wave
+    seed = newSeed;
+    randomTick = 0;
+    spawnSerial = 0;
+    asteroids.shapeLibrary.setSeed(randomStream(RandomPurpose::SHAPES, 0).nextU32());
+    accumulator = 0.0f;
+    tickCount = 0;
+    timerTick = 0;
+    tickCarry = 0.0f;
+    powerUps.now = 0;
+    reset();
+}
+
+void Game::reserve(std::size_t asteroidCount, std::size_t projectileCount, std::size_t powerUpCount) {
+    asteroids.reserve(asteroidCount);
+    projectiles.reserve(projectileCount);
+    powerUps.reserve(powerUpCount);
+    projectileHits.reserve(projectileCount);
+    
+    // Per-tick scratch that grows with the entity counts
+    asteroidGrid.reserve(asteroidCount);
+    asteroidBvh.reserve(asteroidCount);
+    powerUpBvh.reserve(powerUpCount);
+    asteroidClaimed.reserve(asteroidCount);
+    commands.hits.reserve(projectileCount);
+    timers.reserve(projectileCount + powerUpCount + PowerUp::TYPE_COUNT);
+    expiredTimers.reserve(projectileCount + powerUpCount + PowerUp::TYPE_COUNT);
+    commands.outcomes.reserve(projectileCount);
+    commands.asteroidSpawns.reserve(2 * projectileCount);
 }
 
 } // namespace starship
\ No newline at end of file
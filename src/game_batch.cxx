@@ -0,0 +1,101 @@
+#include "starship/game_batch.hxx"
+#include <utility>
+
+namespace starship {
+
+namespace {
+
+// Games per parallel chunk: a tick of one small game is about a
+// microsecond, so hand work out in batches of a few dozen
+constexpr std::size_t GAMES_PER_CHUNK = 32;
+
+// splitmix64 finalizer
+std::uint64_t mix64(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+GameBatch::GameBatch(std::size_t count, float width, float height, std::uint32_t baseSeed)
+    : baseSeed(baseSeed),
+      autoReset(false),
+      totalTicks(0),
+      scores(count),
+      levels(count),
+      gameOver(count),
+      episodes(count, 0) {
+    games.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        games.emplace_back(width, height, seedFor(baseSeed, i, 0));
+        games.back().reserve(RESERVED_ASTEROIDS, RESERVED_PROJECTILES, RESERVED_POWERUPS);
+        // A batched tick is about a microsecond; the phase timers would
+        // be a large share of it
+        games.back().setProfiling(false);
+        publish(i);
+    }
+}
+
+std::uint32_t GameBatch::seedFor(std::uint32_t baseSeed, std::size_t index, std::uint32_t episode) {
+    std::uint64_t key = mix64(baseSeed) ^ (static_cast<std::uint64_t>(index) << 20) ^ episode;
+    return static_cast<std::uint32_t>(mix64(key) >> 32);
+}
+
+void GameBatch::publish(std::size_t index) {
+    const Game& game = games[index];
+    scores[index] = game.getScore();
+    levels[index] = game.getLevel();
+    gameOver[index] = game.isGameOver() ? 1 : 0;
+}
+
+void GameBatch::stepRange(const InputMask* inputs, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Game& game = games[i];
+        if (game.isGameOver() && autoReset) {
+            game.reset(seedFor(baseSeed, i, ++episodes[i]));
+        }
+        game.step(inputs ? inputs[i] : InputMask(INPUT_NONE));
+        publish(i);
+    }
+}
+
+void GameBatch::step(const InputMask* inputs) {
+    if (threadPool) {
+        threadPool->parallelFor(games.size(), GAMES_PER_CHUNK, [&](std::size_t begin, std::size_t end) {
+            stepRange(inputs, begin, end);
+        });
+    } else {
+        stepRange(inputs, 0, games.size());
+    }
+    totalTicks += games.size();
+}
+
+void GameBatch::run(const InputMask* inputs, int ticks) {
+    for (int t = 0; t < ticks; ++t) {
+        step(inputs);
+    }
+}
+
+void GameBatch::reset() {
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        reset(i);
+    }
+}
+
+void GameBatch::reset(std::size_t index) {
+    episodes[index] = 0;
+    games[index].reset(seedFor(baseSeed, index, 0));
+    publish(index);
+}
+
+void GameBatch::setThreadPool(std::shared_ptr<ThreadPool> pool) {
+    if (pool && pool->getThreadCount() <= 1) pool.reset();
+    threadPool = std::move(pool);
+}
+
+void GameBatch::setThreadCount(unsigned count) {
+    setThreadPool(count == 1 ? nullptr : std::make_shared<ThreadPool>(count));
+}
+
+} // namespace starship
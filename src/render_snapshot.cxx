@@ -0,0 +1,123 @@
+#include "starship/render_snapshot.hxx"
+#include "starship/game.hxx"
+
+namespace starship {
+
+namespace {
+
+float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+// Past this many pixels between snapshots an entity is taken to have
+// jumped (screen wrap, respawn) and is drawn where it ended up
+constexpr float MAX_BLEND_DISTANCE = 100.0f;
+
+Vector2D lerp(const Vector2D& a, const Vector2D& b, float t) {
+    if (Vector2D::distanceSquared(a, b) > MAX_BLEND_DISTANCE * MAX_BLEND_DISTANCE) return b;
+    return Vector2D(lerp(a.x, b.x, t), lerp(a.y, b.y, t));
+}
+
+// Degrees, taking the shorter way round and wrapping back into [0, 360)
+float lerpAngle(float from, float to, float t) {
+    float delta = to - from;
+    if (delta > 180.0f) delta -= 360.0f;
+    if (delta < -180.0f) delta += 360.0f;
+    float angle = from + delta * t;
+    if (angle >= 360.0f) angle -= 360.0f;
+    if (angle < 0.0f) angle += 360.0f;
+    return angle;
+}
+
+// Slots only ever get appended and compaction is stable, so entities
+// that survive from one snapshot to the next keep their relative order
+// and come before any spawned in between. One forward walk therefore
+// pairs them up; the first entity without a partner starts the new ones.
+template <typename State, typename Blend>
+void blendMatching(const std::vector<State>& from, std::vector<State>& out, Blend&& blend) {
+    std::size_t j = 0;
+    for (State& state : out) {
+        while (j < from.size() && from[j].handle != state.handle) ++j;
+        if (j == from.size()) return;
+        blend(from[j], state);
+        ++j;
+    }
+}
+
+} // namespace
+
+void RenderSnapshot::capture(const Game& game) {
+    tick = game.getTickCount();
+
+    const Starship& player = game.getPlayer();
+    playerPosition = player.getPosition();
+    playerRotation = player.getRotation();
+    playerActive = player.isActive();
+
+    score = game.getScore();
+    lives = player.getHealth();
+    level = game.getLevel();
+    gameOver = game.isGameOver();
+    shielded = game.isShielded();
+    multiShot = game.hasMultiShot();
+    rapidFire = game.hasRapidFire();
+    speedBoost = game.hasSpeedBoost();
+
+    const AsteroidColumns& a = game.getAsteroids().data();
+    shapeSeed = a.shapeLibrary.getSeed();
+    asteroids.clear();
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (!a.isActive(i)) continue;
+        asteroids.push_back(AsteroidState{handleAt(a, i), a.position(i), a.rotation[i],
+                                          a.sizes[i], a.shapeVariants[i]});
+    }
+
+    const ProjectileColumns& p = game.getProjectiles().data();
+    projectiles.clear();
+    for (std::size_t i = 0; i < p.size(); ++i) {
+        if (!p.isActive(i)) continue;
+        projectiles.push_back(ProjectileState{handleAt(p, i), p.position(i)});
+    }
+
+    const PowerUpColumns& u = game.getPowerUps().data();
+    powerUps.clear();
+    for (std::size_t i = 0; i < u.size(); ++i) {
+        if (!u.isActive(i)) continue;
+        powerUps.push_back(PowerUpState{handleAt(u, i), u.position(i), u.radius[i], u.types[i]});
+    }
+}
+
+std::array<RenderSnapshot::PhaseSummary, TICK_PHASE_COUNT> RenderSnapshot::summarizeProfile(const TickProfile& profile) {
+    std::array<PhaseSummary, TICK_PHASE_COUNT> summary;
+    for (std::size_t i = 0; i < TICK_PHASE_COUNT; ++i) {
+        const LatencyHistogram& h = profile.phases[i];
+        summary[i].p50 = h.percentile(50);
+        summary[i].p99 = h.percentile(99);
+        summary[i].max = h.getMax();
+    }
+    return summary;
+}
+
+void blendSnapshots(const RenderSnapshot& from, const RenderSnapshot& to, float alpha, RenderSnapshot& out) {
+    out = to;
+    if (from.playerActive && to.playerActive) {
+        out.playerPosition = lerp(from.playerPosition, to.playerPosition, alpha);
+        out.playerRotation = lerp(from.playerRotation, to.playerRotation, alpha);
+    }
+
+    blendMatching(from.asteroids, out.asteroids,
+                  [alpha](const RenderSnapshot::AsteroidState& a, RenderSnapshot::AsteroidState& b) {
+        b.position = lerp(a.position, b.position, alpha);
+        b.rotation = lerpAngle(a.rotation, b.rotation, alpha);
+    });
+    blendMatching(from.projectiles, out.projectiles,
+                  [alpha](const RenderSnapshot::ProjectileState& a, RenderSnapshot::ProjectileState& b) {
+        b.position = lerp(a.position, b.position, alpha);
+    });
+    blendMatching(from.powerUps, out.powerUps,
+                  [alpha](const RenderSnapshot::PowerUpState& a, RenderSnapshot::PowerUpState& b) {
+        b.position = lerp(a.position, b.position, alpha);
+    });
+}
+
+} // namespace starship
@@ -0,0 +1,148 @@
+#include "starship/replay.hxx"
+#include <algorithm>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <utility>
+
+namespace starship {
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'S', 'R', 'P'};
+constexpr std::uint16_t FORMAT_VERSION = 2;
+
+// Longest session load() accepts: over 12 days at 60 Hz, 64 MiB of masks.
+// The tick count comes from the file, so it is bounded before anything
+// is allocated for it.
+constexpr std::uint64_t MAX_TICKS = std::uint64_t(1) << 26;
+
+template <typename T>
+void writeRaw(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readRaw(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// LEB128: 7 bits per byte, high bit set while more bytes follow
+void writeVarint(std::ostream& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+bool readVarint(std::istream& in, std::uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int byte = in.get();
+        if (byte == std::char_traits<char>::eof()) return false;
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+Game Recording::createGame() const {
+    Game game(width, height, seed);
+    game.setFixedTimestep(timestep);
+    game.setPolygonCollisions(polygonCollisions);
+    if (sectorSize > 0.0f) game.setSectors(sectorSize, activeRadius);
+    return game;
+}
+
+bool Recording::save(std::ostream& out) const {
+    out.write(MAGIC, sizeof(MAGIC));
+    writeRaw(out, FORMAT_VERSION);
+    writeRaw(out, seed);
+    writeRaw(out, width);
+    writeRaw(out, height);
+    writeRaw(out, timestep);
+    writeRaw(out, sectorSize);
+    writeRaw(out, activeRadius);
+    writeRaw(out, static_cast<std::uint8_t>(polygonCollisions ? 1 : 0));
+    writeRaw(out, finalChecksum);
+    writeVarint(out, inputs.size());
+
+    // (mask, run length) pairs
+    std::size_t i = 0;
+    while (i < inputs.size()) {
+        std::size_t run = 1;
+        while (i + run < inputs.size() && inputs[i + run] == inputs[i]) ++run;
+        out.put(static_cast<char>(inputs[i]));
+        writeVarint(out, run);
+        i += run;
+    }
+    return static_cast<bool>(out);
+}
+
+bool Recording::load(std::istream& in) {
+    char magic[sizeof(MAGIC)];
+    std::uint16_t version = 0;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) return false;
+    if (!readRaw(in, version) || version != FORMAT_VERSION) return false;
+
+    Recording loaded;
+    std::uint64_t tickCount = 0;
+    std::uint8_t polygonCollisions = 0;
+    if (!readRaw(in, loaded.seed) || !readRaw(in, loaded.width) || !readRaw(in, loaded.height) ||
+        !readRaw(in, loaded.timestep) || !readRaw(in, loaded.sectorSize) || !readRaw(in, loaded.activeRadius) ||
+        !readRaw(in, polygonCollisions) || !readRaw(in, loaded.finalChecksum) ||
+        !readVarint(in, tickCount) || tickCount > MAX_TICKS) {
+        return false;
+    }
+    loaded.polygonCollisions = polygonCollisions != 0;
+
+    while (loaded.inputs.size() < tickCount) {
+        int mask = in.get();
+        std::uint64_t run = 0;
+        if (mask == std::char_traits<char>::eof() || !readVarint(in, run)) return false;
+        if (run == 0 || run > tickCount - loaded.inputs.size()) return false;
+        loaded.inputs.insert(loaded.inputs.end(), run, static_cast<InputMask>(mask));
+    }
+
+    *this = std::move(loaded);
+    return true;
+}
+
+bool Recording::saveToFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    return file && save(file);
+}
+
+bool Recording::loadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return file && load(file);
+}
+
+InputRecorder::InputRecorder(const Game& game) {
+    recording.seed = game.getSeed();
+    recording.width = game.getWidth();
+    recording.height = game.getHeight();
+    recording.timestep = game.getFixedTimestep();
+    recording.sectorSize = game.getSectors().getSectorSize();
+    recording.activeRadius = game.getSectors().getActiveRadius();
+    recording.polygonCollisions = game.hasPolygonCollisions();
+}
+
+void InputRecorder::record(InputMask input, int ticks) {
+    if (ticks > 0) {
+        recording.inputs.insert(recording.inputs.end(), static_cast<std::size_t>(ticks), input);
+    }
+}
+
+bool replay(const Recording& recording, Game& game) {
+    InputPlayer player(recording);
+    while (!player.isDone()) {
+        game.step(player.next());
+    }
+    return recording.finalChecksum == 0 || game.checksum() == recording.finalChecksum;
+}
+
+} // namespace starship
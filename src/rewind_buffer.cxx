@@ -0,0 +1,116 @@
+#include "starship/rewind_buffer.hxx"
+#include <algorithm>
+#include <chrono>
+
+namespace starship {
+
+RewindBuffer::RewindBuffer(std::size_t capacity, std::size_t keyframeInterval)
+    : frames(std::max<std::size_t>(capacity, 1)),
+      keyframeInterval(std::max<std::size_t>(keyframeInterval, 1)) {
+    // Enough that a keyframe is always free once the ring is full: one per
+    // interval held, plus the partial ones at either end
+    keyframes.resize(frames.size() / this->keyframeInterval + 2);
+}
+
+void RewindBuffer::record(const Game& game, InputMask input) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::uint64_t tick = game.getTickCount();
+
+    // The game went back in time: what came after is no longer its future
+    while (count > 0 && getNewestTick() >= tick) dropNewest();
+    if (count > 0 && tick != getNewestTick() + 1) clear();
+    if (count == frames.size()) dropOldest();
+    if (count == 0) oldestTick = tick;
+
+    const Frame* previous = count > 0 ? &frames[slotOf(getNewestTick())] : nullptr;
+    Frame& frame = frames[(head + count) % frames.size()];
+    frame.input = input;
+
+    if (!previous || previous->distance + 1 >= keyframeInterval) {
+        frame.keyframe = freeKeyframe();
+        frame.distance = 0;
+        frame.delta.clear();
+        Snapshot& snapshot = keyframes[frame.keyframe].snapshot;
+        snapshot.assign(game, false);
+        frame.fullBytes = snapshot.size();
+    } else {
+        frame.keyframe = previous->keyframe;
+        frame.distance = previous->distance + 1;
+        frame.delta.encode(keyframes[frame.keyframe].snapshot, game);
+        frame.fullBytes = frame.delta.getTargetSize();
+    }
+    ++keyframes[frame.keyframe].users;
+    ++count;
+
+    lastRecordNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    totalRecordNanos += lastRecordNanos;
+    ++recordCount;
+}
+
+bool RewindBuffer::rewindTo(Game& game, std::uint64_t tick) {
+    if (!contains(tick)) return false;
+    const Frame& frame = frames[slotOf(tick)];
+    const Snapshot& keyframe = keyframes[frame.keyframe].snapshot;
+    if (frame.distance == 0) return keyframe.restore(game);
+    return frame.delta.apply(keyframe, scratch) && scratch.restore(game);
+}
+
+bool RewindBuffer::resimulate(Game& game, std::uint64_t tick) const {
+    const std::uint64_t from = game.getTickCount();
+    if (!contains(from) || !contains(tick) || tick < from) return false;
+    for (std::uint64_t t = from + 1; t <= tick; ++t) {
+        game.step(getInput(t));
+    }
+    return true;
+}
+
+RewindBuffer::Stats RewindBuffer::getStats() const {
+    Stats stats;
+    stats.ticks = count;
+    stats.memoryBytes = scratch.capacity() + frames.size() * sizeof(Frame) + keyframes.size() * sizeof(Keyframe);
+    for (const Frame& frame : frames) {
+        stats.memoryBytes += frame.delta.capacity();
+    }
+    for (const Keyframe& keyframe : keyframes) {
+        stats.memoryBytes += keyframe.snapshot.capacity();
+        if (keyframe.users > 0) ++stats.keyframes;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        stats.fullBytes += frames[(head + i) % frames.size()].fullBytes;
+    }
+    stats.lastRecordNanos = lastRecordNanos;
+    stats.averageRecordNanos = recordCount > 0 ? totalRecordNanos / static_cast<double>(recordCount) : 0.0;
+    return stats;
+}
+
+void RewindBuffer::clear() {
+    while (count > 0) dropNewest();
+    head = 0;
+}
+
+void RewindBuffer::dropOldest() {
+    releaseFrame(frames[head]);
+    head = (head + 1) % frames.size();
+    ++oldestTick;
+    --count;
+}
+
+void RewindBuffer::dropNewest() {
+    releaseFrame(frames[slotOf(getNewestTick())]);
+    --count;
+}
+
+void RewindBuffer::releaseFrame(Frame& frame) {
+    --keyframes[frame.keyframe].users;
+    frame.keyframe = NO_KEYFRAME;
+}
+
+std::size_t RewindBuffer::freeKeyframe() {
+    for (std::size_t i = 0; i < keyframes.size(); ++i) {
+        if (keyframes[i].users == 0) return i;
+    }
+    keyframes.emplace_back();
+    return keyframes.size() - 1;
+}
+
+} // namespace starship
@@ -0,0 +1,47 @@
+#include "starship/shape_library.hxx"
+#include <cmath>
+#include <random>
+
+namespace starship {
+
+namespace {
+
+constexpr float PI = 3.14159265358979323846f;
+
+} // namespace
+
+ShapeView AsteroidShapeLibrary::getShape(int sizeIndex, std::uint16_t variant) const {
+    if (!built) {
+        build();
+    }
+    std::size_t offset = (static_cast<std::size_t>(sizeIndex) * VARIANTS_PER_SIZE +
+                          variant % VARIANTS_PER_SIZE) * MAX_VERTICES;
+    return ShapeView{points.data() + offset, static_cast<std::size_t>(getVertexCount(sizeIndex))};
+}
+
+void AsteroidShapeLibrary::build() const {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(MIN_JITTER, MAX_JITTER);
+
+    for (int s = 0; s < SIZE_COUNT; ++s) {
+        int vertexCount = getVertexCount(s);
+        float baseRadius = radii[static_cast<std::size_t>(s)];
+
+        for (int v = 0; v < VARIANTS_PER_SIZE; ++v) {
+            Vector2D* outline = points.data() + (s * VARIANTS_PER_SIZE + v) * MAX_VERTICES;
+            for (int i = 0; i < vertexCount; ++i) {
+                float angle = 2.0f * PI * i / vertexCount;
+                float radius = baseRadius * jitter(rng);
+                outline[i] = Vector2D(std::cos(angle) * radius, std::sin(angle) * radius);
+            }
+        }
+    }
+    built = true;
+}
+
+const AsteroidShapeLibrary& AsteroidShapeLibrary::shared() {
+    static const AsteroidShapeLibrary library;
+    return library;
+}
+
+} // namespace starship
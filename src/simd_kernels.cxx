@@ -0,0 +1,481 @@
+#include "starship/simd_kernels.hxx"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define STARSHIP_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define STARSHIP_TARGET_AVX2
+#else
+#define STARSHIP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace starship {
+namespace simd {
+
+namespace {
+
+// sinCosDegrees reduces to [-45, 45] degrees around the nearest multiple of
+// 90, then evaluates the Cephes single-precision polynomials. Every backend
+// performs the same operations in the same order.
+constexpr float INV_QUADRANT = 1.0f / 90.0f;
+constexpr float QUADRANT = 90.0f;
+constexpr float DEG_TO_RAD = 0.017453292519943295f;
+constexpr float SIN_P0 = -1.9515295891e-4f;
+constexpr float SIN_P1 = 8.3321608736e-3f;
+constexpr float SIN_P2 = -1.6666654611e-1f;
+constexpr float COS_P0 = 2.443315711809948e-5f;
+constexpr float COS_P1 = -1.388731625493765e-3f;
+constexpr float COS_P2 = 4.166664568298827e-2f;
+
+// ---- Scalar ----------------------------------------------------------------
+
+void integrateScalar(float* x, float* y, const float* vx, const float* vy,
+                     std::size_t count, float dt) {
+    for (std::size_t i = 0; i < count; ++i) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+void advanceRotationScalar(float* rotation, const float* speed, std::size_t count, float dt) {
+    for (std::size_t i = 0; i < count; ++i) {
+        float r = rotation[i] + speed[i] * dt;
+        if (r >= 360.0f) r -= 360.0f;
+        if (r < 0.0f) r += 360.0f;
+        rotation[i] = r;
+    }
+}
+
+void advanceTimersScalar(float* value, std::size_t count, float dt) {
+    for (std::size_t i = 0; i < count; ++i) {
+        value[i] += dt;
+    }
+}
+
+void clearFlagAboveScalar(const float* value, std::uint8_t* flags, std::size_t count,
+                          float limit, std::uint8_t bit) {
+    const std::uint8_t keep = static_cast<std::uint8_t>(~bit);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (value[i] > limit) flags[i] &= keep;
+    }
+}
+
+void clearFlagBelowScalar(const float* value, std::uint8_t* flags, std::size_t count,
+                          float limit, std::uint8_t bit) {
+    const std::uint8_t keep = static_cast<std::uint8_t>(~bit);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (value[i] < limit) flags[i] &= keep;
+    }
+}
+
+void sinCosDegreesScalar(const float* degrees, float* sinOut, float* cosOut, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        // lrint rounds to nearest even, like cvtps2dq under the default MXCSR
+        int q = static_cast<int>(std::lrint(degrees[i] * INV_QUADRANT));
+        float x = (degrees[i] - static_cast<float>(q) * QUADRANT) * DEG_TO_RAD;
+        float z = x * x;
+        float s = ((SIN_P0 * z + SIN_P1) * z + SIN_P2) * z * x + x;
+        float c = ((COS_P0 * z + COS_P1) * z + COS_P2) * z * z - 0.5f * z + 1.0f;
+        if (q & 1) std::swap(s, c);
+        if (q & 2) s = -s;
+        if ((q + 1) & 2) c = -c;
+        sinOut[i] = s;
+        cosOut[i] = c;
+    }
+}
+
+void transformPointsScalar(const float* local, float* world, std::size_t count,
+                           float cosA, float sinA, float tx, float ty) {
+    for (std::size_t i = 0; i < count; ++i) {
+        float x = local[2 * i];
+        float y = local[2 * i + 1];
+        world[2 * i] = (x * cosA + y * -sinA) + tx;
+        world[2 * i + 1] = (y * cosA + x * sinA) + ty;
+    }
+}
+
+const Kernels scalarKernels = {
+    Backend::SCALAR,
+    integrateScalar,
+    advanceRotationScalar,
+    advanceTimersScalar,
+    clearFlagAboveScalar,
+    clearFlagBelowScalar,
+    sinCosDegreesScalar,
+    transformPointsScalar
+};
+
+#if defined(STARSHIP_SIMD_X86)
+
+// Byte masks for lane bitmasks: lane i set -> byte i is 0xFF
+struct LaneMasks {
+    std::uint64_t bytes[256];
+
+    LaneMasks() {
+        for (int m = 0; m < 256; ++m) {
+            std::uint64_t v = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (m & (1 << lane)) v |= std::uint64_t(0xFF) << (lane * 8);
+            }
+            bytes[m] = v;
+        }
+    }
+};
+
+const LaneMasks laneMasks;
+
+// Clear `bit` in `lanes` consecutive flags selected by the lane bitmask
+inline void clearFlags(std::uint8_t* flags, int laneBits, int lanes, std::uint8_t bit) {
+    if (laneBits == 0) return;
+    std::uint64_t word = 0;
+    std::memcpy(&word, flags, static_cast<std::size_t>(lanes));
+    word &= ~(laneMasks.bytes[laneBits] & (std::uint64_t(0x0101010101010101) * bit));
+    std::memcpy(flags, &word, static_cast<std::size_t>(lanes));
+}
+
+// ---- SSE2 ------------------------------------------------------------------
+
+void integrateSse2(float* x, float* y, const float* vx, const float* vy,
+                   std::size_t count, float dt) {
+    const __m128 step = _mm_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), step));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), step));
+        _mm_storeu_ps(x + i, px);
+        _mm_storeu_ps(y + i, py);
+    }
+    integrateScalar(x + i, y + i, vx + i, vy + i, count - i, dt);
+}
+
+void advanceRotationSse2(float* rotation, const float* speed, std::size_t count, float dt) {
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 full = _mm_set1_ps(360.0f);
+    const __m128 zero = _mm_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 r = _mm_add_ps(_mm_loadu_ps(rotation + i), _mm_mul_ps(_mm_loadu_ps(speed + i), step));
+        r = _mm_sub_ps(r, _mm_and_ps(_mm_cmpge_ps(r, full), full));
+        r = _mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, zero), full));
+        _mm_storeu_ps(rotation + i, r);
+    }
+    advanceRotationScalar(rotation + i, speed + i, count - i, dt);
+}
+
+void advanceTimersSse2(float* value, std::size_t count, float dt) {
+    const __m128 step = _mm_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(value + i, _mm_add_ps(_mm_loadu_ps(value + i), step));
+    }
+    advanceTimersScalar(value + i, count - i, dt);
+}
+
+void clearFlagAboveSse2(const float* value, std::uint8_t* flags, std::size_t count,
+                        float limit, std::uint8_t bit) {
+    const __m128 bound = _mm_set1_ps(limit);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        clearFlags(flags + i, _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(value + i), bound)), 4, bit);
+    }
+    clearFlagAboveScalar(value + i, flags + i, count - i, limit, bit);
+}
+
+void clearFlagBelowSse2(const float* value, std::uint8_t* flags, std::size_t count,
+                        float limit, std::uint8_t bit) {
+    const __m128 bound = _mm_set1_ps(limit);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        clearFlags(flags + i, _mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(value + i), bound)), 4, bit);
+    }
+    clearFlagBelowScalar(value + i, flags + i, count - i, limit, bit);
+}
+
+void sinCosDegreesSse2(const float* degrees, float* sinOut, float* cosOut, std::size_t count) {
+    const __m128 invQuadrant = _mm_set1_ps(INV_QUADRANT);
+    const __m128 quadrant = _mm_set1_ps(QUADRANT);
+    const __m128 degToRad = _mm_set1_ps(DEG_TO_RAD);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i oneBit = _mm_set1_epi32(1);
+    const __m128i twoBit = _mm_set1_epi32(2);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 deg = _mm_loadu_ps(degrees + i);
+        __m128i q = _mm_cvtps_epi32(_mm_mul_ps(deg, invQuadrant));
+        __m128 x = _mm_mul_ps(_mm_sub_ps(deg, _mm_mul_ps(_mm_cvtepi32_ps(q), quadrant)), degToRad);
+        __m128 z = _mm_mul_ps(x, x);
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_P0), z), _mm_set1_ps(SIN_P1));
+        s = _mm_add_ps(_mm_mul_ps(s, z), _mm_set1_ps(SIN_P2));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, z), x), x);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_P0), z), _mm_set1_ps(COS_P1));
+        c = _mm_add_ps(_mm_mul_ps(c, z), _mm_set1_ps(COS_P2));
+        c = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_mul_ps(c, z), z), _mm_mul_ps(half, z)), one);
+
+        // Odd quadrants swap sin and cos; the sign bits come from q and q + 1
+        __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, oneBit), oneBit));
+        __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, twoBit), 30));
+        __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, oneBit), twoBit), 30));
+        __m128 sr = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+        __m128 cr = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+        _mm_storeu_ps(sinOut + i, _mm_xor_ps(sr, sinSign));
+        _mm_storeu_ps(cosOut + i, _mm_xor_ps(cr, cosSign));
+    }
+    sinCosDegreesScalar(degrees + i, sinOut + i, cosOut + i, count - i);
+}
+
+void transformPointsSse2(const float* local, float* world, std::size_t count,
+                         float cosA, float sinA, float tx, float ty) {
+    // Two points per register: x0 y0 x1 y1, and swapped y0 x0 y1 x1
+    const __m128 c = _mm_set1_ps(cosA);
+    const __m128 s = _mm_setr_ps(-sinA, sinA, -sinA, sinA);
+    const __m128 t = _mm_setr_ps(tx, ty, tx, ty);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 p = _mm_loadu_ps(local + 2 * i);
+        __m128 swapped = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_ps(world + 2 * i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(p, c), _mm_mul_ps(swapped, s)), t));
+    }
+    transformPointsScalar(local + 2 * i, world + 2 * i, count - i, cosA, sinA, tx, ty);
+}
+
+const Kernels sse2Kernels = {
+    Backend::SSE2,
+    integrateSse2,
+    advanceRotationSse2,
+    advanceTimersSse2,
+    clearFlagAboveSse2,
+    clearFlagBelowSse2,
+    sinCosDegreesSse2,
+    transformPointsSse2
+};
+
+// ---- AVX2 ------------------------------------------------------------------
+// Each kernel hands its tail to the SSE2 version, which is compiled with
+// legacy (non-VEX) encoding. The upper ymm halves must be cleared first:
+// compilers do not always emit vzeroupper before such a tail call, and the
+// resulting SSE/AVX transition cost ~150 ns per call, dwarfing small loops.
+
+STARSHIP_TARGET_AVX2
+void integrateAvx2(float* x, float* y, const float* vx, const float* vy,
+                   std::size_t count, float dt) {
+    const __m256 step = _mm256_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), step));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), step));
+        _mm256_storeu_ps(x + i, px);
+        _mm256_storeu_ps(y + i, py);
+    }
+    _mm256_zeroupper();
+    integrateSse2(x + i, y + i, vx + i, vy + i, count - i, dt);
+}
+
+STARSHIP_TARGET_AVX2
+void advanceRotationAvx2(float* rotation, const float* speed, std::size_t count, float dt) {
+    const __m256 step = _mm256_set1_ps(dt);
+    const __m256 full = _mm256_set1_ps(360.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 r = _mm256_add_ps(_mm256_loadu_ps(rotation + i), _mm256_mul_ps(_mm256_loadu_ps(speed + i), step));
+        r = _mm256_sub_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, full, _CMP_GE_OQ), full));
+        r = _mm256_add_ps(r, _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_LT_OQ), full));
+        _mm256_storeu_ps(rotation + i, r);
+    }
+    _mm256_zeroupper();
+    advanceRotationSse2(rotation + i, speed + i, count - i, dt);
+}
+
+STARSHIP_TARGET_AVX2
+void advanceTimersAvx2(float* value, std::size_t count, float dt) {
+    const __m256 step = _mm256_set1_ps(dt);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(value + i, _mm256_add_ps(_mm256_loadu_ps(value + i), step));
+    }
+    _mm256_zeroupper();
+    advanceTimersSse2(value + i, count - i, dt);
+}
+
+STARSHIP_TARGET_AVX2
+void clearFlagAboveAvx2(const float* value, std::uint8_t* flags, std::size_t count,
+                        float limit, std::uint8_t bit) {
+    const __m256 bound = _mm256_set1_ps(limit);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int lanes = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(value + i), bound, _CMP_GT_OQ));
+        clearFlags(flags + i, lanes, 8, bit);
+    }
+    _mm256_zeroupper();
+    clearFlagAboveSse2(value + i, flags + i, count - i, limit, bit);
+}
+
+STARSHIP_TARGET_AVX2
+void clearFlagBelowAvx2(const float* value, std::uint8_t* flags, std::size_t count,
+                        float limit, std::uint8_t bit) {
+    const __m256 bound = _mm256_set1_ps(limit);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        int lanes = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(value + i), bound, _CMP_LT_OQ));
+        clearFlags(flags + i, lanes, 8, bit);
+    }
+    _mm256_zeroupper();
+    clearFlagBelowSse2(value + i, flags + i, count - i, limit, bit);
+}
+
+STARSHIP_TARGET_AVX2
+void sinCosDegreesAvx2(const float* degrees, float* sinOut, float* cosOut, std::size_t count) {
+    const __m256 invQuadrant = _mm256_set1_ps(INV_QUADRANT);
+    const __m256 quadrant = _mm256_set1_ps(QUADRANT);
+    const __m256 degToRad = _mm256_set1_ps(DEG_TO_RAD);
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256i oneBit = _mm256_set1_epi32(1);
+    const __m256i twoBit = _mm256_set1_epi32(2);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 deg = _mm256_loadu_ps(degrees + i);
+        __m256i q = _mm256_cvtps_epi32(_mm256_mul_ps(deg, invQuadrant));
+        __m256 x = _mm256_mul_ps(_mm256_sub_ps(deg, _mm256_mul_ps(_mm256_cvtepi32_ps(q), quadrant)), degToRad);
+        __m256 z = _mm256_mul_ps(x, x);
+
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_P0), z), _mm256_set1_ps(SIN_P1));
+        s = _mm256_add_ps(_mm256_mul_ps(s, z), _mm256_set1_ps(SIN_P2));
+        s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, z), x), x);
+
+        __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_P0), z), _mm256_set1_ps(COS_P1));
+        c = _mm256_add_ps(_mm256_mul_ps(c, z), _mm256_set1_ps(COS_P2));
+        c = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(c, z), z), _mm256_mul_ps(half, z)), one);
+
+        __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(q, oneBit), oneBit));
+        __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(q, twoBit), 30));
+        __m256 cosSign = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(q, oneBit), twoBit), 30));
+        __m256 sr = _mm256_blendv_ps(s, c, swap);
+        __m256 cr = _mm256_blendv_ps(c, s, swap);
+        _mm256_storeu_ps(sinOut + i, _mm256_xor_ps(sr, sinSign));
+        _mm256_storeu_ps(cosOut + i, _mm256_xor_ps(cr, cosSign));
+    }
+    _mm256_zeroupper();
+    sinCosDegreesSse2(degrees + i, sinOut + i, cosOut + i, count - i);
+}
+
+STARSHIP_TARGET_AVX2
+void transformPointsAvx2(const float* local, float* world, std::size_t count,
+                         float cosA, float sinA, float tx, float ty) {
+    const __m256 c = _mm256_set1_ps(cosA);
+    const __m256 s = _mm256_setr_ps(-sinA, sinA, -sinA, sinA, -sinA, sinA, -sinA, sinA);
+    const __m256 t = _mm256_setr_ps(tx, ty, tx, ty, tx, ty, tx, ty);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 p = _mm256_loadu_ps(local + 2 * i);
+        __m256 swapped = _mm256_permute_ps(p, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm256_storeu_ps(world + 2 * i,
+                         _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p, c), _mm256_mul_ps(swapped, s)), t));
+    }
+    _mm256_zeroupper();
+    transformPointsSse2(local + 2 * i, world + 2 * i, count - i, cosA, sinA, tx, ty);
+}
+
+const Kernels avx2Kernels = {
+    Backend::AVX2,
+    integrateAvx2,
+    advanceRotationAvx2,
+    advanceTimersAvx2,
+    clearFlagAboveAvx2,
+    clearFlagBelowAvx2,
+    sinCosDegreesAvx2,
+    transformPointsAvx2
+};
+
+bool cpuHasAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {0, 0, 0, 0};
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return avx2 && osxsave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // STARSHIP_SIMD_X86
+
+Backend detectBestBackend() {
+#if defined(STARSHIP_SIMD_X86)
+    if (cpuHasAvx2()) return Backend::AVX2;
+    return Backend::SSE2;
+#else
+    return Backend::SCALAR;
+#endif
+}
+
+std::atomic<const Kernels*> active{nullptr};
+
+} // namespace
+
+bool isSupported(Backend backend) {
+    switch (backend) {
+        case Backend::SCALAR:
+            return true;
+#if defined(STARSHIP_SIMD_X86)
+        case Backend::SSE2:
+            return true;
+        case Backend::AVX2:
+            return cpuHasAvx2();
+#endif
+        default:
+            return false;
+    }
+}
+
+const Kernels& kernelsFor(Backend backend) {
+    if (!isSupported(backend)) return scalarKernels;
+    switch (backend) {
+#if defined(STARSHIP_SIMD_X86)
+        case Backend::SSE2: return sse2Kernels;
+        case Backend::AVX2: return avx2Kernels;
+#endif
+        default:            return scalarKernels;
+    }
+}
+
+const Kernels& activeKernels() {
+    const Kernels* current = active.load(std::memory_order_acquire);
+    if (!current) {
+        current = &kernelsFor(detectBestBackend());
+        active.store(current, std::memory_order_release);
+    }
+    return *current;
+}
+
+bool setActiveBackend(Backend backend) {
+    if (!isSupported(backend)) return false;
+    active.store(&kernelsFor(backend), std::memory_order_release);
+    return true;
+}
+
+const char* getBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::SCALAR: return "scalar";
+        case Backend::SSE2:   return "sse2";
+        case Backend::AVX2:   return "avx2";
+        default:              return "unknown";
+    }
+}
+
+} // namespace simd
+} // namespace starship
@@ -0,0 +1,727 @@
+#include "starship/snapshot.hxx"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STARSHIP_SNAPSHOT_MMAP 1
+#else
+#define STARSHIP_SNAPSHOT_MMAP 0
+#endif
+
+namespace starship {
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'S', 'S', 'N'};
+constexpr std::uint16_t FORMAT_VERSION = 4;
+
+// Every section starts on this boundary, so columns can be read in place
+constexpr std::size_t SECTION_ALIGN = 16;
+
+// Leading sections, before the columns
+enum FixedSection : std::size_t {
+    SECTION_SCALARS,
+    SECTION_PLAYER,
+    FIXED_SECTION_COUNT
+};
+
+// Columns that must have matching lengths share a group: each store's
+// entity columns, each store's handle table, and the dormant asteroids
+constexpr int NO_GROUP = -1;
+constexpr int GROUP_COUNT = 7;
+constexpr int DORMANT_GROUP = 6;
+
+// Room in the section table; the current layout uses 55
+constexpr std::size_t MAX_SECTIONS = 64;
+
+struct Header {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t sectionCount;
+    std::uint64_t totalBytes;
+    std::uint64_t checksum;   // Game::checksum() of the captured state
+};
+
+struct Section {
+    std::uint64_t offset;
+    std::uint64_t bytes;
+};
+
+// Everything in Game outside the columns and the player
+struct Scalars {
+    float width;
+    float height;
+    std::uint32_t seed;
+    std::uint32_t spawnSerial;
+    std::uint64_t randomTick;
+    std::int32_t score;
+    std::int32_t level;
+    float shootCooldown;
+    float spawnTimer;
+    std::uint64_t effectEnds[PowerUp::TYPE_COUNT];
+    std::uint64_t timerTick;
+    float tickCarry;
+    float fixedTimestep;
+    std::int32_t maxSubsteps;
+    float accumulator;
+    std::uint64_t tickCount;
+    std::uint32_t shapeSeed;
+    std::uint8_t activeEffects;
+    std::uint8_t gameOver;
+    std::uint8_t polygonCollisions;
+    std::uint64_t holes[3];   // asteroids, projectiles, power-ups
+    float sectorSize;
+    std::int32_t activeRadius;
+    std::int32_t sectorColumns;
+    std::int32_t sectorRows;
+    std::uint32_t sectorCenter;
+    std::uint64_t dormantCount;
+};
+
+// Where each section of a game's snapshot comes from and where it goes.
+// Not copyable in practice: the first source points at `scalars`.
+struct Layout {
+    Header header;
+    std::array<Section, MAX_SECTIONS> table;
+    std::array<const void*, MAX_SECTIONS> sources;
+    Scalars scalars;
+};
+
+static_assert(MAX_SECTIONS <= UINT16_MAX, "section count is stored in 16 bits");
+static_assert(std::is_trivially_copyable<Starship>::value, "player is stored as raw bytes");
+static_assert(sizeof(Header) % alignof(Section) == 0, "section table follows the header");
+
+std::size_t alignUp(std::size_t n) {
+    return (n + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1);
+}
+
+template <typename T>
+std::size_t bytesOf(const std::vector<T>& column) {
+    return column.size() * sizeof(T);
+}
+
+std::size_t tableEnd(std::size_t sectionCount) {
+    return sizeof(Header) + sectionCount * sizeof(Section);
+}
+
+// Header and section table are well formed and every section lies inside
+// the buffer. Says nothing about the columns themselves.
+bool checkLayout(const std::uint8_t* data, std::size_t size) {
+    if (!data || size < sizeof(Header)) return false;
+    if (reinterpret_cast<std::uintptr_t>(data) % SECTION_ALIGN != 0) return false;
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if (header.version != FORMAT_VERSION || header.totalBytes != size) return false;
+    if (header.sectionCount < FIXED_SECTION_COUNT || header.sectionCount > MAX_SECTIONS ||
+        tableEnd(header.sectionCount) > size) return false;
+
+    const Section* table = reinterpret_cast<const Section*>(data + sizeof(Header));
+    for (std::size_t i = 0; i < header.sectionCount; ++i) {
+        const Section& s = table[i];
+        if (s.offset % SECTION_ALIGN != 0 || s.offset < tableEnd(header.sectionCount)) return false;
+        if (s.offset > size || s.bytes > size - s.offset) return false;
+    }
+    return table[SECTION_SCALARS].bytes == sizeof(Scalars) &&
+           table[SECTION_PLAYER].bytes == sizeof(Starship);
+}
+
+// Empty entry of every index column: a hole's id, a free handle's slot,
+// the end of a sector list
+constexpr std::uint32_t NO_INDEX = 0xFFFFFFFFu;
+static_assert(BodyColumns::NO_ID == NO_INDEX && HandleTable::NO_SLOT == NO_INDEX && WorldSectors::NONE == NO_INDEX,
+              "index columns share one empty value");
+
+// Every entry of a uint32 index column is below `limit`, or NO_INDEX
+// where `allowEmpty`
+bool indicesBelow(const std::uint8_t* data, const Section& s, std::uint64_t limit, bool allowEmpty) {
+    const std::uint32_t* first = reinterpret_cast<const std::uint32_t*>(data + s.offset);
+    const std::size_t count = s.bytes / sizeof(std::uint32_t);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (first[i] < limit) continue;
+        if (!allowEmpty || first[i] != NO_INDEX) return false;
+    }
+    return true;
+}
+
+// Entries of a uint32 index column that are not NO_INDEX
+std::uint64_t indexedCount(const std::uint8_t* data, const Section& s) {
+    const std::uint32_t* first = reinterpret_cast<const std::uint32_t*>(data + s.offset);
+    return static_cast<std::uint64_t>(
+        std::count_if(first, first + s.bytes / sizeof(std::uint32_t), [](std::uint32_t i) { return i != NO_INDEX; }));
+}
+
+// Every entry of an enum column is below `limit`
+template <typename E>
+bool enumsBelow(const std::uint8_t* data, const Section& s, int limit) {
+    using U = std::underlying_type_t<E>;
+    const U* first = reinterpret_cast<const U*>(data + s.offset);
+    return std::all_of(first, first + s.bytes / sizeof(U),
+                       [limit](U value) { return value >= 0 && value < static_cast<U>(limit); });
+}
+
+// Section table of a buffer that passed checkLayout
+const Section* sectionsOf(const std::uint8_t* data) {
+    return reinterpret_cast<const Section*>(data + sizeof(Header));
+}
+
+std::size_t sectionCountOf(const std::uint8_t* data) {
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.sectionCount;
+}
+
+std::uint64_t headerChecksum(const std::uint8_t* data, std::size_t size) {
+    if (!checkLayout(data, size)) return 0;
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    return header.checksum;
+}
+
+} // namespace
+
+// Befriended by Game, BodyColumns and HandleTable
+struct SnapshotAccess {
+    // Calls fn(column, group) for every column, in file order. `Owner` is
+    // Game or const Game.
+    template <typename Owner, typename Fn>
+    static void forEachColumn(Owner& game, Fn&& fn) {
+        store(game.asteroids, 0, fn, game.asteroids.rotation, game.asteroids.rotationSpeed,
+              game.asteroids.sizes, game.asteroids.shapeVariants);
+        store(game.projectiles, 2, fn, game.projectiles.expiresAt);
+        store(game.powerUps, 4, fn, game.powerUps.spawnedAt, game.powerUps.expiresAt, game.powerUps.types);
+        dormant(game.sectors, DORMANT_GROUP, fn);
+    }
+
+    template <typename Sectors, typename Fn>
+    static void dormant(Sectors& s, int group, Fn& fn) {
+        fn(s.x, group);
+        fn(s.y, group);
+        fn(s.vx, group);
+        fn(s.vy, group);
+        fn(s.rotation, group);
+        fn(s.rotationSpeed, group);
+        fn(s.sizes, group);
+        fn(s.shapeVariants, group);
+        fn(s.parkedAt, group);
+        fn(s.sectors, group);
+        fn(s.generations, group);
+        fn(s.next, group);
+        fn(s.prev, group);
+        fn(s.heads, NO_GROUP);
+        fn(s.freeSlots, NO_GROUP);
+    }
+
+    template <typename Store, typename Fn, typename... Extra>
+    static void store(Store& s, int group, Fn& fn, Extra&... extra) {
+        fn(s.x, group);
+        fn(s.y, group);
+        fn(s.vx, group);
+        fn(s.vy, group);
+        fn(s.radius, group);
+        fn(s.flags, group);
+        fn(s.ids, group);
+        (fn(extra, group), ...);
+        fn(s.handles.slots, group + 1);
+        fn(s.handles.generations, group + 1);
+        fn(s.handles.freeIds, NO_GROUP);
+    }
+
+    // Section holding `target`, one of game's columns
+    template <typename Column>
+    static const Section& sectionOf(const Game& game, const Section* table, const Column& target) {
+        std::size_t index = FIXED_SECTION_COUNT;
+        std::size_t found = 0;
+        forEachColumn(game, [&](const auto& column, int) {
+            if (static_cast<const void*>(&column) == static_cast<const void*>(&target)) found = index;
+            ++index;
+        });
+        return table[found];
+    }
+
+    // Every column used as an index points inside what it indexes, and
+    // every enum used to index a table is in range, so a damaged file
+    // cannot send the next tick out of bounds. Runs after the group
+    // lengths are known to match.
+    static bool checkIndices(const Game& game, const std::uint8_t* data, const Section* table, const Scalars& scalars,
+                             const std::array<std::uint64_t, GROUP_COUNT>& groupLength) {
+        auto store = [&](const auto& s, int group, std::uint64_t holes) {
+            const std::uint64_t slots = groupLength[group];
+            const std::uint64_t ids = groupLength[group + 1];
+            const Section& idSection = sectionOf(game, table, s.ids);
+            // More holes than empty slots would underflow liveCount()
+            return indicesBelow(data, idSection, ids, true) &&
+                   slots - indexedCount(data, idSection) >= holes &&
+                   indicesBelow(data, sectionOf(game, table, s.handles.slots), slots, true) &&
+                   indicesBelow(data, sectionOf(game, table, s.handles.freeIds), ids, false);
+        };
+        if (!store(game.asteroids, 0, scalars.holes[0]) || !store(game.projectiles, 2, scalars.holes[1]) ||
+            !store(game.powerUps, 4, scalars.holes[2])) return false;
+
+        // Sizes index the radius, score and outline tables, types the effects
+        if (!enumsBelow<Asteroid::Size>(data, sectionOf(game, table, game.asteroids.sizes),
+                                        AsteroidShapeLibrary::SIZE_COUNT) ||
+            !enumsBelow<Asteroid::Size>(data, sectionOf(game, table, game.sectors.sizes),
+                                        AsteroidShapeLibrary::SIZE_COUNT) ||
+            !enumsBelow<PowerUp::Type>(data, sectionOf(game, table, game.powerUps.types), PowerUp::TYPE_COUNT)) {
+            return false;
+        }
+
+        if (!(scalars.sectorSize >= 0.0f) || scalars.activeRadius < 0 ||
+            scalars.sectorColumns < 0 || scalars.sectorRows < 0) return false;
+        const std::uint64_t cells = static_cast<std::uint64_t>(scalars.sectorColumns) *
+                                    static_cast<std::uint64_t>(scalars.sectorRows);
+        if ((scalars.sectorSize > 0.0f) != (cells > 0)) return false;
+        if (scalars.sectorCenter != NO_INDEX && scalars.sectorCenter >= cells) return false;
+
+        const WorldSectors& sectors = game.sectors;
+        const std::uint64_t slots = groupLength[DORMANT_GROUP];
+        const Section& heads = sectionOf(game, table, sectors.heads);
+        const Section& parked = sectionOf(game, table, sectors.sectors);
+        return heads.bytes == cells * sizeof(std::uint32_t) &&
+               indicesBelow(data, heads, slots, true) &&
+               indicesBelow(data, parked, cells, true) &&
+               indicesBelow(data, sectionOf(game, table, sectors.next), slots, true) &&
+               indicesBelow(data, sectionOf(game, table, sectors.prev), slots, true) &&
+               indicesBelow(data, sectionOf(game, table, sectors.freeSlots), slots, false) &&
+               indexedCount(data, parked) == scalars.dormantCount;
+    }
+
+    // Header, section table and the source of every section for `game`
+    static void describe(const Game& game, bool withChecksum, Layout& layout) {
+        Scalars& scalars = layout.scalars;
+        scalars = Scalars{};
+        scalars.width = game.width;
+        scalars.height = game.height;
+        scalars.seed = game.seed;
+        scalars.spawnSerial = game.spawnSerial;
+        scalars.randomTick = game.randomTick;
+        scalars.score = game.score;
+        scalars.level = game.level;
+        scalars.shootCooldown = game.shootCooldown;
+        scalars.spawnTimer = game.spawnTimer;
+        std::copy(game.effectEnds.begin(), game.effectEnds.end(), scalars.effectEnds);
+        scalars.activeEffects = game.activeEffects;
+        scalars.timerTick = game.timerTick;
+        scalars.tickCarry = game.tickCarry;
+        scalars.fixedTimestep = game.fixedTimestep;
+        scalars.maxSubsteps = game.maxSubsteps;
+        scalars.accumulator = game.accumulator;
+        scalars.tickCount = game.tickCount;
+        scalars.shapeSeed = game.asteroids.shapeLibrary.getSeed();
+        scalars.gameOver = game.gameOver ? 1 : 0;
+        scalars.polygonCollisions = game.polygonCollisions ? 1 : 0;
+        scalars.holes[0] = game.asteroids.holes;
+        scalars.holes[1] = game.projectiles.holes;
+        scalars.holes[2] = game.powerUps.holes;
+        scalars.sectorSize = game.sectors.sectorSize;
+        scalars.activeRadius = game.sectors.activeRadius;
+        scalars.sectorColumns = game.sectors.columns;
+        scalars.sectorRows = game.sectors.rows;
+        scalars.sectorCenter = game.sectors.center;
+        scalars.dormantCount = game.sectors.count;
+
+        std::size_t sectionCount = FIXED_SECTION_COUNT;
+        forEachColumn(game, [&](const auto&, int) { ++sectionCount; });
+
+        std::size_t placed = 0;
+        std::size_t offset = alignUp(tableEnd(sectionCount));
+        auto place = [&](const void* source, std::size_t bytes) {
+            layout.sources[placed] = source;
+            layout.table[placed++] = Section{offset, bytes};
+            offset = alignUp(offset + bytes);
+        };
+        place(&scalars, sizeof(Scalars));
+        place(&game.player, sizeof(Starship));
+        forEachColumn(game, [&](const auto& column, int) { place(column.data(), bytesOf(column)); });
+
+        Header& header = layout.header;
+        header = Header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = FORMAT_VERSION;
+        header.sectionCount = static_cast<std::uint16_t>(sectionCount);
+        header.totalBytes = offset;
+        header.checksum = withChecksum ? game.checksum() : 0;
+    }
+
+    static void write(const Game& game, std::vector<std::uint8_t>& out, bool withChecksum) {
+        Layout layout;
+        describe(game, withChecksum, layout);
+        const std::size_t sectionCount = layout.header.sectionCount;
+
+        // Only the padding needs clearing; the sections are overwritten
+        out.resize(static_cast<std::size_t>(layout.header.totalBytes));
+        std::memset(out.data(), 0, layout.table[0].offset);
+        std::memcpy(out.data(), &layout.header, sizeof(Header));
+        std::memcpy(out.data() + sizeof(Header), layout.table.data(), sectionCount * sizeof(Section));
+        for (std::size_t i = 0; i < sectionCount; ++i) {
+            const Section& s = layout.table[i];
+            if (s.bytes != 0) std::memcpy(out.data() + s.offset, layout.sources[i], s.bytes);
+            std::size_t end = s.offset + s.bytes;
+            std::memset(out.data() + end, 0, alignUp(end) - end);
+        }
+    }
+
+    static bool read(const std::uint8_t* data, std::size_t size, Game& game) {
+        if (!checkLayout(data, size)) return false;
+
+        Header header;
+        std::memcpy(&header, data, sizeof(header));
+        const Section* table = reinterpret_cast<const Section*>(data + sizeof(Header));
+
+        Scalars scalars;
+        std::memcpy(&scalars, data + table[SECTION_SCALARS].offset, sizeof(scalars));
+
+        // Check every column against this build before touching the game
+        std::size_t next = FIXED_SECTION_COUNT;
+        bool valid = true;
+        std::array<std::uint64_t, GROUP_COUNT> groupLength;
+        groupLength.fill(~std::uint64_t(0));
+        forEachColumn(game, [&](const auto& column, int group) {
+            using T = typename std::decay_t<decltype(column)>::value_type;
+            if (next >= header.sectionCount) {
+                valid = false;
+                return;
+            }
+            const Section& s = table[next++];
+            if (s.bytes % sizeof(T) != 0) valid = false;
+            if (group == NO_GROUP) return;
+            std::uint64_t length = s.bytes / sizeof(T);
+            if (groupLength[group] == ~std::uint64_t(0)) groupLength[group] = length;
+            if (groupLength[group] != length) valid = false;
+        });
+        if (!valid || next != header.sectionCount) return false;
+        if (!(scalars.fixedTimestep > 0.0f)) return false;
+        if (!checkIndices(game, data, table, scalars, groupLength)) return false;
+
+        game.width = scalars.width;
+        game.height = scalars.height;
+        game.seed = scalars.seed;
+        game.spawnSerial = scalars.spawnSerial;
+        game.randomTick = scalars.randomTick;
+        game.score = scalars.score;
+        game.level = scalars.level;
+        game.shootCooldown = scalars.shootCooldown;
+        game.spawnTimer = scalars.spawnTimer;
+        std::copy(std::begin(scalars.effectEnds), std::end(scalars.effectEnds), game.effectEnds.begin());
+        game.activeEffects = scalars.activeEffects;
+        game.timerTick = scalars.timerTick;
+        game.tickCarry = scalars.tickCarry;
+        game.fixedTimestep = scalars.fixedTimestep;
+        game.maxSubsteps = scalars.maxSubsteps;
+        game.accumulator = scalars.accumulator;
+        game.tickCount = scalars.tickCount;
+        game.gameOver = scalars.gameOver != 0;
+        game.polygonCollisions = scalars.polygonCollisions != 0;
+        // Keep already generated outlines when restoring the same world
+        if (game.asteroids.shapeLibrary.getSeed() != scalars.shapeSeed) {
+            game.asteroids.shapeLibrary.setSeed(scalars.shapeSeed);
+        }
+        std::memcpy(static_cast<void*>(&game.player), data + table[SECTION_PLAYER].offset, sizeof(Starship));
+
+        // Columns are aligned, so each is one bulk copy out of the buffer
+        next = FIXED_SECTION_COUNT;
+        forEachColumn(game, [&](auto& column, int) {
+            using T = typename std::decay_t<decltype(column)>::value_type;
+            const Section& s = table[next++];
+            const T* first = reinterpret_cast<const T*>(data + s.offset);
+            column.assign(first, first + s.bytes / sizeof(T));
+        });
+        game.asteroids.holes = static_cast<std::size_t>(scalars.holes[0]);
+        game.projectiles.holes = static_cast<std::size_t>(scalars.holes[1]);
+        game.powerUps.holes = static_cast<std::size_t>(scalars.holes[2]);
+        game.sectors.sectorSize = scalars.sectorSize;
+        game.sectors.activeRadius = scalars.activeRadius;
+        game.sectors.columns = scalars.sectorColumns;
+        game.sectors.rows = scalars.sectorRows;
+        game.sectors.center = scalars.sectorCenter;
+        game.sectors.count = static_cast<std::size_t>(scalars.dormantCount);
+
+        game.commands.clear();
+        game.outlinesDirty = true;
+        game.asteroidBvh.invalidate();
+        game.powerUpBvh.invalidate();
+        // The wheel is an index over the expiry columns, effect ends and
+        // dormant asteroids
+        game.rebuildTimers();
+        return true;
+    }
+};
+
+Snapshot Snapshot::capture(const Game& game) {
+    Snapshot snapshot;
+    snapshot.assign(game);
+    return snapshot;
+}
+
+void Snapshot::assign(const Game& game, bool withChecksum) {
+    SnapshotAccess::write(game, bytes, withChecksum);
+}
+
+std::uint64_t Snapshot::getChecksum() const {
+    return headerChecksum(bytes.data(), bytes.size());
+}
+
+bool Snapshot::restore(Game& game) const {
+    return SnapshotAccess::read(bytes.data(), bytes.size(), game);
+}
+
+bool Snapshot::save(std::ostream& out) const {
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(out);
+}
+
+bool Snapshot::load(std::istream& in) {
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (!checkLayout(bytes.data(), bytes.size())) {
+        bytes.clear();
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::saveToFile(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    return out && save(out);
+}
+
+bool Snapshot::loadFromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return in && load(in);
+}
+
+MappedSnapshot::MappedSnapshot(MappedSnapshot&& other) noexcept
+    : mapped(std::exchange(other.mapped, nullptr)),
+      length(std::exchange(other.length, 0)),
+      ownsMapping(std::exchange(other.ownsMapping, false)),
+      fallback(std::move(other.fallback)) {}
+
+MappedSnapshot& MappedSnapshot::operator=(MappedSnapshot&& other) noexcept {
+    if (this != &other) {
+        close();
+        mapped = std::exchange(other.mapped, nullptr);
+        length = std::exchange(other.length, 0);
+        ownsMapping = std::exchange(other.ownsMapping, false);
+        fallback = std::move(other.fallback);
+    }
+    return *this;
+}
+
+bool MappedSnapshot::open(const std::string& path) {
+    close();
+#if STARSHIP_SNAPSHOT_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    void* address = MAP_FAILED;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+        address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (address == MAP_FAILED) return false;
+    mapped = static_cast<const std::uint8_t*>(address);
+    length = static_cast<std::size_t>(info.st_size);
+    ownsMapping = true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    mapped = fallback.data();
+    length = fallback.size();
+#endif
+    if (!checkLayout(mapped, length)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedSnapshot::close() {
+#if STARSHIP_SNAPSHOT_MMAP
+    if (ownsMapping) ::munmap(const_cast<std::uint8_t*>(mapped), length);
+#endif
+    mapped = nullptr;
+    length = 0;
+    ownsMapping = false;
+    fallback.clear();
+}
+
+std::uint64_t MappedSnapshot::getChecksum() const {
+    return headerChecksum(mapped, length);
+}
+
+namespace {
+
+// Granularity of SnapshotDelta: one cache line
+constexpr std::size_t DELTA_BLOCK = 64;
+
+std::size_t blockCount(std::size_t bytes) {
+    return (bytes + DELTA_BLOCK - 1) / DELTA_BLOCK;
+}
+
+template <typename T>
+void appendRaw(std::vector<std::uint8_t>& out, const T& value) {
+    const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+bool takeRaw(const std::uint8_t*& cursor, const std::uint8_t* end, T& value) {
+    if (static_cast<std::size_t>(end - cursor) < sizeof(T)) return false;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+// Appends one section's runs: (unchanged blocks, changed blocks) pairs,
+// each followed by the changed bytes, until the section is covered
+void encodeSection(const std::uint8_t* base, std::size_t baseBytes,
+                   const std::uint8_t* target, std::size_t targetBytes,
+                   std::vector<std::uint8_t>& out) {
+    // Whole column unchanged is the common case, and memcmp is fastest
+    const std::size_t blocks = blockCount(targetBytes);
+    if (baseBytes >= targetBytes && std::memcmp(base, target, targetBytes) == 0) {
+        if (blocks > 0) {
+            appendRaw(out, static_cast<std::uint32_t>(blocks));
+            appendRaw(out, std::uint32_t(0));
+        }
+        return;
+    }
+
+    auto sameBlock = [&](std::size_t b) {
+        std::size_t begin = b * DELTA_BLOCK;
+        std::size_t end = std::min(begin + DELTA_BLOCK, targetBytes);
+        return end <= baseBytes && std::memcmp(base + begin, target + begin, end - begin) == 0;
+    };
+    std::size_t b = 0;
+    while (b < blocks) {
+        std::size_t same = b;
+        while (same < blocks && sameBlock(same)) ++same;
+        std::size_t changed = same;
+        while (changed < blocks && !sameBlock(changed)) ++changed;
+
+        appendRaw(out, static_cast<std::uint32_t>(same - b));
+        appendRaw(out, static_cast<std::uint32_t>(changed - same));
+        std::size_t begin = std::min(same * DELTA_BLOCK, targetBytes);
+        std::size_t end = std::min(changed * DELTA_BLOCK, targetBytes);
+        out.insert(out.end(), target + begin, target + end);
+        b = changed;
+    }
+}
+
+} // namespace
+
+void SnapshotDelta::encode(const Snapshot& base, const Snapshot& target) {
+    bytes.clear();
+    const std::uint8_t* baseData = base.data();
+    const std::uint8_t* targetData = target.data();
+    if (!checkLayout(baseData, base.size()) || !checkLayout(targetData, target.size())) return;
+    const std::size_t count = sectionCountOf(targetData);
+    if (sectionCountOf(baseData) != count) return;
+
+    // Header and table verbatim, then the runs of every section
+    const std::size_t prefix = tableEnd(count);
+    bytes.insert(bytes.end(), targetData, targetData + prefix);
+    const Section* baseSections = sectionsOf(baseData);
+    const Section* targetSections = sectionsOf(targetData);
+    for (std::size_t i = 0; i < count; ++i) {
+        encodeSection(baseData + baseSections[i].offset, baseSections[i].bytes,
+                      targetData + targetSections[i].offset, targetSections[i].bytes, bytes);
+    }
+}
+
+void SnapshotDelta::encode(const Snapshot& base, const Game& game) {
+    bytes.clear();
+    const std::uint8_t* baseData = base.data();
+    if (!checkLayout(baseData, base.size())) return;
+    Layout layout;
+    SnapshotAccess::describe(game, false, layout);
+    const std::size_t count = layout.header.sectionCount;
+    if (sectionCountOf(baseData) != count) return;
+
+    const std::uint8_t* header = reinterpret_cast<const std::uint8_t*>(&layout.header);
+    const std::uint8_t* table = reinterpret_cast<const std::uint8_t*>(layout.table.data());
+    bytes.insert(bytes.end(), header, header + sizeof(Header));
+    bytes.insert(bytes.end(), table, table + count * sizeof(Section));
+    const Section* baseSections = sectionsOf(baseData);
+    for (std::size_t i = 0; i < count; ++i) {
+        encodeSection(baseData + baseSections[i].offset, baseSections[i].bytes,
+                      static_cast<const std::uint8_t*>(layout.sources[i]), layout.table[i].bytes, bytes);
+    }
+}
+
+std::size_t SnapshotDelta::getTargetSize() const {
+    if (bytes.size() < sizeof(Header)) return 0;
+    Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    return static_cast<std::size_t>(header.totalBytes);
+}
+
+bool SnapshotDelta::apply(const Snapshot& base, Snapshot& out) const {
+    const std::uint8_t* baseData = base.data();
+    if (bytes.size() < sizeof(Header) || !checkLayout(baseData, base.size())) return false;
+    const std::size_t count = sectionCountOf(bytes.data());
+    const std::size_t prefix = tableEnd(count);
+    if (count != sectionCountOf(baseData) || bytes.size() < prefix) return false;
+
+    const std::size_t total = getTargetSize();
+    std::vector<std::uint8_t>& target = out.bytes;
+    target.resize(total);
+    if (total < prefix) return false;
+    std::memcpy(target.data(), bytes.data(), prefix);
+    if (!checkLayout(target.data(), total)) return false;
+    std::memset(target.data() + prefix, 0, alignUp(prefix) - prefix);
+
+    const Section* baseSections = sectionsOf(baseData);
+    const Section* targetSections = sectionsOf(target.data());
+    const std::uint8_t* cursor = bytes.data() + prefix;
+    const std::uint8_t* end = bytes.data() + bytes.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::uint8_t* from = baseData + baseSections[i].offset;
+        const std::size_t fromBytes = baseSections[i].bytes;
+        std::uint8_t* to = target.data() + targetSections[i].offset;
+        const std::size_t toBytes = targetSections[i].bytes;
+        const std::size_t blocks = blockCount(toBytes);
+
+        std::size_t b = 0;
+        while (b < blocks) {
+            std::uint32_t same = 0;
+            std::uint32_t changed = 0;
+            if (!takeRaw(cursor, end, same) || !takeRaw(cursor, end, changed)) return false;
+            if (same + changed == 0 || same + changed > blocks - b) return false;
+
+            std::size_t begin = b * DELTA_BLOCK;
+            std::size_t middle = std::min((b + same) * DELTA_BLOCK, toBytes);
+            if (middle > fromBytes) return false;
+            std::memcpy(to + begin, from + begin, middle - begin);
+
+            std::size_t stop = std::min((b + same + changed) * DELTA_BLOCK, toBytes);
+            if (static_cast<std::size_t>(end - cursor) < stop - middle) return false;
+            std::memcpy(to + middle, cursor, stop - middle);
+            cursor += stop - middle;
+            b += same + changed;
+        }
+        // Padding after the section
+        std::size_t tail = targetSections[i].offset + toBytes;
+        std::memset(target.data() + tail, 0, alignUp(tail) - tail);
+    }
+    return cursor == end;
+}
+
+bool MappedSnapshot::restore(Game& game) const {
+    return SnapshotAccess::read(mapped, length, game);
+}
+
+} // namespace starship
@@ -0,0 +1,182 @@
+#include "starship/soak.hxx"
+#include "starship/alloc_tracker.hxx"
+#include "starship/tick_profiler.hxx"
+#include <algorithm>
+#include <chrono>
+
+namespace starship {
+
+namespace {
+
+constexpr float WIDTH = 800.0f;
+constexpr float HEIGHT = 600.0f;
+
+// Keeps the scenario's RNG apart from the game's own stream
+constexpr std::uint32_t SCENARIO_SEED_SALT = 0x9E3779B9u;
+
+// Top an effect up before it runs out, so it never lapses
+void keepEffect(Game& game, PowerUp::Type type, bool active) {
+    if (!active) game.applyPowerUp(type);
+}
+
+void keepShield(Game& game) {
+    keepEffect(game, PowerUp::Type::SHIELD, game.isShielded());
+}
+
+void keepWeapons(Game& game) {
+    keepEffect(game, PowerUp::Type::MULTI_SHOT, game.hasMultiShot());
+    keepEffect(game, PowerUp::Type::RAPID_FIRE, game.hasRapidFire());
+}
+
+// Late-game pressure: level 30 with a wave twice the usual rate, and
+// multi-shot and rapid fire that never run out
+SoakScenario asteroidStorm() {
+    constexpr int LEVEL = 30;
+    constexpr std::uint64_t WAVE_INTERVAL = 60;
+    SoakScenario s;
+    s.name = "asteroidStorm";
+    s.description = "Level 30 spawn rate doubled, permanent shield, multi-shot and rapid fire";
+    s.defaultTicks = 3600;
+    s.setup = [](SoakScenario::Context& ctx) {
+        ctx.game.setLevel(LEVEL);
+        ctx.game.spawnAsteroids(6 + LEVEL * 2);
+    };
+    s.drive = [](SoakScenario::Context& ctx) {
+        keepShield(ctx.game);
+        keepWeapons(ctx.game);
+        if (ctx.tick % WAVE_INTERVAL == 0) ctx.game.spawnAsteroids(1 + ctx.game.getLevel() / 3);
+        return static_cast<InputMask>(ctx.bot.decide(ctx.game) | INPUT_FIRE);
+    };
+    return s;
+}
+
+// Rows of large asteroids dropped low over a multi-shot, so every hit
+// splits and the fragments are hit again
+SoakScenario splittingCascade() {
+    constexpr std::uint64_t ROW_INTERVAL = 120;
+    constexpr int ROW_LENGTH = 24;
+    SoakScenario s;
+    s.name = "splittingCascade";
+    s.description = "Rows of 24 large asteroids every two seconds into a permanent multi-shot";
+    s.defaultTicks = 1800;
+    s.drive = [](SoakScenario::Context& ctx) {
+        keepShield(ctx.game);
+        keepWeapons(ctx.game);
+        if (ctx.tick % ROW_INTERVAL == 0) {
+            std::uniform_real_distribution<float> height(120.0f, 260.0f);
+            std::uniform_real_distribution<float> drift(-10.0f, 10.0f);
+            for (int i = 0; i < ROW_LENGTH; ++i) {
+                float x = (static_cast<float>(i) + 0.5f) * WIDTH / ROW_LENGTH;
+                ctx.game.spawnAsteroid(Vector2D(x, height(ctx.rng)), Vector2D(drift(ctx.rng), 20.0f),
+                                       Asteroid::Size::LARGE);
+            }
+        }
+        return static_cast<InputMask>(ctx.bot.decide(ctx.game) | INPUT_FIRE);
+    };
+    return s;
+}
+
+// Two power-ups a tick, so around a thousand are on screen for the bot
+// to chase and pick up
+SoakScenario powerUpFlood() {
+    constexpr int PER_TICK = 2;
+    SoakScenario s;
+    s.name = "powerUpFlood";
+    s.description = "Two power-ups dropped every tick while the bot collects them";
+    s.defaultTicks = 1800;
+    s.drive = [](SoakScenario::Context& ctx) {
+        std::uniform_real_distribution<float> x(0.0f, WIDTH);
+        std::uniform_real_distribution<float> y(0.0f, HEIGHT / 2);
+        for (int i = 0; i < PER_TICK; ++i) {
+            ctx.game.spawnPowerUp(Vector2D(x(ctx.rng), y(ctx.rng)));
+        }
+        return ctx.bot.decide(ctx.game);
+    };
+    return s;
+}
+
+// The unassisted game, five minutes of it, with the bot starting a new
+// round whenever it dies
+SoakScenario botSurvival() {
+    SoakScenario s;
+    s.name = "botSurvival";
+    s.description = "Five minutes of normal play by the bot, restarting after game over";
+    s.defaultTicks = 18000;
+    s.drive = [](SoakScenario::Context& ctx) { return ctx.bot.decide(ctx.game); };
+    return s;
+}
+
+} // namespace
+
+const std::vector<SoakScenario>& getSoakScenarios() {
+    static const std::vector<SoakScenario> scenarios = {
+        asteroidStorm(),
+        splittingCascade(),
+        powerUpFlood(),
+        botSurvival(),
+    };
+    return scenarios;
+}
+
+const SoakScenario* findSoakScenario(const std::string& name) {
+    for (const SoakScenario& s : getSoakScenarios()) {
+        if (s.name == name) return &s;
+    }
+    return nullptr;
+}
+
+SoakReport runSoak(const SoakScenario& scenario, std::uint32_t seed, std::uint64_t ticks) {
+    using Clock = std::chrono::steady_clock;
+    if (ticks == 0) ticks = scenario.defaultTicks;
+
+    Game game(WIDTH, HEIGHT, seed);
+    BotPlayer bot;
+    std::mt19937 rng(seed ^ SCENARIO_SEED_SALT);
+    SoakScenario::Context ctx{game, bot, rng, 0};
+    if (scenario.setup) scenario.setup(ctx);
+
+    SoakReport report;
+    report.name = scenario.name;
+    report.seed = seed;
+    report.ticks = ticks;
+
+    const bool tracking = alloc::isTracking();
+    LatencyHistogram latency;
+    Clock::duration total{};
+    for (std::uint64_t t = 0; t < ticks; ++t) {
+        ctx.tick = t;
+        const InputMask input = scenario.drive ? scenario.drive(ctx) : InputMask{INPUT_NONE};
+        const bool wasOver = game.isGameOver();
+
+        const Clock::time_point start = Clock::now();
+        game.step(input);
+        const Clock::duration elapsed = Clock::now() - start;
+        total += elapsed;
+        latency.record(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+        if (!wasOver && game.isGameOver()) ++report.deaths;
+        report.peakAsteroids = std::max(report.peakAsteroids, game.getAsteroids().liveCount());
+        report.peakProjectiles = std::max(report.peakProjectiles, game.getProjectiles().liveCount());
+        report.peakPowerUps = std::max(report.peakPowerUps, game.getPowerUps().liveCount());
+        report.maxLevel = std::max(report.maxLevel, game.getLevel());
+        if (tracking) {
+            // step() restarts the process-wide peak every tick
+            const TickAllocations& allocations = game.getLastTickAllocations();
+            report.peakLiveBytes = std::max(report.peakLiveBytes, allocations.peakLiveBytes);
+            if (allocations.total.allocations > 0) ++report.allocatingTicks;
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(total).count();
+    report.ticksPerSecond = report.seconds > 0.0 ? static_cast<double>(ticks) / report.seconds : 0.0;
+    report.tickP50 = latency.percentile(50);
+    report.tickP99 = latency.percentile(99);
+    report.tickP999 = latency.percentile(99.9);
+    report.tickMax = latency.getMax();
+    report.score = game.getScore();
+    report.checksum = game.checksum();
+    return report;
+}
+
+} // namespace starship
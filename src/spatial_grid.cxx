@@ -0,0 +1,135 @@
+#include "starship/spatial_grid.hxx"
+#include <algorithm>
+#include <cmath>
+
+namespace starship {
+
+namespace {
+
+// Keeps cell coordinates well inside int32 range for far-away entities
+constexpr float kMaxCellCoord = 1.0e9f;
+
+} // namespace
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize),
+      inverseCellSize(1.0f / cellSize),
+      maxRadius(0.0f),
+      bucketMask(0) {
+    bucketStart.assign(2, 0);
+}
+
+void SpatialGrid::setCellSize(float size) {
+    cellSize = size;
+    inverseCellSize = 1.0f / size;
+}
+
+void SpatialGrid::clear(std::size_t expectedCount) {
+    pendingIds.clear();
+    pendingCells.clear();
+    if (pendingIds.capacity() < expectedCount) {
+        pendingIds.reserve(expectedCount);
+        pendingCells.reserve(expectedCount);
+    }
+    maxRadius = 0.0f;
+}
+
+void SpatialGrid::reserve(std::size_t count) {
+    std::uint32_t bucketCount = 64;
+    while (bucketCount < count) {
+        bucketCount <<= 1;
+    }
+    pendingIds.reserve(count);
+    pendingCells.reserve(count);
+    pendingBuckets.reserve(count);
+    bucketStart.reserve(bucketCount + 1);
+    sortedIds.reserve(count);
+    sortedCells.reserve(count);
+}
+
+std::int32_t SpatialGrid::cellCoord(float v) const {
+    float c = std::floor(v * inverseCellSize);
+    c = std::max(-kMaxCellCoord, std::min(kMaxCellCoord, c));
+    return static_cast<std::int32_t>(c);
+}
+
+void SpatialGrid::insert(std::uint32_t id, const Vector2D& pos, float radius) {
+    pendingIds.push_back(id);
+    pendingCells.push_back(packCell(cellCoord(pos.x), cellCoord(pos.y)));
+    maxRadius = std::max(maxRadius, radius);
+}
+
+void SpatialGrid::sizeTable(std::size_t count) {
+    // Power-of-two table with at least one bucket per item
+    std::uint32_t bucketCount = 64;
+    while (bucketCount < count) {
+        bucketCount <<= 1;
+    }
+    bucketMask = bucketCount - 1;
+}
+
+void SpatialGrid::build() {
+    const std::size_t count = pendingIds.size();
+    sizeTable(count);
+    pendingBuckets.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        pendingBuckets[i] = bucketFor(pendingCells[i]);
+    }
+    scatter();
+}
+
+void SpatialGrid::build(const float* x, const float* y, const float* radius,
+                        const std::uint8_t* flags, std::uint8_t activeMask, std::size_t count) {
+    pendingIds.clear();
+    pendingCells.clear();
+    maxRadius = 0.0f;
+
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        live += (flags[i] & activeMask) ? 1 : 0;
+    }
+    sizeTable(live);
+
+    pendingIds.resize(live);
+    pendingCells.resize(live);
+    pendingBuckets.resize(live);
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (!(flags[i] & activeMask)) continue;
+        std::uint64_t cell = packCell(cellCoord(x[i]), cellCoord(y[i]));
+        pendingIds[k] = static_cast<std::uint32_t>(i);
+        pendingCells[k] = cell;
+        pendingBuckets[k] = bucketFor(cell);
+        maxRadius = std::max(maxRadius, radius[i]);
+        ++k;
+    }
+    scatter();
+}
+
+void SpatialGrid::scatter() {
+    const std::size_t count = pendingIds.size();
+    const std::uint32_t bucketCount = bucketMask + 1;
+
+    bucketStart.assign(bucketCount + 1, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        bucketStart[pendingBuckets[i] + 1]++;
+    }
+    for (std::uint32_t b = 0; b < bucketCount; ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    sortedIds.resize(count);
+    sortedCells.resize(count);
+    // Scatter using bucketStart as running cursors, then shift it back
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t slot = bucketStart[pendingBuckets[i]]++;
+        sortedIds[slot] = pendingIds[i];
+        sortedCells[slot] = pendingCells[i];
+    }
+    for (std::uint32_t b = bucketCount; b > 0; --b) {
+        bucketStart[b] = bucketStart[b - 1];
+    }
+    bucketStart[0] = 0;
+}
+
+} // namespace starship
@@ -0,0 +1,120 @@
+#include "starship/thread_pool.hxx"
+#include <algorithm>
+#include <chrono>
+
+namespace starship {
+
+namespace {
+
+// Which pool slot the current thread owns, if it is a pool worker
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentPoolSlot = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : queued(0),
+      stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<std::size_t>(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::currentSlot() const {
+    return currentPool == this ? currentPoolSlot : 0;
+}
+
+void ThreadPool::run(TaskFn fn, void* context, std::size_t count, std::size_t grain) {
+    const std::size_t chunks = (count + grain - 1) / grain;
+    const std::size_t self = currentSlot();
+    std::atomic<std::size_t> remaining(chunks);
+
+    // Announce the work first so a worker never sees a negative count
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        queued.fetch_add(chunks);
+    }
+
+    // Deal chunks round-robin so every thread starts with local work
+    for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t begin = c * grain;
+        Task task{fn, context, begin, std::min(count, begin + grain), &remaining};
+        Queue& queue = *queues[(self + c) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(task);
+    }
+    wake.notify_all();
+
+    // Help until our loop is done; this may also run other loops' chunks
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!tryRunOne(self)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool ThreadPool::popLocal(std::size_t self, Task& task) {
+    Queue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t self, Task& task) {
+    for (std::size_t k = 1; k < queues.size(); ++k) {
+        Queue& queue = *queues[(self + k) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::tryRunOne(std::size_t self) {
+    Task task;
+    if (!popLocal(self, task) && !steal(self, task)) {
+        return false;
+    }
+    queued.fetch_sub(1);
+    task.fn(task.context, task.begin, task.end);
+    task.remaining->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t self) {
+    currentPool = this;
+    currentPoolSlot = self;
+    for (;;) {
+        if (tryRunOne(self)) continue;
+
+        // Timed wait: an idle worker rechecks the queues now and then even
+        // if a wakeup was missed
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait_for(lock, std::chrono::milliseconds(50),
+                      [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+} // namespace starship
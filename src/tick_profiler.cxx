@@ -0,0 +1,97 @@
+#include "starship/tick_profiler.hxx"
+#include <algorithm>
+#include <cmath>
+
+namespace starship {
+
+namespace {
+
+// Index of the highest set bit; `value` must be non-zero
+int highestBit(std::uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#else
+    int bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+} // namespace
+
+const char* getPhaseName(TickPhase phase) {
+    switch (phase) {
+        case TickPhase::UPDATE:     return "update";
+        case TickPhase::INTEGRATE:  return "integrate";
+        case TickPhase::TIMERS:     return "timers";
+        case TickPhase::SECTORS:    return "sectors";
+        case TickPhase::COLLISIONS: return "collisions";
+        case TickPhase::RELEASE:    return "release";
+        case TickPhase::SPAWN:      return "spawn";
+        case TickPhase::LEVEL:      return "level";
+        case TickPhase::INPUT:      return "input";
+        default:                    return "?";
+    }
+}
+
+std::size_t LatencyHistogram::bucketOf(std::uint64_t nanos) {
+    // Small values get a bucket each
+    if (nanos < static_cast<std::uint64_t>(SUB_BUCKETS)) return static_cast<std::size_t>(nanos);
+    int bit = std::min(highestBit(nanos), MAX_BITS);
+    int shift = bit - SUB_BUCKET_BITS;
+    std::uint64_t sub = std::min<std::uint64_t>((nanos >> shift) - SUB_BUCKETS, SUB_BUCKETS - 1);
+    return static_cast<std::size_t>(shift + 1) * SUB_BUCKETS + static_cast<std::size_t>(sub);
+}
+
+std::uint64_t LatencyHistogram::upperEdge(std::size_t bucket) {
+    if (bucket < static_cast<std::size_t>(SUB_BUCKETS)) return bucket;
+    int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+    std::uint64_t sub = bucket % SUB_BUCKETS;
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::uint64_t nanos) {
+    if (buckets.empty()) buckets.assign(BUCKET_COUNT, 0);
+    ++buckets[bucketOf(nanos)];
+    min = count > 0 ? std::min(min, nanos) : nanos;
+    max = std::max(max, nanos);
+    total += nanos;
+    ++count;
+}
+
+std::uint64_t LatencyHistogram::percentile(double p) const {
+    if (count == 0) return 0;
+    p = std::min(std::max(p, 0.0), 100.0);
+    // Rank of the sample wanted, 1-based
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count)));
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        // The last bucket is open-ended
+        if (seen >= rank) return i + 1 < buckets.size() ? std::min(upperEdge(i), max) : max;
+    }
+    return max;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.count == 0) return;
+    if (buckets.empty()) buckets.assign(BUCKET_COUNT, 0);
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    min = count > 0 ? std::min(min, other.min) : other.min;
+    max = std::max(max, other.max);
+    total += other.total;
+    count += other.count;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(buckets.begin(), buckets.end(), 0u);
+    count = 0;
+    total = 0;
+    min = 0;
+    max = 0;
+}
+
+} // namespace starship
@@ -0,0 +1,118 @@
+#include "starship/timer_wheel.hxx"
+#include <algorithm>
+
+namespace starship {
+
+namespace {
+
+constexpr std::uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+// Ticks below this many bits of the current tick belong to the wheel;
+// anything that differs above them waits in the overflow list
+constexpr unsigned RANGE_BITS = TimerWheel::SLOT_BITS * TimerWheel::LEVELS;
+
+} // namespace
+
+TimerWheel::TimerWheel(std::uint64_t now) {
+    reset(now);
+}
+
+void TimerWheel::reset(std::uint64_t now) {
+    current = now;
+    pending = 0;
+    nodes.clear();
+    freeList = NONE;
+    overflow = NONE;
+    for (auto& level : slots) std::fill(std::begin(level), std::end(level), NONE);
+    std::fill(std::begin(levelCounts), std::end(levelCounts), 0);
+}
+
+void TimerWheel::schedule(std::uint64_t deadline, std::uint32_t kind, std::uint32_t id, std::uint32_t generation) {
+    std::uint32_t index;
+    if (freeList != NONE) {
+        index = freeList;
+        freeList = nodes[index].next;
+    } else {
+        index = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(Node{});
+    }
+    nodes[index].timer = Timer{deadline, kind, id, generation};
+    ++pending;
+    // The current tick's slot has already been emptied
+    place(index, current + 1);
+}
+
+void TimerWheel::place(std::uint32_t index, std::uint64_t earliest) {
+    const std::uint64_t key = std::max(nodes[index].timer.deadline, earliest);
+
+    // The lowest level whose slot range holds both `key` and the current
+    // tick: there, key's slot is still ahead of the clock in this turn
+    std::uint32_t* head = &overflow;
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        const unsigned above = SLOT_BITS * (level + 1);
+        if ((key >> above) == (current >> above)) {
+            head = &slots[level][(key >> (SLOT_BITS * level)) & SLOT_MASK];
+            ++levelCounts[level];
+            break;
+        }
+    }
+    nodes[index].next = *head;
+    *head = index;
+}
+
+void TimerWheel::cascade(std::uint32_t& head, unsigned level) {
+    std::uint32_t index = head;
+    head = NONE;
+    while (index != NONE) {
+        const std::uint32_t next = nodes[index].next;
+        if (level < LEVELS) --levelCounts[level];
+        place(index, current);
+        index = next;
+    }
+}
+
+void TimerWheel::advance(std::uint64_t now, std::vector<Timer>& fired) {
+    while (current < now) {
+        if (pending == 0) {
+            current = now;
+            break;
+        }
+        // With the lower levels empty, nothing happens before the next
+        // slot boundary of the lowest level in use
+        unsigned lowest = 0;
+        while (lowest < LEVELS && levelCounts[lowest] == 0) ++lowest;
+        if (lowest > 0) {
+            const unsigned shift = SLOT_BITS * lowest;
+            const std::uint64_t boundary = ((current >> shift) + 1) << shift;
+            current = std::min(now, boundary - 1);
+            if (current == now) break;
+        }
+        ++current;
+
+        // Entering a new turn of a level pulls its next slot down, from
+        // the top so a timer can fall through several levels at once
+        if ((current & ((std::uint64_t(1) << RANGE_BITS) - 1)) == 0) cascade(overflow, LEVELS);
+        for (unsigned level = LEVELS - 1; level > 0; --level) {
+            const unsigned shift = SLOT_BITS * level;
+            if ((current & ((std::uint64_t(1) << shift) - 1)) == 0) {
+                cascade(slots[level][(current >> shift) & SLOT_MASK], level);
+            }
+        }
+
+        std::uint32_t& head = slots[0][current & SLOT_MASK];
+        std::uint32_t index = head;
+        head = NONE;
+        while (index != NONE) {
+            Node& node = nodes[index];
+            const std::uint32_t next = node.next;
+            fired.push_back(node.timer);
+            node.next = freeList;
+            freeList = index;
+            --pending;
+            --levelCounts[0];
+            index = next;
+        }
+    }
+}
+
+} // namespace starship
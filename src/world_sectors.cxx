@@ -0,0 +1,191 @@
+#include "starship/world_sectors.hxx"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace starship {
+
+namespace {
+
+// Wrap an angle in degrees into [0, 360)
+float wrapDegrees(float degrees) {
+    float r = std::fmod(degrees, 360.0f);
+    return r < 0.0f ? r + 360.0f : r;
+}
+
+// Seconds until a point at `p` moving at `v` leaves cell `cell` of
+// `cells`, each `size` wide. The outer cells reach to infinity.
+float secondsToLeaveCell(float p, float v, int cell, int cells, float size) {
+    if (v > 0.0f && cell < cells - 1) return std::max(0.0f, ((cell + 1) * size - p) / v);
+    if (v < 0.0f && cell > 0) return std::max(0.0f, (cell * size - p) / v);
+    return WorldSectors::NEVER;
+}
+
+// Cell holding `cells`-relative coordinate `p`, clamped to [0, cells)
+int cellOf(float p, int cells) {
+    if (!(p >= 0.0f)) return 0;
+    if (p >= static_cast<float>(cells)) return cells - 1;
+    return static_cast<int>(p);
+}
+
+} // namespace
+
+void WorldSectors::configure(float width, float height, float size, int radius) {
+    clear();
+    sectorSize = size > 0.0f ? size : 0.0f;
+    activeRadius = std::max(0, radius);
+    center = NONE;
+    if (isEnabled()) {
+        columns = std::max(1, static_cast<int>(std::ceil(width / sectorSize)));
+        rows = std::max(1, static_cast<int>(std::ceil(height / sectorSize)));
+    } else {
+        columns = 0;
+        rows = 0;
+    }
+    heads.assign(static_cast<std::size_t>(columns) * static_cast<std::size_t>(rows), NONE);
+}
+
+std::uint32_t WorldSectors::sectorAt(float px, float py) const {
+    return static_cast<std::uint32_t>(cellOf(py / sectorSize, rows) * columns + cellOf(px / sectorSize, columns));
+}
+
+bool WorldSectors::isWithin(std::uint32_t sector, std::uint32_t other, int radius) const {
+    const std::uint32_t c = static_cast<std::uint32_t>(columns);
+    const int dx = static_cast<int>(sector % c) - static_cast<int>(other % c);
+    const int dy = static_cast<int>(sector / c) - static_cast<int>(other / c);
+    return std::abs(dx) <= radius && std::abs(dy) <= radius;
+}
+
+std::uint32_t WorldSectors::park(const CommandBuffer::AsteroidSpawn& asteroid, std::uint64_t tick) {
+    std::uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<std::uint32_t>(sectors.size());
+        x.push_back(0.0f);
+        y.push_back(0.0f);
+        vx.push_back(0.0f);
+        vy.push_back(0.0f);
+        rotation.push_back(0.0f);
+        rotationSpeed.push_back(0.0f);
+        sizes.push_back(Asteroid::Size::LARGE);
+        shapeVariants.push_back(0);
+        parkedAt.push_back(0);
+        sectors.push_back(NONE);
+        generations.push_back(0);
+        next.push_back(NONE);
+        prev.push_back(NONE);
+    }
+    x[slot] = asteroid.position.x;
+    y[slot] = asteroid.position.y;
+    vx[slot] = asteroid.velocity.x;
+    vy[slot] = asteroid.velocity.y;
+    rotation[slot] = asteroid.rotation;
+    rotationSpeed[slot] = asteroid.rotationSpeed;
+    sizes[slot] = asteroid.size;
+    shapeVariants[slot] = asteroid.shapeVariant;
+    parkedAt[slot] = tick;
+    link(slot, sectorAt(asteroid.position.x, asteroid.position.y));
+    ++count;
+    return slot;
+}
+
+CommandBuffer::AsteroidSpawn WorldSectors::unpark(std::uint32_t slot, std::uint64_t tick, float timestep) {
+    advance(slot, tick, timestep);
+    CommandBuffer::AsteroidSpawn asteroid;
+    asteroid.position = Vector2D(x[slot], y[slot]);
+    asteroid.velocity = Vector2D(vx[slot], vy[slot]);
+    asteroid.size = sizes[slot];
+    asteroid.rotation = rotation[slot];
+    asteroid.rotationSpeed = rotationSpeed[slot];
+    asteroid.shapeVariant = shapeVariants[slot];
+    remove(slot);
+    return asteroid;
+}
+
+void WorldSectors::remove(std::uint32_t slot) {
+    unlink(slot);
+    release(slot);
+}
+
+void WorldSectors::advance(std::uint32_t slot, std::uint64_t tick, float timestep) {
+    if (tick <= parkedAt[slot]) return;
+    const float seconds = static_cast<float>(tick - parkedAt[slot]) * timestep;
+    x[slot] += vx[slot] * seconds;
+    y[slot] += vy[slot] * seconds;
+    rotation[slot] = wrapDegrees(rotation[slot] + rotationSpeed[slot] * seconds);
+    parkedAt[slot] = tick;
+
+    const std::uint32_t sector = sectorAt(x[slot], y[slot]);
+    if (sector != sectors[slot]) {
+        unlink(slot);
+        link(slot, sector);
+    }
+}
+
+void WorldSectors::clear() {
+    for (std::uint32_t slot = 0; slot < sectors.size(); ++slot) {
+        if (sectors[slot] != NONE) release(slot);
+    }
+    std::fill(heads.begin(), heads.end(), NONE);
+    center = NONE;
+}
+
+void WorldSectors::reserve(std::size_t n) {
+    x.reserve(n);
+    y.reserve(n);
+    vx.reserve(n);
+    vy.reserve(n);
+    rotation.reserve(n);
+    rotationSpeed.reserve(n);
+    sizes.reserve(n);
+    shapeVariants.reserve(n);
+    parkedAt.reserve(n);
+    sectors.reserve(n);
+    generations.reserve(n);
+    next.reserve(n);
+    prev.reserve(n);
+    freeSlots.reserve(n);
+}
+
+float WorldSectors::secondsToLeaveSector(std::uint32_t slot) const {
+    const std::uint32_t c = static_cast<std::uint32_t>(columns);
+    const int cx = static_cast<int>(sectors[slot] % c);
+    const int cy = static_cast<int>(sectors[slot] / c);
+    return std::min(secondsToLeaveCell(x[slot], vx[slot], cx, columns, sectorSize),
+                    secondsToLeaveCell(y[slot], vy[slot], cy, rows, sectorSize));
+}
+
+Vector2D WorldSectors::positionAt(std::uint32_t slot, std::uint64_t tick, float timestep) const {
+    const float seconds = tick > parkedAt[slot] ? static_cast<float>(tick - parkedAt[slot]) * timestep : 0.0f;
+    return Vector2D(x[slot] + vx[slot] * seconds, y[slot] + vy[slot] * seconds);
+}
+
+void WorldSectors::link(std::uint32_t slot, std::uint32_t sector) {
+    sectors[slot] = sector;
+    prev[slot] = NONE;
+    next[slot] = heads[sector];
+    if (heads[sector] != NONE) prev[heads[sector]] = slot;
+    heads[sector] = slot;
+}
+
+void WorldSectors::unlink(std::uint32_t slot) {
+    if (prev[slot] != NONE) {
+        next[prev[slot]] = next[slot];
+    } else {
+        heads[sectors[slot]] = next[slot];
+    }
+    if (next[slot] != NONE) prev[next[slot]] = prev[slot];
+    next[slot] = NONE;
+    prev[slot] = NONE;
+}
+
+void WorldSectors::release(std::uint32_t slot) {
+    sectors[slot] = NONE;
+    ++generations[slot];
+    freeSlots.push_back(slot);
+    --count;
+}
+
+} // namespace starship
@@ -0,0 +1,121 @@
+// tests/alloc_tracker_test.cxx
+// Built as its own binary, linked with starship_alloc_hooks
+#include <gtest/gtest.h>
+#include "starship/basic_game.hxx"
+#include "starship/game.hxx"
+#include "starship/alloc_tracker.hxx"
+#include <memory>
+#include <vector>
+
+using starship::TickAllocations;
+using starship::TickPhase;
+namespace alloc = starship::alloc;
+
+namespace {
+
+std::size_t trappedAllocations = 0;
+
+void countTrap(std::size_t) {
+    ++trappedAllocations;
+}
+
+} // namespace
+
+class AllocTrackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trappedAllocations = 0;
+        alloc::setTrapHandler(countTrap);
+    }
+    void TearDown() override {
+        alloc::setTrapHandler(nullptr);
+    }
+};
+
+TEST_F(AllocTrackerTest, CountsAllocationsByPhase) {
+    ASSERT_TRUE(alloc::isTracking());
+
+    TickAllocations start = alloc::threadCounters();
+    std::uint64_t liveBefore = alloc::getLiveBytes();
+    auto block = std::make_unique<char[]>(1000);
+    {
+        alloc::PhaseScope phase(TickPhase::SPAWN);
+        std::vector<int> v(10);
+    }
+    TickAllocations used = alloc::since(start);
+
+    EXPECT_EQ(used.total.allocations, 2u);
+    EXPECT_EQ(used.total.frees, 1u);
+    EXPECT_EQ(used[TickPhase::SPAWN].allocations, 1u);
+    EXPECT_EQ(used[TickPhase::SPAWN].bytes, 10 * sizeof(int));
+    EXPECT_EQ(used[TickPhase::UPDATE].allocations, 0u);
+    EXPECT_GE(alloc::getLiveBytes(), liveBefore + 1000);
+
+    alloc::resetPeak();
+    std::uint64_t peakBefore = alloc::getPeakLiveBytes();
+    block.reset();
+    { std::vector<char> big(1 << 20); }
+    EXPECT_GE(alloc::getPeakLiveBytes(), peakBefore + (1 << 20) - 1000);
+}
+
+TEST_F(AllocTrackerTest, TrapReportsEveryAllocation) {
+    {
+        alloc::Trap trap;
+        std::vector<int> v(4);
+        v.resize(100);
+    }
+    EXPECT_EQ(trappedAllocations, 2u);
+
+    std::vector<int> outside(4);
+    EXPECT_EQ(trappedAllocations, 2u);
+}
+
+TEST_F(AllocTrackerTest, StepReportsTickAllocations) {
+    starship::Game game(800, 600, 3);
+    // The first tick creates the profiler's histogram buckets
+    game.step(starship::INPUT_FIRE);
+    const TickAllocations& first = game.getLastTickAllocations();
+    EXPECT_GT(first.total.allocations, 0u);
+    EXPECT_GT(first.peakLiveBytes, 0u);
+
+    std::uint64_t tagged = 0;
+    for (const auto& phase : first.phases) tagged += phase.allocations;
+    EXPECT_EQ(tagged, first.total.allocations);
+}
+
+// The regression gate: once the game has reserved its storage and warmed
+// up, a steady-state tick must not touch the heap
+TEST_F(AllocTrackerTest, SteadyStateTicksDoNotAllocate) {
+    starship::Game game(800, 600, 5);
+    game.reserve(4096, 1024, 256);
+    for (int t = 0; t < 600; ++t) {
+        game.step(t % 20 == 0 ? starship::INPUT_FIRE | starship::INPUT_LEFT : starship::INPUT_FIRE);
+    }
+
+    alloc::Trap trap;
+    for (int t = 0; t < 600; ++t) {
+        game.step(t % 20 == 0 ? starship::INPUT_FIRE | starship::INPUT_RIGHT : starship::INPUT_FIRE);
+        ASSERT_EQ(game.getLastTickAllocations().total.allocations, 0u) << "tick " << game.getTickCount();
+    }
+    EXPECT_EQ(trappedAllocations, 0u);
+    // Still a live game, with shooting and splitting going on
+    EXPECT_FALSE(game.isGameOver());
+    EXPECT_GT(game.getScore(), 0);
+}
+
+TEST_F(AllocTrackerTest, BasicGameNeverAllocates) {
+    TickAllocations start = alloc::threadCounters();
+    {
+        alloc::Trap trap;
+        starship::BasicGame<> game(11);
+        for (int t = 0; t < 3600; ++t) {
+            game.step(t % 20 == 0 ? starship::INPUT_FIRE | starship::INPUT_LEFT
+                                  : starship::INPUT_FIRE | starship::INPUT_RESTART);
+        }
+        game.reset(12);
+        game.step(starship::INPUT_FIRE);
+        EXPECT_GT(game.getTickCount(), 0u);
+    }
+    EXPECT_EQ(trappedAllocations, 0u);
+    EXPECT_EQ(alloc::since(start).total.allocations, 0u);
+}
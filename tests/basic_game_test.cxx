@@ -0,0 +1,98 @@
+// tests/basic_game_test.cxx
+#include <gtest/gtest.h>
+#include <vector>
+#include "starship/basic_game.hxx"
+#include "starship/game.hxx"
+
+using starship::BasicGame;
+using starship::DefaultGameConfig;
+
+namespace {
+
+// Kiosk-sized world: small stores and a cheaper, faster game
+struct SmallConfig : DefaultGameConfig {
+    static constexpr float WIDTH = 320.0f;
+    static constexpr float HEIGHT = 240.0f;
+    static constexpr std::size_t MAX_ASTEROIDS = 12;
+    static constexpr std::size_t MAX_PROJECTILES = 4;
+    static constexpr std::size_t MAX_POWERUPS = 2;
+    static constexpr float SHOOT_DELAY = 0.05f;
+    static constexpr std::array<int, 3> ASTEROID_POINTS = {1, 2, 3};
+};
+
+starship::InputMask inputFor(int t) {
+    starship::InputMask input = starship::INPUT_FIRE;
+    if ((t / 40) % 3 == 0) input |= starship::INPUT_LEFT;
+    if ((t / 40) % 3 == 1) input |= starship::INPUT_RIGHT;
+    return input;
+}
+
+} // namespace
+
+static_assert(BasicGame<SmallConfig>::radiusFor(starship::Asteroid::Size::MEDIUM) == 12.0f,
+              "Tables are usable in constant expressions");
+static_assert(BasicGame<SmallConfig>::pointsFor(starship::Asteroid::Size::SMALL) == 3,
+              "A config overrides only what it shadows");
+static_assert(starship::Asteroid::getPointsForSize(starship::Asteroid::Size::LARGE) == 20,
+              "Game keeps the default tables");
+
+class BasicGameTest : public ::testing::Test {};
+
+TEST_F(BasicGameTest, MatchesGameWithDefaultConfig) {
+    starship::Game game(DefaultGameConfig::WIDTH, DefaultGameConfig::HEIGHT, 77);
+    BasicGame<> basic(77);
+
+    for (int t = 0; t < 1800; ++t) {
+        starship::InputMask input = inputFor(t);
+        game.step(input);
+        basic.step(input);
+        ASSERT_EQ(basic.getScore(), game.getScore()) << "tick " << t;
+    }
+    EXPECT_GT(basic.getScore(), 0);
+    EXPECT_EQ(basic.getLevel(), game.getLevel());
+    EXPECT_EQ(basic.isGameOver(), game.isGameOver());
+    EXPECT_EQ(basic.getPlayer().getHealth(), game.getPlayer().getHealth());
+    EXPECT_EQ(basic.getPlayer().getPosition().x, game.getPlayer().getPosition().x);
+
+    // Same live asteroids, in the same order
+    std::vector<float> expected;
+    for (const auto& a : game.getAsteroids()) {
+        if (a.isActive()) expected.push_back(a.getPosition().x);
+    }
+    std::vector<float> actual;
+    const auto& asteroids = basic.getAsteroids();
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (asteroids.isActive(i)) actual.push_back(asteroids.x[i]);
+    }
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(BasicGameTest, StaysWithinCapacity) {
+    BasicGame<SmallConfig> game(5);
+    EXPECT_EQ(game.getAsteroids().size(), static_cast<std::size_t>(SmallConfig::INITIAL_ASTEROIDS));
+
+    std::size_t mostProjectiles = 0;
+    for (int t = 0; t < 3600; ++t) {
+        game.step(inputFor(t) | starship::INPUT_RESTART);
+        EXPECT_LE(game.getAsteroids().size(), SmallConfig::MAX_ASTEROIDS);
+        EXPECT_LE(game.getPowerUps().size(), SmallConfig::MAX_POWERUPS);
+        mostProjectiles = std::max(mostProjectiles, game.getProjectiles().size());
+    }
+    // The short shoot delay keeps the projectile store full
+    EXPECT_EQ(mostProjectiles, SmallConfig::MAX_PROJECTILES);
+    EXPECT_GT(game.getScore(), 0);
+}
+
+TEST_F(BasicGameTest, ResetWithSeedReplaysTheGame) {
+    BasicGame<SmallConfig> game(9);
+    for (int t = 0; t < 600; ++t) game.step(inputFor(t));
+    const int score = game.getScore();
+    const float firstX = game.getAsteroids().x[0];
+
+    game.reset(9);
+    EXPECT_EQ(game.getTickCount(), 0u);
+    EXPECT_EQ(game.getScore(), 0);
+    for (int t = 0; t < 600; ++t) game.step(inputFor(t));
+    EXPECT_EQ(game.getScore(), score);
+    EXPECT_EQ(game.getAsteroids().x[0], firstX);
+}
@@ -0,0 +1,259 @@
+// tests/entity_bvh_test.cxx
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "starship/entity_bvh.hxx"
+#include "starship/game.hxx"
+
+using starship::AsteroidColumns;
+using starship::EntityBvh;
+using starship::Vector2D;
+
+class EntityBvhTest : public ::testing::Test {
+protected:
+    AsteroidColumns store;
+    EntityBvh bvh;
+    std::mt19937 rng{99};
+
+    void scatter(std::size_t count, float side) {
+        std::uniform_real_distribution<float> coord(0.0f, side);
+        std::uniform_int_distribution<int> size(0, 2);
+        for (std::size_t i = 0; i < count; ++i) {
+            store.push(Vector2D(coord(rng), coord(rng)), Vector2D(0.0f, 0.0f),
+                       static_cast<starship::Asteroid::Size>(size(rng)), 0.0f, 0.0f, 0);
+        }
+    }
+
+    void moveAll(float dx, float dy) {
+        for (std::size_t i = 0; i < store.size(); ++i) {
+            store.x[i] += dx;
+            store.y[i] += dy;
+        }
+        bvh.invalidate();
+    }
+
+    std::vector<std::uint32_t> radius(const Vector2D& center, float range) const {
+        std::vector<std::uint32_t> found;
+        bvh.queryRadius(store, center, range, [&](std::uint32_t slot) { found.push_back(slot); });
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    std::vector<std::uint32_t> bruteRadius(const Vector2D& center, float range) const {
+        std::vector<std::uint32_t> found;
+        for (std::uint32_t i = 0; i < store.size(); ++i) {
+            float reach = range + store.radius[i];
+            if (store.isActive(i) && Vector2D::distanceSquared(center, store.position(i)) <= reach * reach) {
+                found.push_back(i);
+            }
+        }
+        return found;
+    }
+};
+
+TEST_F(EntityBvhTest, EmptyTreeFindsNothing) {
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.size(), 0u);
+    EXPECT_TRUE(radius(Vector2D(0.0f, 0.0f), 1000.0f).empty());
+    EXPECT_EQ(bvh.raycast(store, Vector2D(0.0f, 0.0f), Vector2D(1.0f, 0.0f), 1000.0f).slot, EntityBvh::NONE);
+    std::vector<EntityBvh::Neighbor> nearest;
+    bvh.nearestK(store, Vector2D(0.0f, 0.0f), 3, nearest);
+    EXPECT_TRUE(nearest.empty());
+}
+
+TEST_F(EntityBvhTest, RadiusAndBoxMatchBruteForce) {
+    scatter(2000, 2000.0f);
+    bvh.refresh(store);
+    std::uniform_real_distribution<float> coord(0.0f, 2000.0f);
+
+    for (int q = 0; q < 50; ++q) {
+        Vector2D center(coord(rng), coord(rng));
+        EXPECT_EQ(radius(center, 60.0f), bruteRadius(center, 60.0f));
+
+        Vector2D min(coord(rng), coord(rng));
+        Vector2D max(min.x + 150.0f, min.y + 80.0f);
+        std::vector<std::uint32_t> found;
+        bvh.queryBox(store, min, max, [&](std::uint32_t slot) { found.push_back(slot); });
+        std::sort(found.begin(), found.end());
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < store.size(); ++i) {
+            float dx = std::max({min.x - store.x[i], 0.0f, store.x[i] - max.x});
+            float dy = std::max({min.y - store.y[i], 0.0f, store.y[i] - max.y});
+            if (dx * dx + dy * dy <= store.radius[i] * store.radius[i]) expected.push_back(i);
+        }
+        EXPECT_EQ(found, expected);
+    }
+}
+
+TEST_F(EntityBvhTest, RaycastFindsTheFirstCircleAlongTheRay) {
+    scatter(1000, 1500.0f);
+    bvh.refresh(store);
+    std::uniform_real_distribution<float> coord(0.0f, 1500.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+    for (int q = 0; q < 100; ++q) {
+        Vector2D origin(coord(rng), coord(rng));
+        float a = angle(rng);
+        Vector2D dir(std::cos(a), std::sin(a));
+
+        // Brute force: march the closed-form ray/circle test over everyone
+        float best = 400.0f;
+        std::uint32_t expected = EntityBvh::NONE;
+        for (std::uint32_t i = 0; i < store.size(); ++i) {
+            Vector2D m = origin - store.position(i);
+            float c = m.lengthSquared() - store.radius[i] * store.radius[i];
+            float b = m.x * dir.x + m.y * dir.y;
+            float t;
+            if (c <= 0.0f) {
+                t = 0.0f;
+            } else if (b > 0.0f || b * b - c < 0.0f) {
+                continue;
+            } else {
+                t = -b - std::sqrt(b * b - c);
+            }
+            if (t < best) {
+                best = t;
+                expected = i;
+            }
+        }
+
+        EntityBvh::RayHit hit = bvh.raycast(store, origin, dir * 3.0f, 400.0f);
+        ASSERT_EQ(hit.slot, expected);
+        if (expected != EntityBvh::NONE) {
+            EXPECT_NEAR(hit.distance, best, 1e-2f);
+        }
+    }
+}
+
+TEST_F(EntityBvhTest, NearestKIsSortedAndExact) {
+    scatter(1500, 1500.0f);
+    bvh.refresh(store);
+    std::uniform_real_distribution<float> coord(0.0f, 1500.0f);
+    std::vector<EntityBvh::Neighbor> nearest;
+
+    for (int q = 0; q < 30; ++q) {
+        Vector2D point(coord(rng), coord(rng));
+        std::vector<std::pair<float, std::uint32_t>> all;
+        for (std::uint32_t i = 0; i < store.size(); ++i) {
+            all.emplace_back(Vector2D::distanceSquared(point, store.position(i)), i);
+        }
+        std::sort(all.begin(), all.end());
+
+        bvh.nearestK(store, point, 8, nearest);
+        ASSERT_EQ(nearest.size(), 8u);
+        for (std::size_t k = 0; k < nearest.size(); ++k) {
+            EXPECT_EQ(nearest[k].slot, all[k].second);
+        }
+    }
+}
+
+TEST_F(EntityBvhTest, CoherentMotionRefitsAndNewLayoutsRebuild) {
+    scatter(500, 1000.0f);
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 1u);
+
+    // Small drift keeps the tree
+    for (int t = 0; t < 10; ++t) {
+        moveAll(1.0f, -0.5f);
+        bvh.refresh(store);
+    }
+    EXPECT_EQ(bvh.getBuildCount(), 1u);
+    EXPECT_EQ(bvh.getRefitCount(), 10u);
+    EXPECT_EQ(radius(Vector2D(500.0f, 500.0f), 80.0f), bruteRadius(Vector2D(500.0f, 500.0f), 80.0f));
+
+    // Destroyed entities drop out without a rebuild
+    for (std::size_t i = 0; i < store.size(); i += 7) store.setActive(i, false);
+    store.releaseInactive();
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 1u);
+    EXPECT_EQ(radius(Vector2D(300.0f, 700.0f), 120.0f), bruteRadius(Vector2D(300.0f, 700.0f), 120.0f));
+
+    // Compaction moves entities to new slots
+    store.removeInactive();
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 2u);
+
+    // A few spawns are scanned beside the tree, many more rebuild it
+    scatter(3, 1000.0f);
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 2u);
+    EXPECT_EQ(bvh.getPendingCount(), 3u);
+    EXPECT_EQ(radius(Vector2D(500.0f, 500.0f), 200.0f), bruteRadius(Vector2D(500.0f, 500.0f), 200.0f));
+    std::vector<EntityBvh::Neighbor> nearest;
+    bvh.nearestK(store, store.position(store.size() - 1), 1, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0].slot, store.size() - 1);
+
+    scatter(100, 1000.0f);
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 3u);
+    EXPECT_EQ(bvh.getPendingCount(), 0u);
+
+    // Trimmed trailing slots stay out even once new entities reuse them
+    store.setActive(store.size() - 1, false);
+    store.releaseInactive();
+    bvh.invalidate();
+    bvh.refresh(store);
+    scatter(1, 1000.0f);
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 3u);
+    EXPECT_EQ(bvh.getPendingCount(), 1u);
+    EXPECT_EQ(radius(store.position(store.size() - 1), 1.0f), bruteRadius(store.position(store.size() - 1), 1.0f));
+
+    // Scrambling the positions makes the refit too loose to keep
+    std::uniform_real_distribution<float> coord(0.0f, 1000.0f);
+    for (std::size_t i = 0; i < store.size(); ++i) {
+        store.x[i] = coord(rng);
+        store.y[i] = coord(rng);
+    }
+    bvh.invalidate();
+    bvh.refresh(store);
+    EXPECT_EQ(bvh.getBuildCount(), 4u);
+    EXPECT_EQ(bvh.getPendingCount(), 0u);
+    EXPECT_EQ(radius(Vector2D(500.0f, 500.0f), 200.0f), bruteRadius(Vector2D(500.0f, 500.0f), 200.0f));
+}
+
+TEST_F(EntityBvhTest, GameQueriesReturnLiveHandles) {
+    starship::Game game(800, 600, 31);
+    for (int t = 0; t < 120; ++t) game.step(starship::INPUT_FIRE);
+
+    const starship::AsteroidView asteroids = game.getAsteroids();
+    const Vector2D ship = game.getPlayer().getPosition();
+
+    std::vector<starship::AsteroidHandle> found;
+    game.queryRadius(ship, 10000.0f, found);
+    EXPECT_EQ(found.size(), asteroids.liveCount());
+    for (const auto& h : found) EXPECT_TRUE(asteroids.contains(h));
+
+    game.nearestK(ship, 1, found);
+    ASSERT_EQ(found.size(), 1u);
+    float nearest = Vector2D::distanceSquared(ship, asteroids[asteroids.find(found[0])].getPosition());
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (!asteroids[i].isActive()) continue;
+        EXPECT_LE(nearest, Vector2D::distanceSquared(ship, asteroids[i].getPosition()));
+    }
+
+    // Straight at the nearest asteroid, the ray cannot miss it
+    Vector2D toward = asteroids[asteroids.find(found[0])].getPosition() - ship;
+    starship::RaycastHit<starship::AsteroidHandle> hit;
+    ASSERT_TRUE(game.raycast(ship, toward, 10000.0f, hit));
+    EXPECT_TRUE(asteroids.contains(hit.handle));
+    EXPECT_NEAR(Vector2D::distance(ship, hit.point), hit.distance, 1e-3f);
+
+    // Positions move on; the next query sees the new ones
+    game.step(starship::INPUT_NONE);
+    std::vector<starship::AsteroidHandle> box;
+    game.queryAABB(Vector2D(0.0f, 0.0f), Vector2D(800.0f, 600.0f), box);
+    EXPECT_EQ(box.size(), game.getAsteroids().liveCount());
+
+    std::vector<starship::PowerUpHandle> powerUps;
+    game.queryRadius(ship, 10000.0f, powerUps);
+    EXPECT_EQ(powerUps.size(), game.getPowerUps().liveCount());
+}
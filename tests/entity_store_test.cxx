@@ -0,0 +1,130 @@
+// tests/entity_store_test.cxx
+#include <gtest/gtest.h>
+#include <vector>
+#include "starship/entity_view.hxx"
+#include "starship/game.hxx"
+
+using starship::AsteroidColumns;
+using starship::AsteroidHandle;
+using starship::AsteroidView;
+using starship::Vector2D;
+
+class EntityStoreTest : public ::testing::Test {
+protected:
+    AsteroidColumns store;
+
+    AsteroidHandle push(float x) {
+        std::uint32_t id = store.push(Vector2D(x, 0.0f), Vector2D(0.0f, 0.0f),
+                                      starship::Asteroid::Size::SMALL, 0.0f, 0.0f, 0);
+        return AsteroidHandle{id, store.handles.generationOf(id)};
+    }
+
+    AsteroidView view() const { return AsteroidView(&store); }
+};
+
+TEST_F(EntityStoreTest, FewHolesAreLeftInPlace) {
+    for (int i = 0; i < 8; ++i) push(static_cast<float>(i));
+    AsteroidHandle survivor = view()[5].getHandle();
+
+    store.setActive(2, false);
+    store.releaseInactive();
+
+    // One interior hole is under the threshold: nothing moves
+    EXPECT_EQ(store.size(), 8u);
+    EXPECT_EQ(store.liveCount(), 7u);
+    EXPECT_EQ(store.holeCount(), 1u);
+    EXPECT_EQ(view().find(survivor), 5u);
+    EXPECT_TRUE(view()[2].getHandle().isNull());
+
+    // Holes at the end are trimmed straight away
+    store.setActive(7, false);
+    store.releaseInactive();
+    EXPECT_EQ(store.size(), 7u);
+    EXPECT_EQ(store.holeCount(), 1u);
+}
+
+TEST_F(EntityStoreTest, HandlesSurviveCompaction) {
+    std::vector<AsteroidHandle> handles;
+    for (int i = 0; i < 8; ++i) handles.push_back(push(static_cast<float>(i)));
+
+    for (std::size_t i = 0; i < 4; ++i) store.setActive(i, false);
+    store.releaseInactive();
+
+    // Half the slots were holes, so the store compacted in spawn order
+    ASSERT_EQ(store.size(), 4u);
+    EXPECT_EQ(store.holeCount(), 0u);
+    for (std::size_t i = 4; i < 8; ++i) {
+        std::size_t index = view().find(handles[i]);
+        ASSERT_EQ(index, i - 4);
+        EXPECT_EQ(view()[index].getPosition().x, static_cast<float>(i));
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_FALSE(view().contains(handles[i]));
+    }
+}
+
+TEST_F(EntityStoreTest, ReusedIdsDoNotReviveOldHandles) {
+    AsteroidHandle first = push(1.0f);
+    push(2.0f);
+    store.setActive(0, false);
+    store.releaseInactive();
+    EXPECT_FALSE(view().contains(first));
+
+    // The freed id comes back with a new generation
+    AsteroidHandle second = push(3.0f);
+    EXPECT_EQ(second.id, first.id);
+    EXPECT_NE(second.generation, first.generation);
+    EXPECT_FALSE(view().contains(first));
+    ASSERT_TRUE(view().contains(second));
+    EXPECT_EQ(view()[view().find(second)].getPosition().x, 3.0f);
+}
+
+TEST_F(EntityStoreTest, DestroyedEntityIsGoneBeforeRelease) {
+    AsteroidHandle handle = push(1.0f);
+    store.setActive(0, false);
+    EXPECT_FALSE(view().contains(handle));
+    EXPECT_FALSE(view().contains(AsteroidHandle{}));
+}
+
+TEST_F(EntityStoreTest, SteadyChurnNeverReallocates) {
+    store.reserve(64);
+    for (int i = 0; i < 16; ++i) push(0.0f);
+    const float* x = store.x.data();
+    const std::uint32_t* ids = store.ids.data();
+
+    // Four spawns and four deaths of the oldest per round
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 4; ++i) push(static_cast<float>(round));
+        int killed = 0;
+        for (std::size_t i = 0; i < store.size() && killed < 4; ++i) {
+            if (store.isActive(i)) {
+                store.setActive(i, false);
+                ++killed;
+            }
+        }
+        store.releaseInactive();
+        ASSERT_EQ(store.liveCount(), 16u);
+    }
+    EXPECT_EQ(store.x.data(), x);
+    EXPECT_EQ(store.ids.data(), ids);
+    EXPECT_LE(store.size(), 32u);
+}
+
+TEST_F(EntityStoreTest, GameHandlesTrackEntitiesAcrossTicks) {
+    starship::Game game(800, 600, 21);
+    game.applyPowerUp(starship::PowerUp::Type::SHIELD);
+
+    AsteroidHandle drifting = game.spawnAsteroid(Vector2D(600.0f, 100.0f), Vector2D(0.0f, 60.0f),
+                                                 starship::Asteroid::Size::LARGE);
+    AsteroidHandle target = game.spawnAsteroid(Vector2D(100.0f, 300.0f), Vector2D(0.0f, 0.0f),
+                                               starship::Asteroid::Size::SMALL);
+    starship::ProjectileHandle shot = game.spawnProjectile(Vector2D(100.0f, 320.0f), Vector2D(0.0f, -300.0f));
+
+    for (int i = 0; i < 60; ++i) game.step(starship::INPUT_NONE);
+
+    auto asteroids = game.getAsteroids();
+    ASSERT_TRUE(asteroids.contains(drifting));
+    EXPECT_NEAR(asteroids[asteroids.find(drifting)].getPosition().y, 160.0f, 0.5f);
+    EXPECT_FALSE(asteroids.contains(target));
+    EXPECT_FALSE(game.getProjectiles().contains(shot));
+}
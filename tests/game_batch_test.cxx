@@ -0,0 +1,64 @@
+// tests/game_batch_test.cxx
+#include <gtest/gtest.h>
+#include <vector>
+#include "starship/game.hxx"
+#include "starship/game_batch.hxx"
+
+class GameBatchTest : public ::testing::Test {};
+
+TEST_F(GameBatchTest, GamesMatchStandaloneGames) {
+    starship::GameBatch batch(8, 800, 600, 42);
+    std::vector<starship::InputMask> inputs(batch.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = starship::INPUT_FIRE | (i % 2 ? starship::INPUT_LEFT : starship::INPUT_RIGHT);
+    }
+
+    starship::Game solo(800, 600, starship::GameBatch::seedFor(42, 3, 0));
+    for (int t = 0; t < 300; ++t) {
+        batch.step(inputs.data());
+        solo.step(inputs[3]);
+    }
+    EXPECT_EQ(batch.getGame(3).checksum(), solo.checksum());
+    EXPECT_EQ(batch.getScores()[3], solo.getScore());
+    EXPECT_EQ(batch.getLevels()[3], solo.getLevel());
+    EXPECT_EQ(batch.getTotalTicks(), 8u * 300u);
+    EXPECT_NE(batch.getGame(0).getSeed(), batch.getGame(1).getSeed());
+}
+
+TEST_F(GameBatchTest, ThreadCountDoesNotChangeResults) {
+    starship::GameBatch serial(100, 800, 600, 9);
+    starship::GameBatch threaded(100, 800, 600, 9);
+    threaded.setThreadCount(4);
+    std::vector<starship::InputMask> inputs(100, starship::INPUT_FIRE | starship::INPUT_LEFT);
+    serial.run(inputs.data(), 200);
+    threaded.run(inputs.data(), 200);
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        ASSERT_EQ(serial.getGame(i).checksum(), threaded.getGame(i).checksum());
+    }
+}
+
+TEST_F(GameBatchTest, ResetRestoresFreshGames) {
+    starship::GameBatch batch(4, 800, 600, 5);
+    std::uint64_t fresh = batch.getGame(2).checksum();
+    batch.run(nullptr, 100);
+    EXPECT_NE(batch.getGame(2).checksum(), fresh);
+
+    batch.reset();
+    EXPECT_EQ(batch.getGame(2).checksum(), fresh);
+    EXPECT_EQ(batch.getScores()[2], 0);
+    EXPECT_EQ(batch.getEpisodes()[2], 0u);
+}
+
+TEST_F(GameBatchTest, AutoResetStartsNextEpisode) {
+    // Idle players are eventually hit and lose all their lives
+    starship::GameBatch batch(2, 200, 200, 1);
+    batch.setAutoReset(true);
+    bool sawGameOver = false;
+    for (int t = 0; t < 60 * 600 && batch.getEpisodes()[0] == 0; ++t) {
+        batch.step(nullptr);
+        sawGameOver = sawGameOver || batch.getGameOver()[0];
+    }
+    EXPECT_TRUE(sawGameOver);
+    EXPECT_EQ(batch.getEpisodes()[0], 1u);
+    EXPECT_EQ(batch.getGame(0).getSeed(), starship::GameBatch::seedFor(1, 0, 1));
+}
@@ -1,6 +1,8 @@
 // tests/game_test.cxx
 #include <gtest/gtest.h>
+#include <cmath>
 #include <random>
+#include <type_traits>
 #include "starship/game.hxx"
 #include "starship/asteroid.hxx"
 #include "starship/powerup.hxx"
@@ -299,4 +301,271 @@ TEST_F(GameTest, AsteroidRotationAdvancesOnUpdate) {
     float initialRotation = asteroid.getRotation();
     asteroid.update(0.5f);
     EXPECT_NE(asteroid.getRotation(), initialRotation);
-}
\ No newline at end of file
+}
+
+TEST_F(GameTest, ProjectileDestroysAsteroid) {
+    starship::Game game(800, 600);
+    size_t before = game.getAsteroids().size();
+
+    starship::Vector2D target(100.0f, 300.0f);
+    game.spawnAsteroid(target, starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(target, starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions();
+
+    EXPECT_EQ(game.getScore(), 100);
+    EXPECT_FALSE(game.getAsteroids()[before].isActive());
+    EXPECT_FALSE(game.getProjectiles()[0].isActive());
+}
+
+TEST_F(GameTest, ProjectileMissesDistantAsteroid) {
+    starship::Game game(800, 600);
+    size_t before = game.getAsteroids().size();
+
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(starship::Vector2D(100.0f, 310.0f), starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions();
+
+    EXPECT_EQ(game.getScore(), 0);
+    EXPECT_TRUE(game.getAsteroids()[before].isActive());
+    EXPECT_TRUE(game.getProjectiles()[0].isActive());
+}
+
+TEST_F(GameTest, SweptProjectileCannotTunnel) {
+    // At a half-second step the shot jumps 150 px, far past a small asteroid
+    starship::Game game(800, 600, 11);
+    game.applyPowerUp(starship::PowerUp::Type::SHIELD);
+    size_t before = game.getAsteroids().size();
+
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(starship::Vector2D(100.0f, 250.0f), starship::Vector2D(0.0f, -300.0f));
+
+    // End positions alone do not touch
+    game.checkCollisions();
+    EXPECT_EQ(game.getScore(), 0);
+
+    game.checkCollisions(0.5f);
+    EXPECT_EQ(game.getScore(), 100);
+    EXPECT_FALSE(game.getAsteroids()[before].isActive());
+    EXPECT_FALSE(game.getProjectiles()[0].isActive());
+}
+
+TEST_F(GameTest, CoarseUpdateStillHits) {
+    starship::Game game(800, 600, 12);
+    game.applyPowerUp(starship::PowerUp::Type::SHIELD);
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(starship::Vector2D(100.0f, 400.0f), starship::Vector2D(0.0f, -300.0f));
+
+    game.update(0.5f);
+    EXPECT_EQ(game.getScore(), 100);
+}
+
+TEST_F(GameTest, SweptHitTakesEarliestAsteroid) {
+    starship::Game game(800, 600, 13);
+    size_t before = game.getAsteroids().size();
+
+    // The far asteroid has the lower index, but the shot reaches the near one first
+    game.spawnAsteroid(starship::Vector2D(100.0f, 150.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::LARGE);
+    game.spawnAsteroid(starship::Vector2D(100.0f, 250.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(starship::Vector2D(100.0f, 100.0f), starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions(1.0f);
+
+    EXPECT_EQ(game.getScore(), 100);
+    EXPECT_TRUE(game.getAsteroids()[before].isActive());
+    EXPECT_FALSE(game.getAsteroids()[before + 1].isActive());
+}
+
+TEST_F(GameTest, PolygonNarrowPhaseFollowsOutline) {
+    // Fire straight up through a large asteroid at a range of offsets,
+    // with the circle and the outline narrow phase
+    auto hits = [](float offset, bool polygons) {
+        starship::Game game(800, 600, 14);
+        game.setPolygonCollisions(polygons);
+        game.spawnAsteroid(starship::Vector2D(200.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::LARGE);
+        game.spawnProjectile(starship::Vector2D(200.0f + offset, 200.0f), starship::Vector2D(0.0f, -300.0f));
+        game.checkCollisions(1.0f);
+        return game.getScore() > 0;
+    };
+
+    EXPECT_TRUE(hits(0.0f, true));
+    EXPECT_FALSE(hits(24.0f, true));
+    EXPECT_FALSE(hits(-24.0f, true));
+
+    int differences = 0;
+    for (float offset = -23.0f; offset <= 23.0f; offset += 0.5f) {
+        if (hits(offset, true) != hits(offset, false)) differences++;
+    }
+    EXPECT_GT(differences, 0);
+}
+
+TEST_F(GameTest, CollisionPassRecordsCommands) {
+    starship::Game game(800, 600, 15);
+    size_t before = game.getAsteroids().size();
+
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 10.0f), starship::Asteroid::Size::LARGE);
+    game.spawnAsteroid(starship::Vector2D(200.0f, 300.0f), starship::Vector2D(0.0f, 10.0f), starship::Asteroid::Size::MEDIUM);
+    game.spawnProjectile(starship::Vector2D(200.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+    game.spawnProjectile(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions();
+
+    const starship::CommandBuffer& commands = game.getLastCommands();
+    ASSERT_EQ(commands.hits.size(), 2u);
+    EXPECT_EQ(commands.hits[0].projectile, 0u);
+    EXPECT_EQ(commands.hits[0].asteroid, before + 1);
+    EXPECT_EQ(commands.hits[1].projectile, 1u);
+    EXPECT_EQ(commands.hits[1].asteroid, before);
+    EXPECT_EQ(game.getScore(), 70);
+
+    // Both splits were appended together, in hit order
+    ASSERT_EQ(commands.asteroidSpawns.size(), 4u);
+    ASSERT_EQ(game.getAsteroids().size(), before + 6);
+    EXPECT_EQ(game.getAsteroids()[before + 2].getSize(), starship::Asteroid::Size::SMALL);
+    EXPECT_EQ(game.getAsteroids()[before + 4].getSize(), starship::Asteroid::Size::MEDIUM);
+}
+
+TEST_F(GameTest, ContestedAsteroidGoesToFirstProjectile) {
+    starship::Game game(800, 600, 16);
+    size_t before = game.getAsteroids().size();
+
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnProjectile(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+    game.spawnProjectile(starship::Vector2D(101.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions();
+
+    ASSERT_EQ(game.getLastCommands().hits.size(), 1u);
+    EXPECT_EQ(game.getLastCommands().hits[0].projectile, 0u);
+    EXPECT_FALSE(game.getAsteroids()[before].isActive());
+    EXPECT_FALSE(game.getProjectiles()[0].isActive());
+    EXPECT_TRUE(game.getProjectiles()[1].isActive());
+    EXPECT_EQ(game.getScore(), 100);
+}
+
+TEST_F(GameTest, EntityViewsExposeColumnData) {
+    starship::Game game(800, 600);
+    size_t before = game.getAsteroids().size();
+
+    game.spawnAsteroid(starship::Vector2D(50.0f, 60.0f), starship::Vector2D(1.0f, 2.0f), starship::Asteroid::Size::MEDIUM);
+    auto asteroid = game.getAsteroids()[before];
+    EXPECT_EQ(asteroid.getPosition().x, 50.0f);
+    EXPECT_EQ(asteroid.getPosition().y, 60.0f);
+    EXPECT_EQ(asteroid.getVelocity().y, 2.0f);
+    EXPECT_EQ(asteroid.getRadius(), 12.0f);
+    EXPECT_EQ(asteroid.getSize(), starship::Asteroid::Size::MEDIUM);
+    EXPECT_EQ(asteroid.getShape().size(), 8u);
+    EXPECT_EQ(asteroid.getPoints(), 50);
+    EXPECT_TRUE(asteroid.canSplit());
+
+    size_t visited = 0;
+    for (const auto& a : game.getAsteroids()) {
+        EXPECT_TRUE(a.isActive());
+        visited++;
+    }
+    EXPECT_EQ(visited, before + 1);
+}
+
+TEST_F(GameTest, RemoveInactiveKeepsColumnsAligned) {
+    starship::Game game(800, 600);
+    size_t before = game.getAsteroids().size();
+
+    // Small asteroid first so it is hit; the large one behind it survives
+    game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    game.spawnAsteroid(starship::Vector2D(300.0f, 300.0f), starship::Vector2D(0.0f, 5.0f), starship::Asteroid::Size::LARGE);
+    game.spawnProjectile(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+    game.checkCollisions();
+    game.removeInactiveEntities();
+
+    ASSERT_EQ(game.getAsteroids().size(), before + 1);
+    auto survivor = game.getAsteroids()[before];
+    EXPECT_EQ(survivor.getPosition().x, 300.0f);
+    EXPECT_EQ(survivor.getVelocity().y, 5.0f);
+    EXPECT_EQ(survivor.getSize(), starship::Asteroid::Size::LARGE);
+    EXPECT_EQ(survivor.getShape().size(), 10u);
+    EXPECT_EQ(game.getProjectiles().size(), 0u);
+}
+
+TEST_F(GameTest, ShapeLibraryIsLazyAndSeeded) {
+    starship::AsteroidShapeLibrary a(42);
+    starship::AsteroidShapeLibrary b(42);
+    starship::AsteroidShapeLibrary c(43);
+    EXPECT_FALSE(a.isBuilt());
+
+    auto shapeA = a.getShape(0, 3);
+    EXPECT_TRUE(a.isBuilt());
+    auto shapeB = b.getShape(0, 3);
+    auto shapeC = c.getShape(0, 3);
+
+    ASSERT_EQ(shapeA.size(), 10u);
+    bool differs = false;
+    for (size_t i = 0; i < shapeA.size(); ++i) {
+        EXPECT_EQ(shapeA[i].x, shapeB[i].x);
+        EXPECT_EQ(shapeA[i].y, shapeB[i].y);
+        differs = differs || shapeA[i].x != shapeC[i].x;
+    }
+    EXPECT_TRUE(differs);
+}
+
+TEST_F(GameTest, HeadlessTicksNeverGenerateShapes) {
+    starship::Game game(800, 600);
+    for (int i = 0; i < 120; ++i) {
+        game.update(1.0f / 60.0f);
+    }
+    EXPECT_FALSE(game.getAsteroids().data().shapeLibrary.isBuilt());
+
+    // First look from a renderer builds the pool
+    ASSERT_FALSE(game.getAsteroids().empty());
+    EXPECT_GT(game.getAsteroids()[0].getShape().size(), 0u);
+    EXPECT_TRUE(game.getAsteroids().data().shapeLibrary.isBuilt());
+}
+
+TEST_F(GameTest, AsteroidOutlinesAreWorldSpace) {
+    starship::Game game(800, 600, 31);
+    for (int i = 0; i < 30; ++i) {
+        game.step(starship::INPUT_NONE);
+    }
+
+    const starship::AsteroidOutlines& outlines = game.getAsteroidOutlines();
+    auto asteroids = game.getAsteroids();
+    ASSERT_EQ(outlines.size(), asteroids.size());
+    ASSERT_EQ(outlines.getOffsets().back(), outlines.pointCount());
+
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        auto shape = asteroids[i].getShape();
+        auto outline = outlines[i];
+        ASSERT_EQ(outline.size(), shape.size());
+        float radians = asteroids[i].getRotation() * 3.14159265f / 180.0f;
+        float c = std::cos(radians);
+        float s = std::sin(radians);
+        for (std::size_t k = 0; k < shape.size(); ++k) {
+            EXPECT_NEAR(outline[k].x, asteroids[i].getPosition().x + shape[k].x * c - shape[k].y * s, 1e-3f);
+            EXPECT_NEAR(outline[k].y, asteroids[i].getPosition().y + shape[k].x * s + shape[k].y * c, 1e-3f);
+        }
+    }
+}
+
+TEST_F(GameTest, AsteroidOutlinesRebuildOnlyAfterChange) {
+    starship::Game game(800, 600, 32);
+    for (int i = 0; i < 200; ++i) {
+        game.update(1.0f / 60.0f);
+    }
+    EXPECT_FALSE(game.getAsteroids().data().shapeLibrary.isBuilt());
+
+    ASSERT_FALSE(game.getAsteroidOutlines().empty());
+    float before = game.getAsteroidOutlines()[0][0].y;
+
+    // Same tick: no rebuild, the buffer still matches the old positions
+    EXPECT_EQ(game.getAsteroidOutlines()[0][0].y, before);
+
+    game.update(1.0f / 60.0f);
+    EXPECT_NE(game.getAsteroidOutlines()[0][0].y, before);
+    EXPECT_EQ(game.getAsteroidOutlines().size(), game.getAsteroids().size());
+}
+
+TEST_F(GameTest, AsteroidIsTriviallyCopyable) {
+    EXPECT_TRUE(std::is_trivially_copyable<starship::Asteroid>::value);
+
+    std::mt19937 rng(2024);
+    starship::Asteroid asteroid(starship::Vector2D(1.0f, 2.0f), starship::Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL, rng);
+    starship::Asteroid copy = asteroid;
+    EXPECT_EQ(copy.getShapeVariant(), asteroid.getShapeVariant());
+    EXPECT_EQ(copy.getShape().begin(), asteroid.getShape().begin());
+    EXPECT_LT(asteroid.getShapeVariant(), starship::AsteroidShapeLibrary::VARIANTS_PER_SIZE);
+}
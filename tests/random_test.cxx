@@ -0,0 +1,84 @@
+// tests/random_test.cxx
+#include <gtest/gtest.h>
+#include <vector>
+#include "starship/game.hxx"
+#include "starship/random.hxx"
+
+using starship::RandomPurpose;
+using starship::RandomStream;
+
+TEST(RandomTest, PhiloxMatchesReferenceVectors) {
+    // Known-answer vectors published with Random123
+    using starship::philox::Block;
+    EXPECT_EQ(starship::philox::philox4x32({0, 0, 0, 0}, 0, 0),
+              (Block{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    EXPECT_EQ(starship::philox::philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                                           0xffffffffu, 0xffffffffu),
+              (Block{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+    EXPECT_EQ(starship::philox::philox4x32({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                                           0xa4093822u, 0x299f31d0u),
+              (Block{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
+
+TEST(RandomTest, DrawsDependOnlyOnTheKey) {
+    RandomStream a(7, 100, 3, RandomPurpose::SPLIT);
+    std::vector<std::uint32_t> first;
+    for (int i = 0; i < 10; ++i) first.push_back(a.nextU32());
+
+    // Other streams in between change nothing
+    RandomStream other(7, 100, 4, RandomPurpose::SPLIT);
+    other.nextU32();
+    RandomStream b(7, 100, 3, RandomPurpose::SPLIT);
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(b.nextU32(), first[i]) << "draw " << i;
+
+    // Any part of the key gives different numbers
+    EXPECT_NE(RandomStream(8, 100, 3, RandomPurpose::SPLIT).nextU32(), first[0]);
+    EXPECT_NE(RandomStream(7, 101, 3, RandomPurpose::SPLIT).nextU32(), first[0]);
+    EXPECT_NE(RandomStream(7, 100, 4, RandomPurpose::SPLIT).nextU32(), first[0]);
+    EXPECT_NE(RandomStream(7, 100, 3, RandomPurpose::DROP).nextU32(), first[0]);
+    EXPECT_NE(RandomStream(7, std::uint64_t(100) << 32, 3, RandomPurpose::SPLIT).nextU32(), first[0]);
+}
+
+TEST(RandomTest, HelpersStayInRange) {
+    RandomStream random(1, 2, 3, RandomPurpose::WAVE);
+    std::vector<int> counts(5, 0);
+    double sum = 0.0;
+    const int draws = 50000;
+    for (int i = 0; i < draws; ++i) {
+        float f = random.uniform(-0.5f, 0.5f);
+        ASSERT_GE(f, -0.5f);
+        ASSERT_LT(f, 0.5f);
+        sum += f;
+        int k = random.uniformInt(0, 4);
+        ASSERT_GE(k, 0);
+        ASSERT_LE(k, 4);
+        ++counts[k];
+    }
+    EXPECT_NEAR(sum / draws, 0.0, 0.01);
+    for (int c : counts) EXPECT_NEAR(c, draws / 5, draws / 50);
+    EXPECT_EQ(RandomStream(1, 2, 3, RandomPurpose::WAVE).uniformInt(-3, -3), -3);
+}
+
+TEST(RandomTest, SimultaneousHitsDoNotDependOnEachOther) {
+    // A hit's fragments come out the same whether or not a later hit in
+    // the same pass also splits and drops
+    auto splitOf = [](bool withLaterHit) {
+        starship::Game game(800, 600, 31);
+        game.spawnAsteroid(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, 10.0f),
+                           starship::Asteroid::Size::LARGE);
+        game.spawnAsteroid(starship::Vector2D(400.0f, 300.0f), starship::Vector2D(0.0f, 10.0f),
+                           starship::Asteroid::Size::LARGE);
+        game.spawnProjectile(starship::Vector2D(400.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+        if (withLaterHit) {
+            game.spawnProjectile(starship::Vector2D(100.0f, 300.0f), starship::Vector2D(0.0f, -300.0f));
+        }
+        game.checkCollisions();
+        const starship::CommandBuffer& commands = game.getLastCommands();
+        EXPECT_EQ(commands.hits.size(), withLaterHit ? 2u : 1u);
+        return commands.asteroidSpawns[0].velocity;
+    };
+    starship::Vector2D alone = splitOf(false);
+    starship::Vector2D paired = splitOf(true);
+    EXPECT_EQ(alone.x, paired.x);
+    EXPECT_EQ(alone.y, paired.y);
+}
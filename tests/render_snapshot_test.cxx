@@ -0,0 +1,158 @@
+// tests/render_snapshot_test.cxx
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include "starship/asteroid_outlines.hxx"
+#include "starship/game.hxx"
+#include "starship/render_snapshot.hxx"
+#include "starship/spsc_queue.hxx"
+#include "starship/triple_buffer.hxx"
+
+using starship::RenderSnapshot;
+
+class RenderSnapshotTest : public ::testing::Test {};
+
+TEST_F(RenderSnapshotTest, TripleBufferHandsOverTheLatestValue) {
+    starship::TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+}
+
+TEST_F(RenderSnapshotTest, TripleBufferNeverTearsAcrossThreads) {
+    struct Frame {
+        std::uint64_t a = 0;
+        std::uint64_t b = 0;
+    };
+    starship::TripleBuffer<Frame> buffer;
+    constexpr std::uint64_t FRAMES = 200000;
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 1; i <= FRAMES; ++i) {
+            Frame& f = buffer.writeBuffer();
+            f.a = i;
+            f.b = i * 3;
+            buffer.publish();
+        }
+    });
+
+    std::uint64_t last = 0;
+    while (last < FRAMES) {
+        if (!buffer.update()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const Frame& f = buffer.readBuffer();
+        ASSERT_EQ(f.b, f.a * 3);
+        ASSERT_GT(f.a, last);
+        last = f.a;
+    }
+    producer.join();
+}
+
+TEST_F(RenderSnapshotTest, SpscQueueKeepsOrderAcrossThreads) {
+    starship::SpscQueue<std::uint32_t, 64> queue;
+    EXPECT_TRUE(queue.empty());
+    for (std::uint32_t i = 0; i < 64; ++i) EXPECT_TRUE(queue.tryPush(i));
+    EXPECT_FALSE(queue.tryPush(64));
+    std::uint32_t v = 0;
+    for (std::uint32_t i = 0; i < 64; ++i) {
+        ASSERT_TRUE(queue.tryPop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(queue.tryPop(v));
+
+    constexpr std::uint32_t COUNT = 20000;
+    std::thread producer([&] {
+        for (std::uint32_t i = 0; i < COUNT; ++i) {
+            while (!queue.tryPush(i)) std::this_thread::yield();
+        }
+    });
+    for (std::uint32_t expected = 0; expected < COUNT;) {
+        if (!queue.tryPop(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(v, expected);
+        ++expected;
+    }
+    producer.join();
+}
+
+TEST_F(RenderSnapshotTest, CaptureCopiesLiveEntities) {
+    starship::Game game(800, 600, 21);
+    for (int t = 0; t < 240; ++t) game.step(starship::INPUT_FIRE);
+
+    RenderSnapshot snapshot;
+    snapshot.capture(game);
+    EXPECT_EQ(snapshot.tick, game.getTickCount());
+    EXPECT_EQ(snapshot.score, game.getScore());
+    EXPECT_EQ(snapshot.lives, game.getPlayer().getHealth());
+    EXPECT_EQ(snapshot.asteroids.size(), game.getAsteroids().liveCount());
+    EXPECT_FALSE(snapshot.projectiles.empty());
+
+    // Outlines rebuilt from the snapshot match the game's own
+    starship::AsteroidShapeLibrary shapes(snapshot.shapeSeed);
+    starship::AsteroidOutlines fromSnapshot;
+    fromSnapshot.build(snapshot, shapes);
+    const starship::AsteroidOutlines& fromGame = game.getAsteroidOutlines();
+    const starship::AsteroidView asteroids = game.getAsteroids();
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < asteroids.size(); ++i) {
+        if (!asteroids[i].isActive()) continue;
+        ASSERT_EQ(fromSnapshot[k].size(), fromGame[i].size());
+        for (std::size_t p = 0; p < fromGame[i].size(); ++p) {
+            EXPECT_FLOAT_EQ(fromSnapshot[k][p].x, fromGame[i][p].x);
+            EXPECT_FLOAT_EQ(fromSnapshot[k][p].y, fromGame[i][p].y);
+        }
+        ++k;
+    }
+}
+
+TEST_F(RenderSnapshotTest, BlendInterpolatesMatchingEntities) {
+    starship::Game game(800, 600, 4);
+    for (int t = 0; t < 100; ++t) game.step(starship::INPUT_FIRE);
+    RenderSnapshot from, to, out;
+    from.capture(game);
+    game.step(starship::INPUT_FIRE);
+    game.step(starship::INPUT_FIRE);
+    to.capture(game);
+
+    blendSnapshots(from, to, 0.0f, out);
+    EXPECT_EQ(out.tick, to.tick);
+    ASSERT_EQ(out.asteroids.size(), to.asteroids.size());
+    // Survivors sit at their `from` position, anything new at its `to` one
+    std::size_t matched = 0;
+    for (std::size_t i = 0; i < out.asteroids.size(); ++i) {
+        bool found = false;
+        for (const auto& a : from.asteroids) {
+            if (a.handle != out.asteroids[i].handle) continue;
+            EXPECT_EQ(out.asteroids[i].position.x, a.position.x);
+            EXPECT_EQ(out.asteroids[i].position.y, a.position.y);
+            found = true;
+        }
+        if (found) {
+            ++matched;
+        } else {
+            EXPECT_EQ(out.asteroids[i].position.y, to.asteroids[i].position.y);
+        }
+    }
+    EXPECT_GT(matched, 0u);
+
+    blendSnapshots(from, to, 0.5f, out);
+    const auto& a = from.asteroids[0];
+    ASSERT_EQ(to.asteroids[0].handle, a.handle);
+    EXPECT_FLOAT_EQ(out.asteroids[0].position.y, 0.5f * (a.position.y + to.asteroids[0].position.y));
+
+    blendSnapshots(from, to, 1.0f, out);
+    for (std::size_t i = 0; i < out.projectiles.size(); ++i) {
+        EXPECT_FLOAT_EQ(out.projectiles[i].position.y, to.projectiles[i].position.y);
+    }
+}
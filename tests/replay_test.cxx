@@ -0,0 +1,150 @@
+// tests/replay_test.cxx
+#include <gtest/gtest.h>
+#include <sstream>
+#include "starship/game.hxx"
+#include "starship/replay.hxx"
+
+namespace {
+
+// Scripted input that moves, shoots and thrusts over a few seconds
+starship::InputMask scriptedInput(std::size_t tick) {
+    starship::InputMask input = starship::INPUT_FIRE;
+    if ((tick / 90) % 2 == 0) {
+        input |= starship::INPUT_LEFT;
+    } else {
+        input |= starship::INPUT_RIGHT;
+    }
+    if (tick % 200 < 20) input |= starship::INPUT_THRUST;
+    return input;
+}
+
+starship::Recording recordSession(std::uint32_t seed, std::size_t ticks) {
+    starship::Game game(800, 600, seed);
+    starship::InputRecorder recorder(game);
+    for (std::size_t t = 0; t < ticks; ++t) {
+        starship::InputMask input = scriptedInput(t);
+        game.step(input);
+        recorder.record(input);
+    }
+    recorder.finish(game);
+    return recorder.getRecording();
+}
+
+} // namespace
+
+class ReplayTest : public ::testing::Test {};
+
+TEST_F(ReplayTest, SameSeedSameWorld) {
+    starship::Game a(800, 600, 1234);
+    starship::Game b(800, 600, 1234);
+    starship::Game c(800, 600, 4321);
+    EXPECT_EQ(a.getSeed(), 1234u);
+    EXPECT_EQ(a.checksum(), b.checksum());
+    EXPECT_NE(a.checksum(), c.checksum());
+
+    for (std::size_t t = 0; t < 300; ++t) {
+        a.step(scriptedInput(t));
+        b.step(scriptedInput(t));
+    }
+    EXPECT_EQ(a.getTickCount(), 300u);
+    EXPECT_EQ(a.checksum(), b.checksum());
+    EXPECT_EQ(a.getScore(), b.getScore());
+}
+
+TEST_F(ReplayTest, AdvanceRunsWholeTicksAndBoundsSubsteps) {
+    starship::Game game(800, 600, 1);
+    game.setFixedTimestep(0.01f, 3);
+
+    // Half a tick runs nothing and carries over
+    EXPECT_EQ(game.advance(0.005f, starship::INPUT_NONE), 0);
+    EXPECT_NEAR(game.getInterpolationAlpha(), 0.5f, 1e-4f);
+    EXPECT_EQ(game.advance(0.006f, starship::INPUT_NONE), 1);
+
+    // A long stall is capped and the backlog dropped
+    EXPECT_EQ(game.advance(1.0f, starship::INPUT_NONE), 3);
+    EXPECT_FLOAT_EQ(game.getInterpolationAlpha(), 0.0f);
+    EXPECT_EQ(game.getTickCount(), 4u);
+}
+
+TEST_F(ReplayTest, ApplyInputStopsPlayerWithoutDirection) {
+    starship::Game game(800, 600, 1);
+    game.applyInput(starship::INPUT_LEFT, game.getFixedTimestep());
+    EXPECT_LT(game.getPlayer().getVelocity().x, 0.0f);
+    game.applyInput(starship::INPUT_NONE, game.getFixedTimestep());
+    EXPECT_FLOAT_EQ(game.getPlayer().getVelocity().x, 0.0f);
+}
+
+TEST_F(ReplayTest, RecordingReplaysBitIdentically) {
+    starship::Recording recording = recordSession(99, 1200);
+    ASSERT_EQ(recording.getTickCount(), 1200u);
+    ASSERT_NE(recording.finalChecksum, 0u);
+
+    starship::Game game = recording.createGame();
+    EXPECT_TRUE(starship::replay(recording, game));
+    EXPECT_EQ(game.checksum(), recording.finalChecksum);
+
+    // Changing one tick of input changes the outcome
+    starship::Recording altered = recording;
+    altered.inputs[10] = starship::INPUT_NONE;
+    starship::Game other = altered.createGame();
+    EXPECT_FALSE(starship::replay(altered, other));
+}
+
+TEST_F(ReplayTest, SaveLoadRoundTripIsCompact) {
+    starship::Recording recording = recordSession(7, 1200);
+
+    std::stringstream buffer;
+    ASSERT_TRUE(recording.save(buffer));
+    // Inputs change a few dozen times, so runs keep the file tiny
+    EXPECT_LT(buffer.str().size(), 256u);
+
+    starship::Recording loaded;
+    ASSERT_TRUE(loaded.load(buffer));
+    EXPECT_EQ(loaded.seed, recording.seed);
+    EXPECT_EQ(loaded.timestep, recording.timestep);
+    EXPECT_EQ(loaded.inputs, recording.inputs);
+    EXPECT_EQ(loaded.finalChecksum, recording.finalChecksum);
+
+    starship::Game game = loaded.createGame();
+    EXPECT_TRUE(starship::replay(loaded, game));
+}
+
+TEST_F(ReplayTest, RecordingKeepsSimulationSettings) {
+    starship::Game game(20000, 2000, 13);
+    game.setPolygonCollisions(true);
+    game.setSectors(1000.0f, 2);
+    starship::InputRecorder recorder(game);
+    for (std::size_t t = 0; t < 900; ++t) {
+        game.step(scriptedInput(t));
+        recorder.record(scriptedInput(t));
+    }
+    recorder.finish(game);
+
+    std::stringstream buffer;
+    ASSERT_TRUE(recorder.getRecording().save(buffer));
+    starship::Recording loaded;
+    ASSERT_TRUE(loaded.load(buffer));
+    EXPECT_EQ(loaded.sectorSize, 1000.0f);
+    EXPECT_EQ(loaded.activeRadius, 2);
+    EXPECT_TRUE(loaded.polygonCollisions);
+
+    starship::Game replayed = loaded.createGame();
+    EXPECT_TRUE(replayed.hasPolygonCollisions());
+    EXPECT_TRUE(starship::replay(loaded, replayed));
+}
+
+TEST_F(ReplayTest, LoadRejectsGarbage) {
+    std::stringstream buffer("not a recording");
+    starship::Recording recording;
+    EXPECT_FALSE(recording.load(buffer));
+
+    // A valid header that asks for 2^62 ticks in a single run
+    std::stringstream empty;
+    ASSERT_TRUE(starship::Recording().save(empty));
+    std::string bytes = empty.str();
+    bytes.pop_back();  // Tick count of 0
+    const std::string huge("\x80\x80\x80\x80\x80\x80\x80\x80\x40", 9);
+    std::stringstream oversized(bytes + huge + '\0' + huge);
+    EXPECT_FALSE(recording.load(oversized));
+    EXPECT_TRUE(recording.inputs.empty());
+}
@@ -0,0 +1,92 @@
+// tests/rewind_buffer_test.cxx
+#include <gtest/gtest.h>
+#include <vector>
+#include "starship/game.hxx"
+#include "starship/rewind_buffer.hxx"
+
+namespace {
+
+starship::InputMask scriptedInput(std::uint64_t tick) {
+    starship::InputMask input = starship::INPUT_FIRE;
+    input |= (tick / 45) % 2 == 0 ? starship::INPUT_RIGHT : starship::INPUT_LEFT;
+    return input;
+}
+
+// Steps `ticks` times, recording each tick and its checksum
+std::vector<std::uint64_t> playRecorded(starship::Game& game, starship::RewindBuffer& buffer, int ticks) {
+    std::vector<std::uint64_t> checksums;
+    for (int i = 0; i < ticks; ++i) {
+        starship::InputMask input = scriptedInput(game.getTickCount() + 1);
+        game.step(input);
+        buffer.record(game, input);
+        checksums.push_back(game.checksum());
+    }
+    return checksums;
+}
+
+} // namespace
+
+class RewindBufferTest : public ::testing::Test {};
+
+TEST_F(RewindBufferTest, RewindsToEveryHeldTick) {
+    starship::Game game(800, 600, 17);
+    starship::RewindBuffer buffer(100, 10);
+    std::vector<std::uint64_t> checksums = playRecorded(game, buffer, 250);
+
+    // Only the last 100 ticks are held
+    EXPECT_EQ(buffer.size(), 100u);
+    EXPECT_EQ(buffer.getNewestTick(), 250u);
+    EXPECT_EQ(buffer.getOldestTick(), 151u);
+    EXPECT_FALSE(buffer.contains(150));
+
+    starship::Game target(800, 600, 0);
+    for (std::uint64_t tick = 151; tick <= 250; tick += 7) {
+        ASSERT_TRUE(buffer.rewindTo(target, tick));
+        EXPECT_EQ(target.getTickCount(), tick);
+        EXPECT_EQ(target.checksum(), checksums[tick - 1]);
+    }
+    EXPECT_FALSE(buffer.rewindTo(target, 10));
+}
+
+TEST_F(RewindBufferTest, ResimulatesAndBranches) {
+    starship::Game game(800, 600, 23);
+    starship::RewindBuffer buffer(300, 30);
+    std::vector<std::uint64_t> checksums = playRecorded(game, buffer, 200);
+
+    // Re-simulating with the recorded inputs lands on the same state
+    ASSERT_TRUE(buffer.rewindTo(game, 120));
+    ASSERT_TRUE(buffer.resimulate(game, 200));
+    EXPECT_EQ(game.checksum(), checksums.back());
+
+    // Recording after a rewind drops the old future
+    ASSERT_TRUE(buffer.rewindTo(game, 150));
+    game.step(starship::INPUT_NONE);
+    buffer.record(game, starship::INPUT_NONE);
+    EXPECT_EQ(buffer.getNewestTick(), 151u);
+    EXPECT_EQ(buffer.getInput(151), starship::INPUT_NONE);
+    EXPECT_FALSE(buffer.contains(152));
+
+    // A reset starts the buffer over
+    game.reset(23);
+    game.step(starship::INPUT_NONE);
+    buffer.record(game);
+    EXPECT_EQ(buffer.size(), 1u);
+    EXPECT_EQ(buffer.getOldestTick(), 1u);
+}
+
+TEST_F(RewindBufferTest, DeltasCostFarLessThanFullCopies) {
+    starship::Game game(800, 600, 31);
+    for (int i = 0; i < 200; ++i) {
+        game.spawnAsteroid(starship::Vector2D(4.0f * i, 100.0f), starship::Vector2D(0.0f, 0.0f),
+                           starship::Asteroid::Size::SMALL);
+    }
+    starship::RewindBuffer buffer;
+    playRecorded(game, buffer, 600);
+
+    starship::RewindBuffer::Stats stats = buffer.getStats();
+    EXPECT_EQ(stats.ticks, 600u);
+    EXPECT_EQ(stats.keyframes, 10u);
+    EXPECT_GT(stats.fullBytes, 0u);
+    EXPECT_LT(stats.memoryBytes, stats.fullBytes / 2);
+    EXPECT_GT(stats.averageRecordNanos, 0.0);
+}
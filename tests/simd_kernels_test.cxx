@@ -0,0 +1,138 @@
+// tests/simd_kernels_test.cxx
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "starship/simd_kernels.hxx"
+
+using starship::simd::Backend;
+
+class SimdKernelsTest : public ::testing::TestWithParam<Backend> {
+protected:
+    // Odd length so every backend also runs its scalar tail
+    static constexpr std::size_t kCount = 1037;
+
+    std::vector<float> randomColumn(float lo, float hi, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(lo, hi);
+        std::vector<float> column(kCount);
+        for (auto& v : column) v = dist(rng);
+        return column;
+    }
+
+    void SetUp() override {
+        if (!starship::simd::isSupported(GetParam())) {
+            GTEST_SKIP() << starship::simd::getBackendName(GetParam()) << " not supported here";
+        }
+    }
+
+    const starship::simd::Kernels& scalar() {
+        return starship::simd::kernelsFor(Backend::SCALAR);
+    }
+
+    const starship::simd::Kernels& tested() {
+        return starship::simd::kernelsFor(GetParam());
+    }
+};
+
+TEST_P(SimdKernelsTest, SelectsRequestedBackend) {
+    EXPECT_EQ(tested().backend, GetParam());
+}
+
+TEST_P(SimdKernelsTest, IntegrateMatchesScalar) {
+    auto x = randomColumn(-500.0f, 500.0f, 1);
+    auto y = randomColumn(-500.0f, 500.0f, 2);
+    auto vx = randomColumn(-300.0f, 300.0f, 3);
+    auto vy = randomColumn(-300.0f, 300.0f, 4);
+    auto xRef = x;
+    auto yRef = y;
+
+    scalar().integrate(xRef.data(), yRef.data(), vx.data(), vy.data(), kCount, 0.016f);
+    tested().integrate(x.data(), y.data(), vx.data(), vy.data(), kCount, 0.016f);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_FLOAT_EQ(x[i], xRef[i]);
+        EXPECT_FLOAT_EQ(y[i], yRef[i]);
+    }
+}
+
+TEST_P(SimdKernelsTest, RotationWrapMatchesScalar) {
+    // Start near both ends of the range so wrapping happens in both directions
+    auto rotation = randomColumn(0.0f, 360.0f, 5);
+    for (std::size_t i = 0; i < kCount; i += 3) rotation[i] = (i % 2) ? 359.5f : 0.25f;
+    auto speed = randomColumn(-60.0f, 60.0f, 6);
+    auto reference = rotation;
+
+    scalar().advanceRotation(reference.data(), speed.data(), kCount, 0.1f);
+    tested().advanceRotation(rotation.data(), speed.data(), kCount, 0.1f);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_FLOAT_EQ(rotation[i], reference[i]);
+        EXPECT_GE(rotation[i], 0.0f);
+        EXPECT_LT(rotation[i], 360.0f);
+    }
+}
+
+TEST_P(SimdKernelsTest, TimersMatchScalar) {
+    auto timers = randomColumn(0.0f, 10.0f, 7);
+    auto reference = timers;
+
+    scalar().advanceTimers(reference.data(), kCount, 0.25f);
+    tested().advanceTimers(timers.data(), kCount, 0.25f);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_FLOAT_EQ(timers[i], reference[i]);
+    }
+}
+
+TEST_P(SimdKernelsTest, FlagMasksMatchScalar) {
+    auto values = randomColumn(-100.0f, 100.0f, 8);
+    std::vector<std::uint8_t> flags(kCount);
+    for (std::size_t i = 0; i < kCount; ++i) flags[i] = static_cast<std::uint8_t>(i & 0x0F);
+    auto reference = flags;
+
+    scalar().clearFlagAbove(values.data(), reference.data(), kCount, 40.0f, 0x01);
+    scalar().clearFlagBelow(values.data(), reference.data(), kCount, -40.0f, 0x04);
+    tested().clearFlagAbove(values.data(), flags.data(), kCount, 40.0f, 0x01);
+    tested().clearFlagBelow(values.data(), flags.data(), kCount, -40.0f, 0x04);
+
+    EXPECT_EQ(flags, reference);
+}
+
+TEST_P(SimdKernelsTest, SinCosMatchesScalarAndLibm) {
+    // Quadrant boundaries, halfway points and negatives alongside random angles
+    auto degrees = randomColumn(0.0f, 360.0f, 9);
+    for (std::size_t i = 0; i < 32; ++i) degrees[i] = -180.0f + 22.5f * static_cast<float>(i);
+    std::vector<float> sines(kCount), cosines(kCount), sinRef(kCount), cosRef(kCount);
+
+    scalar().sinCosDegrees(degrees.data(), sinRef.data(), cosRef.data(), kCount);
+    tested().sinCosDegrees(degrees.data(), sines.data(), cosines.data(), kCount);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        EXPECT_EQ(sines[i], sinRef[i]) << degrees[i];
+        EXPECT_EQ(cosines[i], cosRef[i]) << degrees[i];
+        double radians = static_cast<double>(degrees[i]) * 3.14159265358979323846 / 180.0;
+        EXPECT_NEAR(sines[i], std::sin(radians), 2e-6) << degrees[i];
+        EXPECT_NEAR(cosines[i], std::cos(radians), 2e-6) << degrees[i];
+    }
+}
+
+TEST_P(SimdKernelsTest, TransformPointsMatchesScalar) {
+    // kCount is odd, so the point count exercises every tail
+    auto local = randomColumn(-25.0f, 25.0f, 10);
+    local.resize(2 * kCount, 3.0f);
+    std::vector<float> world(2 * kCount), reference(2 * kCount);
+
+    scalar().transformPoints(local.data(), reference.data(), kCount, 0.6f, 0.8f, 120.0f, -40.0f);
+    tested().transformPoints(local.data(), world.data(), kCount, 0.6f, 0.8f, 120.0f, -40.0f);
+
+    EXPECT_EQ(world, reference);
+    EXPECT_FLOAT_EQ(reference[0], local[0] * 0.6f - local[1] * 0.8f + 120.0f);
+    EXPECT_FLOAT_EQ(reference[1], local[0] * 0.8f + local[1] * 0.6f - 40.0f);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllBackends, SimdKernelsTest,
+                         ::testing::Values(Backend::SCALAR, Backend::SSE2, Backend::AVX2),
+                         [](const ::testing::TestParamInfo<Backend>& info) {
+                             return std::string(starship::simd::getBackendName(info.param));
+                         });
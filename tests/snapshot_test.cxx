@@ -0,0 +1,180 @@
+// tests/snapshot_test.cxx
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include "starship/game.hxx"
+#include "starship/snapshot.hxx"
+
+namespace {
+
+// Fires while sweeping side to side, with the odd burst of thrust
+starship::InputMask scriptedInput(std::size_t tick) {
+    starship::InputMask input = starship::INPUT_FIRE;
+    input |= (tick / 60) % 2 == 0 ? starship::INPUT_LEFT : starship::INPUT_RIGHT;
+    if (tick % 150 < 15) input |= starship::INPUT_THRUST;
+    return input;
+}
+
+void play(starship::Game& game, std::size_t from, std::size_t to) {
+    for (std::size_t t = from; t < to; ++t) {
+        game.step(scriptedInput(t));
+    }
+}
+
+} // namespace
+
+class SnapshotTest : public ::testing::Test {};
+
+TEST_F(SnapshotTest, RestoredGameContinuesIdentically) {
+    starship::Game original(800, 600, 99);
+    original.applyPowerUp(starship::PowerUp::Type::MULTI_SHOT);
+    play(original, 0, 300);
+
+    starship::Snapshot snapshot = starship::Snapshot::capture(original);
+    EXPECT_EQ(snapshot.getChecksum(), original.checksum());
+
+    // A game with a different seed and size becomes the captured one
+    starship::Game restored(100, 100, 1);
+    ASSERT_TRUE(snapshot.restore(restored));
+    EXPECT_EQ(restored.checksum(), original.checksum());
+    EXPECT_EQ(restored.getTickCount(), original.getTickCount());
+    EXPECT_EQ(restored.getSeed(), original.getSeed());
+    EXPECT_EQ(restored.getWidth(), original.getWidth());
+    EXPECT_EQ(restored.hasMultiShot(), original.hasMultiShot());
+
+    // The rng and spawn timers carry on from the same point
+    play(original, 300, 900);
+    play(restored, 300, 900);
+    EXPECT_EQ(restored.checksum(), original.checksum());
+    EXPECT_EQ(restored.getScore(), original.getScore());
+
+    // Restoring again rewinds
+    ASSERT_TRUE(snapshot.restore(restored));
+    EXPECT_EQ(restored.checksum(), snapshot.getChecksum());
+}
+
+TEST_F(SnapshotTest, HandlesSurviveRestore) {
+    starship::Game game(800, 600, 5);
+    starship::AsteroidHandle handle = game.spawnAsteroid(starship::Vector2D(400, 100),
+                                                         starship::Vector2D(0, 0),
+                                                         starship::Asteroid::Size::LARGE);
+    std::size_t slot = game.getAsteroids().find(handle);
+    starship::Snapshot snapshot = starship::Snapshot::capture(game);
+
+    starship::Game other(800, 600, 6);
+    ASSERT_TRUE(snapshot.restore(other));
+    EXPECT_EQ(other.getAsteroids().find(handle), slot);
+    EXPECT_EQ(other.getAsteroids().liveCount(), game.getAsteroids().liveCount());
+}
+
+TEST_F(SnapshotTest, FileRoundTripThroughMapping) {
+    starship::Game game(800, 600, 21);
+    play(game, 0, 240);
+    starship::Snapshot snapshot = starship::Snapshot::capture(game);
+
+    std::string path = ::testing::TempDir() + "starship_snapshot_test.bin";
+    ASSERT_TRUE(snapshot.saveToFile(path));
+
+    starship::MappedSnapshot mapped(path);
+    ASSERT_TRUE(mapped.isOpen());
+    EXPECT_EQ(mapped.size(), snapshot.size());
+    EXPECT_EQ(mapped.getChecksum(), game.checksum());
+
+    starship::Game fromMap(800, 600, 0);
+    ASSERT_TRUE(mapped.restore(fromMap));
+    EXPECT_EQ(fromMap.checksum(), game.checksum());
+
+    starship::Snapshot loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    starship::Game fromFile(800, 600, 0);
+    ASSERT_TRUE(loaded.restore(fromFile));
+    EXPECT_EQ(fromFile.checksum(), game.checksum());
+
+    mapped.close();
+    std::remove(path.c_str());
+}
+
+TEST_F(SnapshotTest, RejectsDamagedInputWithoutTouchingGame) {
+    starship::Game game(800, 600, 3);
+    play(game, 0, 120);
+    starship::Snapshot snapshot = starship::Snapshot::capture(game);
+    std::string bytes(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+
+    starship::Game target(800, 600, 4);
+    const std::uint64_t before = target.checksum();
+
+    // Truncated
+    std::istringstream truncated(bytes.substr(0, bytes.size() / 2));
+    starship::Snapshot damaged;
+    EXPECT_FALSE(damaged.load(truncated));
+    EXPECT_TRUE(damaged.empty());
+    EXPECT_FALSE(damaged.restore(target));
+
+    // Wrong magic
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    std::istringstream badMagicIn(badMagic);
+    EXPECT_FALSE(damaged.load(badMagicIn));
+
+    EXPECT_EQ(target.checksum(), before);
+    EXPECT_FALSE(starship::MappedSnapshot(::testing::TempDir() + "missing_snapshot.bin").isOpen());
+}
+
+TEST_F(SnapshotTest, RejectsIndicesOutOfRange) {
+    starship::Game game(800, 600, 3);
+    play(game, 0, 120);
+    starship::Snapshot snapshot = starship::Snapshot::capture(game);
+    const std::string bytes(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+
+    starship::Game target(800, 600, 4);
+    const std::uint64_t before = target.checksum();
+
+    // Overwrite the first entry of a section. The header is 24 bytes and
+    // each table entry an (offset, bytes) pair; the asteroid columns start
+    // at section 2, with ids at 8, sizes at 11 and the handle slots at 13.
+    auto damaged = [&](std::size_t section, std::uint32_t value) {
+        std::uint64_t offset;
+        std::memcpy(&offset, bytes.data() + 24 + section * 16, sizeof(offset));
+        std::string copy = bytes;
+        std::memcpy(&copy[offset], &value, sizeof(value));
+        std::istringstream in(copy);
+        starship::Snapshot out;
+        EXPECT_TRUE(out.load(in));
+        return out;
+    };
+    EXPECT_FALSE(damaged(8, 0x7FFFFFFFu).restore(target));
+    EXPECT_FALSE(damaged(13, 0x7FFFFFFFu).restore(target));
+    // A size past the end of the radius and outline tables
+    EXPECT_FALSE(damaged(11, 7).restore(target));
+    EXPECT_EQ(target.checksum(), before);
+
+    // An id still in range is not caught here, which shows the sections
+    // above were the right ones
+    EXPECT_TRUE(damaged(8, 0).restore(target));
+}
+
+TEST_F(SnapshotTest, DeltaRebuildsTargetAndKeepsOnlyChanges) {
+    starship::Game game(800, 600, 8);
+    play(game, 0, 60);
+    starship::Snapshot base = starship::Snapshot::capture(game);
+    play(game, 60, 90);
+    starship::Snapshot target = starship::Snapshot::capture(game);
+
+    starship::SnapshotDelta delta;
+    delta.encode(base, target);
+    EXPECT_EQ(delta.getTargetSize(), target.size());
+    EXPECT_LT(delta.size(), target.size());
+
+    starship::Snapshot rebuilt;
+    ASSERT_TRUE(delta.apply(base, rebuilt));
+    ASSERT_EQ(rebuilt.size(), target.size());
+    EXPECT_TRUE(std::equal(rebuilt.data(), rebuilt.data() + rebuilt.size(), target.data()));
+
+    // A snapshot against itself is only the header and block counts
+    delta.encode(target, target);
+    EXPECT_LT(delta.size(), 2048u);
+    EXPECT_FALSE(starship::SnapshotDelta().apply(base, rebuilt));
+}
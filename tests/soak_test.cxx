@@ -0,0 +1,96 @@
+// tests/soak_test.cxx
+#include <gtest/gtest.h>
+#include "starship/bot.hxx"
+#include "starship/soak.hxx"
+#include <stdexcept>
+
+using starship::SoakReport;
+using starship::SoakScenario;
+
+namespace {
+
+const SoakScenario& scenario(const char* name) {
+    const SoakScenario* s = starship::findSoakScenario(name);
+    if (!s) throw std::runtime_error(name);
+    return *s;
+}
+
+} // namespace
+
+TEST(SoakTest, ScenariosAreListedAndFound) {
+    ASSERT_EQ(starship::getSoakScenarios().size(), 4u);
+    for (const SoakScenario& s : starship::getSoakScenarios()) {
+        EXPECT_EQ(starship::findSoakScenario(s.name), &s);
+        EXPECT_GT(s.defaultTicks, 0u);
+    }
+    EXPECT_EQ(starship::findSoakScenario("noSuchScenario"), nullptr);
+}
+
+TEST(SoakTest, SameSeedGivesSameRun) {
+    for (const SoakScenario& s : starship::getSoakScenarios()) {
+        SoakReport a = starship::runSoak(s, 7, 300);
+        SoakReport b = starship::runSoak(s, 7, 300);
+        EXPECT_EQ(a.ticks, 300u);
+        EXPECT_EQ(a.checksum, b.checksum) << s.name;
+        EXPECT_EQ(a.score, b.score) << s.name;
+        EXPECT_EQ(a.peakAsteroids, b.peakAsteroids) << s.name;
+        EXPECT_NE(a.checksum, starship::runSoak(s, 8, 300).checksum) << s.name;
+    }
+}
+
+TEST(SoakTest, ScenariosApplyTheirLoad) {
+    SoakReport storm = starship::runSoak(scenario("asteroidStorm"), 1, 600);
+    EXPECT_EQ(storm.maxLevel, 30);
+    EXPECT_GT(storm.peakAsteroids, 200u);
+    EXPECT_EQ(storm.deaths, 0);
+
+    SoakReport cascade = starship::runSoak(scenario("splittingCascade"), 1, 600);
+    EXPECT_GT(cascade.peakAsteroids, 100u);
+    EXPECT_GT(cascade.score, 0);
+
+    SoakReport flood = starship::runSoak(scenario("powerUpFlood"), 1, 600);
+    EXPECT_GT(flood.peakPowerUps, 500u);
+
+    EXPECT_GT(storm.tickMax, 0u);
+    EXPECT_LE(storm.tickP50, storm.tickP99);
+    EXPECT_LE(storm.tickP99, storm.tickP999);
+}
+
+TEST(SoakTest, BotOutplaysAnIdlePlayer) {
+    // Whether an idle ship happens to be hit depends on the seed, so the
+    // idle run gets an asteroid dropped on it every ten seconds
+    SoakScenario idle;
+    idle.name = "idle";
+    idle.defaultTicks = 6000;
+    idle.drive = [](SoakScenario::Context& context) {
+        if (context.tick % 600 == 300) {
+            context.game.spawnAsteroid(context.game.getPlayer().getPosition(), starship::Vector2D(0.0f, 0.0f),
+                                       starship::Asteroid::Size::LARGE);
+        }
+        return starship::InputMask{starship::INPUT_RESTART};
+    };
+
+    for (std::uint32_t seed = 1; seed <= 3; ++seed) {
+        SoakReport bot = starship::runSoak(scenario("botSurvival"), seed, 6000);
+        SoakReport still = starship::runSoak(idle, seed);
+        EXPECT_GT(still.deaths, 0) << "seed " << seed;
+        EXPECT_EQ(bot.deaths, 0) << "seed " << seed;
+        EXPECT_GT(bot.score, 0) << "seed " << seed;
+    }
+}
+
+TEST(SoakTest, BotAsksForRestartOnlyWhenAllowed) {
+    // Drop asteroids on the ship until it runs out of health
+    starship::Game game(800, 600, 5);
+    for (int t = 0; t < 1000 && !game.isGameOver(); ++t) {
+        game.spawnAsteroid(game.getPlayer().getPosition(), starship::Vector2D(0.0f, 0.0f),
+                           starship::Asteroid::Size::LARGE);
+        game.step(starship::INPUT_NONE);
+    }
+    ASSERT_TRUE(game.isGameOver());
+
+    starship::BotPlayer bot;
+    EXPECT_EQ(bot.decide(game), starship::INPUT_RESTART);
+    bot.setRestart(false);
+    EXPECT_EQ(bot.decide(game), starship::INPUT_NONE);
+}
@@ -0,0 +1,66 @@
+// tests/spatial_grid_test.cxx
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "starship/spatial_grid.hxx"
+
+class SpatialGridTest : public ::testing::Test {
+protected:
+    starship::SpatialGrid grid{40.0f};
+};
+
+TEST_F(SpatialGridTest, EmptyGridReportsNothing) {
+    grid.clear();
+    grid.build();
+
+    int visits = 0;
+    grid.query(starship::Vector2D(0.0f, 0.0f), 100.0f, [&](std::uint32_t) { visits++; });
+    EXPECT_EQ(visits, 0);
+}
+
+TEST_F(SpatialGridTest, QueryMatchesBruteForce) {
+    std::mt19937 rng(777);
+    std::uniform_real_distribution<float> coord(-500.0f, 500.0f);
+
+    std::vector<starship::Vector2D> points;
+    grid.clear(2000);
+    for (std::uint32_t i = 0; i < 2000; ++i) {
+        points.emplace_back(coord(rng), coord(rng));
+        grid.insert(i, points.back(), 10.0f);
+    }
+    grid.build();
+    EXPECT_EQ(grid.size(), 2000u);
+
+    for (int q = 0; q < 50; ++q) {
+        starship::Vector2D center(coord(rng), coord(rng));
+        float range = 15.0f;
+
+        std::vector<std::uint32_t> found;
+        grid.query(center, range, [&](std::uint32_t id) { found.push_back(id); });
+        std::sort(found.begin(), found.end());
+        EXPECT_TRUE(std::adjacent_find(found.begin(), found.end()) == found.end());
+
+        // Every true overlap must be among the candidates
+        for (std::uint32_t i = 0; i < points.size(); ++i) {
+            float reach = range + 10.0f;
+            if (starship::Vector2D::distanceSquared(center, points[i]) < reach * reach) {
+                EXPECT_TRUE(std::binary_search(found.begin(), found.end(), i));
+            }
+        }
+    }
+}
+
+TEST_F(SpatialGridTest, RebuildDropsPreviousItems) {
+    grid.clear();
+    grid.insert(1, starship::Vector2D(10.0f, 10.0f), 5.0f);
+    grid.build();
+
+    grid.clear();
+    grid.insert(2, starship::Vector2D(500.0f, 500.0f), 5.0f);
+    grid.build();
+
+    std::vector<std::uint32_t> found;
+    grid.query(starship::Vector2D(10.0f, 10.0f), 5.0f, [&](std::uint32_t id) { found.push_back(id); });
+    EXPECT_TRUE(found.empty());
+}
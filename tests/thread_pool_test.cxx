@@ -0,0 +1,70 @@
+// tests/thread_pool_test.cxx
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <vector>
+#include "starship/game.hxx"
+#include "starship/thread_pool.hxx"
+
+class ThreadPoolTest : public ::testing::Test {};
+
+TEST_F(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    starship::ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+
+    std::vector<int> visits(10007, 0);
+    pool.parallelFor(visits.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) visits[i]++;
+    });
+    for (int v : visits) ASSERT_EQ(v, 1);
+}
+
+TEST_F(ThreadPoolTest, NestedLoopsComplete) {
+    starship::ThreadPool pool(3);
+    std::atomic<int> total(0);
+    pool.parallelFor(8, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            pool.parallelFor(100, 10, [&](std::size_t b, std::size_t e) {
+                total += static_cast<int>(e - b);
+            });
+        }
+    });
+    EXPECT_EQ(total.load(), 800);
+}
+
+TEST_F(ThreadPoolTest, SingleThreadRunsInline) {
+    starship::ThreadPool pool(1);
+    int calls = 0;
+    pool.parallelFor(1000, 10, [&](std::size_t begin, std::size_t end) {
+        EXPECT_EQ(begin, 0u);
+        EXPECT_EQ(end, 1000u);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+}
+
+// A world big enough that every parallel phase really splits
+static std::uint64_t runCrowdedWorld(unsigned threads) {
+    starship::Game game(4000, 4000, 77);
+    game.setThreadCount(threads);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> coord(0.0f, 4000.0f);
+    for (int i = 0; i < 40000; ++i) {
+        game.spawnAsteroid(starship::Vector2D(coord(rng), coord(rng)),
+                           starship::Vector2D(0.0f, 5.0f), starship::Asteroid::Size::LARGE);
+    }
+    for (int i = 0; i < 3000; ++i) {
+        game.spawnProjectile(starship::Vector2D(coord(rng), coord(rng)), starship::Vector2D(0.0f, -300.0f));
+    }
+    for (int t = 0; t < 20; ++t) {
+        game.step(starship::INPUT_FIRE);
+    }
+    return game.checksum();
+}
+
+TEST_F(ThreadPoolTest, GameResultsIndependentOfThreadCount) {
+    std::uint64_t serial = runCrowdedWorld(1);
+    EXPECT_EQ(runCrowdedWorld(2), serial);
+    EXPECT_EQ(runCrowdedWorld(4), serial);
+}
@@ -0,0 +1,79 @@
+// tests/tick_profiler_test.cxx
+#include <gtest/gtest.h>
+#include "starship/game.hxx"
+#include "starship/tick_profiler.hxx"
+
+using starship::LatencyHistogram;
+using starship::TickPhase;
+
+class TickProfilerTest : public ::testing::Test {};
+
+TEST_F(TickProfilerTest, PercentilesStayWithinBucketError) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.percentile(50), 0u);
+
+    // 1..1000 us, one sample each
+    for (std::uint64_t us = 1; us <= 1000; ++us) {
+        h.record(us * 1000);
+    }
+    EXPECT_EQ(h.getCount(), 1000u);
+    EXPECT_EQ(h.getMin(), 1000u);
+    EXPECT_EQ(h.getMax(), 1000000u);
+    EXPECT_NEAR(h.getMean(), 500500.0, 1.0);
+
+    // Reported values are bucket upper edges: never below the truth and
+    // at most one sub-bucket (12.5%) above it
+    const double ps[] = {50.0, 90.0, 99.0};
+    for (double p : ps) {
+        double truth = p * 10.0 * 1000.0;
+        double reported = static_cast<double>(h.percentile(p));
+        EXPECT_GE(reported, truth) << "p" << p;
+        EXPECT_LE(reported, truth * 1.125) << "p" << p;
+    }
+    EXPECT_EQ(h.percentile(100), 1000000u);
+
+    // Small values are exact, huge ones are clamped rather than lost
+    LatencyHistogram small;
+    small.record(3);
+    small.record(1ull << 50);
+    EXPECT_EQ(small.percentile(50), 3u);
+    EXPECT_EQ(small.percentile(100), 1ull << 50);
+
+    h.merge(small);
+    EXPECT_EQ(h.getCount(), 1002u);
+    EXPECT_EQ(h.getMin(), 3u);
+    h.reset();
+    EXPECT_EQ(h.getCount(), 0u);
+    EXPECT_EQ(h.getMax(), 0u);
+}
+
+TEST_F(TickProfilerTest, GameRecordsEveryPhase) {
+    starship::Game game(800, 600, 12);
+    for (int t = 0; t < 300; ++t) {
+        game.step(starship::INPUT_FIRE);
+    }
+    const starship::TickProfile& profile = game.getProfile();
+
+#if STARSHIP_PROFILING
+    EXPECT_TRUE(game.isProfiling());
+    EXPECT_EQ(profile[TickPhase::UPDATE].getCount(), 300u);
+    EXPECT_EQ(profile[TickPhase::INTEGRATE].getCount(), 300u);
+    EXPECT_EQ(profile[TickPhase::COLLISIONS].getCount(), 300u);
+    EXPECT_EQ(profile[TickPhase::RELEASE].getCount(), 300u);
+    // Spawning runs every two seconds (five seconds played)
+    EXPECT_EQ(profile[TickPhase::SPAWN].getCount(), 2u);
+    EXPECT_GE(profile[TickPhase::UPDATE].getMax(), profile[TickPhase::COLLISIONS].getMax());
+
+    // Switched off, nothing more is recorded
+    game.setProfiling(false);
+    game.step(starship::INPUT_NONE);
+    EXPECT_EQ(profile[TickPhase::UPDATE].getCount(), 300u);
+
+    game.resetProfile();
+    EXPECT_EQ(profile[TickPhase::UPDATE].getCount(), 0u);
+#else
+    EXPECT_FALSE(game.isProfiling());
+    EXPECT_EQ(profile[TickPhase::UPDATE].getCount(), 0u);
+#endif
+    EXPECT_STREQ(starship::getPhaseName(TickPhase::COLLISIONS), "collisions");
+}
@@ -0,0 +1,148 @@
+// tests/timer_wheel_test.cxx
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "starship/game.hxx"
+#include "starship/snapshot.hxx"
+#include "starship/timer_wheel.hxx"
+
+using starship::TimerWheel;
+
+namespace {
+
+// Advance `wheel` to `now` in steps of `stride`, checking that every
+// timer comes out on exactly the tick it asked for
+std::size_t runTo(TimerWheel& wheel, std::uint64_t now, std::uint64_t stride) {
+    std::vector<TimerWheel::Timer> fired;
+    std::size_t count = 0;
+    while (wheel.getCurrentTick() < now) {
+        std::uint64_t target = std::min(now, wheel.getCurrentTick() + stride);
+        for (std::uint64_t t = wheel.getCurrentTick() + 1; t <= target; ++t) {
+            fired.clear();
+            wheel.advance(t, fired);
+            for (const auto& timer : fired) EXPECT_EQ(timer.deadline, t) << "timer " << timer.id;
+            count += fired.size();
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(TimerWheelTest, FiresEachTimerOnItsDeadline) {
+    std::mt19937 rng(17);
+    // Near a level boundary, so cascades happen early on
+    const std::uint64_t start = (1u << 18) - 7;
+    TimerWheel wheel(start);
+    std::uniform_int_distribution<std::uint64_t> offset(1, 300000);
+    for (std::uint32_t i = 0; i < 2000; ++i) wheel.schedule(start + offset(rng), 0, i);
+    EXPECT_EQ(wheel.size(), 2000u);
+
+    EXPECT_EQ(runTo(wheel, start + 300000, 1), 2000u);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, LargeStepsFireEverythingDue) {
+    TimerWheel wheel(0);
+    for (std::uint32_t i = 1; i <= 500; ++i) wheel.schedule(i * 37, 1, i);
+
+    std::vector<TimerWheel::Timer> fired;
+    wheel.advance(37 * 100, fired);
+    EXPECT_EQ(fired.size(), 100u);
+    for (const auto& timer : fired) EXPECT_LE(timer.deadline, 37u * 100);
+
+    fired.clear();
+    wheel.advance(37 * 500, fired);
+    EXPECT_EQ(fired.size(), 400u);
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, PastDeadlinesFireOnTheNextTick) {
+    TimerWheel wheel(100);
+    wheel.schedule(50, 2, 7, 3);
+    wheel.schedule(100, 2, 8);
+
+    std::vector<TimerWheel::Timer> fired;
+    wheel.advance(100, fired);
+    EXPECT_TRUE(fired.empty());
+    wheel.advance(101, fired);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_EQ(fired[0].kind, 2u);
+    EXPECT_TRUE((fired[0].id == 7 && fired[0].generation == 3) || fired[1].id == 7);
+}
+
+TEST(TimerWheelTest, DeadlinesPastTheTopLevelWaitInOverflow) {
+    // A deadline a few ticks away can still differ from now above the
+    // wheel's 24 bits when the clock is about to roll over
+    const std::uint64_t start = (std::uint64_t(1) << 24) - 5;
+    TimerWheel wheel(start);
+    wheel.schedule(start + 8, 0, 1);
+    wheel.schedule(start + (std::uint64_t(1) << 25), 0, 2);
+    EXPECT_EQ(runTo(wheel, start + 8, 1), 1u);
+    EXPECT_EQ(wheel.size(), 1u);
+
+    std::vector<TimerWheel::Timer> fired;
+    wheel.advance(start + (std::uint64_t(1) << 25), fired);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].id, 2u);
+}
+
+TEST(TimerWheelTest, ResetDropsPendingTimers) {
+    TimerWheel wheel(0);
+    for (std::uint32_t i = 0; i < 10; ++i) wheel.schedule(5 + i, 0, i);
+    wheel.reset(1000);
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_EQ(wheel.getCurrentTick(), 1000u);
+
+    std::vector<TimerWheel::Timer> fired;
+    wheel.schedule(1010, 0, 99);
+    wheel.advance(2000, fired);
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].id, 99u);
+}
+
+TEST(TimerWheelTest, GameRetiresProjectilesAndEffectsOnTime) {
+    starship::Game game(800, 600, 4);
+    const float dt = game.getFixedTimestep();
+    const std::uint64_t lifetime = static_cast<std::uint64_t>(starship::Projectile::MAX_LIFETIME / dt + 0.5f);
+    const std::uint64_t effect = static_cast<std::uint64_t>(starship::DefaultGameConfig::EFFECT_DURATION / dt + 0.5f);
+
+    // Far off to the side, so nothing hits it and it never leaves the screen
+    starship::ProjectileHandle shot = game.spawnProjectile(starship::Vector2D(5.0f, 300.0f),
+                                                           starship::Vector2D(0.0f, -1.0f));
+    game.applyPowerUp(starship::PowerUp::Type::SHIELD);
+    for (std::uint64_t t = 1; t < lifetime; ++t) game.step(starship::INPUT_NONE);
+    EXPECT_TRUE(game.getProjectiles().contains(shot));
+    game.step(starship::INPUT_NONE);
+    EXPECT_FALSE(game.getProjectiles().contains(shot));
+
+    // Picking the shield up again mid-way pushes its end back
+    for (std::uint64_t t = lifetime; t < effect / 2; ++t) game.step(starship::INPUT_NONE);
+    game.applyPowerUp(starship::PowerUp::Type::SHIELD);
+    for (std::uint64_t t = 0; t < effect - 1; ++t) game.step(starship::INPUT_NONE);
+    EXPECT_TRUE(game.isShielded());
+    game.step(starship::INPUT_NONE);
+    EXPECT_FALSE(game.isShielded());
+}
+
+TEST(TimerWheelTest, RestoredGameKeepsItsTimers) {
+    starship::Game game(800, 600, 12);
+    game.applyPowerUp(starship::PowerUp::Type::RAPID_FIRE);
+    game.spawnPowerUp(starship::Vector2D(100.0f, 100.0f));
+    for (int t = 0; t < 60; ++t) game.step(starship::INPUT_FIRE);
+    starship::Snapshot snapshot = starship::Snapshot::capture(game);
+
+    starship::Game restored(800, 600, 1);
+    ASSERT_TRUE(snapshot.restore(restored));
+    EXPECT_EQ(restored.checksum(), game.checksum());
+    EXPECT_EQ(restored.hasRapidFire(), game.hasRapidFire());
+
+    // Stale timers are not carried over, but everything live is
+    EXPECT_LE(restored.getPendingTimerCount(), game.getPendingTimerCount());
+    for (int t = 0; t < 900; ++t) {
+        game.step(starship::INPUT_FIRE);
+        restored.step(starship::INPUT_FIRE);
+    }
+    EXPECT_EQ(restored.checksum(), game.checksum());
+}
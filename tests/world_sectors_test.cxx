@@ -0,0 +1,134 @@
+// tests/world_sectors_test.cxx
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include "starship/game.hxx"
+#include "starship/snapshot.hxx"
+#include "starship/world_sectors.hxx"
+
+using starship::Vector2D;
+
+namespace {
+
+constexpr float WORLD = 20000.0f;
+constexpr float SECTOR = 1000.0f;
+
+// Asteroids strewn over the top half of the world, drifting down
+void scatter(starship::Game& game, int count) {
+    for (int i = 0; i < count; ++i) {
+        float x = std::fmod(i * 7919.0f, WORLD);
+        float y = std::fmod(i * 104729.0f, WORLD / 2);
+        game.spawnAsteroid(Vector2D(x, y), Vector2D(static_cast<float>(i % 7) - 3.0f, 40.0f + i % 60),
+                           starship::Asteroid::Size::LARGE);
+    }
+}
+
+} // namespace
+
+TEST(WorldSectorsTest, CutsTheWorldIntoSquares) {
+    starship::WorldSectors sectors;
+    EXPECT_FALSE(sectors.isEnabled());
+    sectors.configure(2500.0f, 1000.0f, 1000.0f, 1);
+    ASSERT_TRUE(sectors.isEnabled());
+    EXPECT_EQ(sectors.getColumns(), 3);
+    EXPECT_EQ(sectors.getRows(), 1);
+    EXPECT_EQ(sectors.sectorAt(1500.0f, 500.0f), 1u);
+    // Off the world counts as the nearest edge
+    EXPECT_EQ(sectors.sectorAt(-50.0f, -20.0f), 0u);
+    EXPECT_EQ(sectors.sectorAt(9000.0f, 5000.0f), 2u);
+    EXPECT_TRUE(sectors.isWithin(0, 1, 1));
+    EXPECT_FALSE(sectors.isWithin(0, 2, 1));
+}
+
+TEST(WorldSectorsTest, FarAsteroidsCostNothingPerTick) {
+    starship::Game game(WORLD, WORLD, 5);
+    game.setSectors(SECTOR, 1);
+    const std::size_t initial = game.getAsteroidCount();
+    scatter(game, 5000);
+    // One within reach of the player, who sits at the bottom centre
+    game.spawnAsteroid(Vector2D(WORLD / 2 - 500.0f, WORLD - 1000.0f), Vector2D(0.0f, 0.0f),
+                       starship::Asteroid::Size::SMALL);
+
+    for (int t = 0; t < 60; ++t) game.step(0);
+    EXPECT_EQ(game.getAsteroids().size(), 1u);
+    EXPECT_GE(game.getAsteroidCount(), initial + 5001);
+    // Dormant asteroids still count toward clearing the level
+    EXPECT_EQ(game.getLevel(), 1);
+}
+
+TEST(WorldSectorsTest, DormantAsteroidWakesOnItsPath) {
+    starship::Game game(WORLD, WORLD, 5);
+    game.setSectors(SECTOR, 1);
+    game.spawnAsteroid(Vector2D(WORLD / 2, WORLD - 5000.0f), Vector2D(3.0f, 100.0f),
+                       starship::Asteroid::Size::MEDIUM);
+    EXPECT_EQ(game.getAsteroids().size(), 0u);
+    EXPECT_EQ(game.getSectors().size(), game.getAsteroidCount());
+
+    // Reaches the active rows, 3000 further down, after 30s
+    std::size_t ticks = 0;
+    while (game.getAsteroids().size() == 0 && ticks < 4000) {
+        game.step(0);
+        ++ticks;
+    }
+    ASSERT_EQ(game.getAsteroids().size(), 1u);
+    const float seconds = static_cast<float>(ticks) * game.getFixedTimestep();
+    EXPECT_NEAR(seconds, 30.0f, 0.1f);
+
+    Vector2D position = game.getAsteroids()[0].getPosition();
+    EXPECT_NEAR(position.x, WORLD / 2 + 3.0f * seconds, 0.5f);
+    EXPECT_NEAR(position.y, WORLD - 5000.0f + 100.0f * seconds, 0.5f);
+}
+
+TEST(WorldSectorsTest, ActiveRegionFollowsThePlayer) {
+    starship::Game game(WORLD, WORLD, 5);
+    game.setSectors(SECTOR, 1);
+    game.spawnAsteroid(Vector2D(2500.0f, WORLD - 800.0f), Vector2D(0.0f, 0.0f), starship::Asteroid::Size::SMALL);
+    const std::size_t total = game.getAsteroidCount();
+    game.step(0);
+    EXPECT_EQ(game.getAsteroids().size(), 0u);
+
+    game.getPlayer().setPosition(Vector2D(3000.0f, WORLD - 30.0f));
+    game.step(0);
+    ASSERT_EQ(game.getAsteroids().size(), 1u);
+    EXPECT_EQ(game.getAsteroids()[0].getPosition().x, 2500.0f);
+
+    // Parked again once the player is well clear
+    game.getPlayer().setPosition(Vector2D(WORLD / 2, WORLD - 30.0f));
+    game.step(0);
+    EXPECT_EQ(game.getAsteroids().size(), 0u);
+    EXPECT_EQ(game.getAsteroidCount(), total);
+}
+
+TEST(WorldSectorsTest, RestoredGameContinuesIdentically) {
+    starship::Game original(WORLD, WORLD, 9);
+    original.setSectors(SECTOR, 1);
+    scatter(original, 2000);
+    for (int t = 0; t < 600; ++t) original.step(t % 90 < 45 ? starship::INPUT_LEFT : starship::INPUT_RIGHT);
+
+    starship::Snapshot snapshot = starship::Snapshot::capture(original);
+    starship::Game restored(100, 100, 1);
+    ASSERT_TRUE(snapshot.restore(restored));
+    EXPECT_EQ(restored.checksum(), original.checksum());
+    EXPECT_EQ(restored.getSectors().size(), original.getSectors().size());
+
+    for (int t = 0; t < 1200; ++t) {
+        original.step(starship::INPUT_FIRE);
+        restored.step(starship::INPUT_FIRE);
+    }
+    EXPECT_EQ(restored.checksum(), original.checksum());
+    EXPECT_EQ(restored.getAsteroidCount(), original.getAsteroidCount());
+}
+
+TEST(WorldSectorsTest, TurningSectorsOffWakesEverything) {
+    starship::Game game(WORLD, WORLD, 5);
+    game.setSectors(SECTOR, 1);
+    scatter(game, 300);
+    for (int t = 0; t < 120; ++t) game.step(0);
+    const std::size_t total = game.getAsteroidCount();
+    ASSERT_GT(game.getSectors().size(), 0u);
+
+    game.setSectors(0.0f);
+    EXPECT_FALSE(game.getSectors().isEnabled());
+    EXPECT_EQ(game.getSectors().size(), 0u);
+    EXPECT_EQ(game.getAsteroids().size(), total);
+}